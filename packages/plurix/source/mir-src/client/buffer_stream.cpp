@@ -31,6 +31,7 @@
 #include "protobuf_to_native_buffer.h"
 #include "buffer.h"
 #include "connection_surface_map.h"
+#include "buffer_submission_ring.h"
 
 #include "mir/log.h"
 #include "mir/client/client_platform.h"
@@ -40,6 +41,7 @@
 #include <boost/throw_exception.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 
+#include <cstring>
 #include <stdexcept>
 
 namespace mcl = mir::client;
@@ -53,16 +55,18 @@ namespace gp = google::protobuf;
 
 namespace
 {
-class Requests : public mcl::ServerBufferRequests
+class Requests : public mcl::ServerBufferRequests, public std::enable_shared_from_this<Requests>
 {
 public:
     Requests(
         mclr::DisplayServer& server,
         int stream_id,
-        std::shared_ptr<mcl::ClientPlatform> const& platform) :
+        std::shared_ptr<mcl::ClientPlatform> const& platform,
+        std::weak_ptr<mcl::SurfaceMap> const& map) :
         server(server),
         stream_id(stream_id),
-        platform(platform)
+        platform(platform),
+        map(map)
     {
     }
 #pragma GCC diagnostic push
@@ -103,13 +107,38 @@ public:
 
     void submit_buffer(mcl::MirBuffer& buffer) override
     {
+        if (auto const ring = submission_ring())
+        {
+            if (ring->submit(buffer.rpc_id()))
+                return;
+        }
+
         mp::BufferRequest request;
         request.mutable_id()->set_value(stream_id);
         request.mutable_buffer()->set_buffer_id(buffer.rpc_id());
 
+        {
+            std::lock_guard<decltype(ring_mutex)> lock{ring_mutex};
+            ++socket_submissions_in_flight;
+        }
+
         auto protobuf_void = std::make_shared<mp::Void>();
         server.submit_buffer(&request, protobuf_void.get(),
-            google::protobuf::NewCallback(Requests::ignore_response, protobuf_void));
+            google::protobuf::NewCallback(
+                Requests::socket_submission_done, std::weak_ptr<Requests>{shared_from_this()}, protobuf_void));
+    }
+
+    /// Ask the server for a shared-memory ring to submit buffers through.
+    /// Until (and unless) it arrives, buffers are submitted over the socket.
+    void request_submission_ring()
+    {
+        mp::BufferStreamId request;
+        request.set_value(stream_id);
+
+        auto response = std::make_shared<mp::SocketFD>();
+        server.create_submission_ring(&request, response.get(),
+            google::protobuf::NewCallback(
+                Requests::submission_ring_created, std::weak_ptr<Requests>{shared_from_this()}, response));
     }
 
     static void ignore_response(std::shared_ptr<mp::Void>)
@@ -117,11 +146,72 @@ public:
     }
 
 private:
+    /// The ring, unless submissions made over the socket are still on their way: the server handles the
+    /// two on different threads, so using the ring then could overtake them
+    std::shared_ptr<mcl::BufferSubmissionRing> submission_ring() const
+    {
+        std::lock_guard<decltype(ring_mutex)> lock{ring_mutex};
+        return socket_submissions_in_flight == 0 ? ring : nullptr;
+    }
+
+    static void socket_submission_done(std::weak_ptr<Requests> weak_self, std::shared_ptr<mp::Void>)
+    {
+        if (auto const self = weak_self.lock())
+        {
+            std::lock_guard<decltype(ring_mutex)> lock{self->ring_mutex};
+            --self->socket_submissions_in_flight;
+        }
+    }
+
+    static void submission_ring_created(std::weak_ptr<Requests> weak_self, std::shared_ptr<mp::SocketFD> response)
+    {
+        std::vector<mir::Fd> fds;
+        for (auto i = 0; i != response->fd_size(); ++i)
+            fds.emplace_back(response->fd(i));
+
+        auto const self = weak_self.lock();
+        if (!self || response->has_error() || fds.size() != 3)
+            return;
+
+        try
+        {
+            auto const weak_map = self->map;
+            auto new_ring = std::make_shared<mcl::BufferSubmissionRing>(fds[0], fds[1], fds[2],
+                [weak_map](int buffer_id)
+                {
+                    if (auto const map = weak_map.lock())
+                    {
+                        // Releases only come through the ring when there's nothing to update the buffer with
+                        if (auto const buffer = map->buffer(buffer_id))
+                            buffer->received();
+                    }
+                });
+
+            std::lock_guard<decltype(ring_mutex)> lock{self->ring_mutex};
+            self->ring = new_ring;
+        }
+        catch (std::exception const& error)
+        {
+            mir::log_warning("Not using buffer submission ring: %s", error.what());
+        }
+    }
+
     mclr::DisplayServer& server;
     int stream_id;
     std::shared_ptr<mcl::ClientPlatform> const platform;
+    std::weak_ptr<mcl::SurfaceMap> const map;
+
+    std::mutex mutable ring_mutex;
+    std::shared_ptr<mcl::BufferSubmissionRing> ring;
+    int socket_submissions_in_flight{0};
 };
 
+bool use_submission_ring()
+{
+    auto const env = getenv("MIR_CLIENT_BUFFER_RING");
+    return env && strcmp(env, "0") != 0;
+}
+
 mir::optional_value<int> parse_env_for_swap_interval()
 {
     if (auto env = getenv("MIR_CLIENT_FORCE_SWAP_INTERVAL"))
@@ -196,8 +286,15 @@ struct BufferDepository
 
         vault.deposit(c);
         auto wh = vault.wire_transfer_outbound(c, done);
-        auto f = vault.withdraw();
+
+        // Usually a buffer is already available: don't pay for a future in that case
+        NoTLSFuture<std::shared_ptr<mcl::MirBuffer>> f;
+        auto next = vault.try_withdraw();
+        if (!next)
+            f = vault.withdraw();
+
         lk.lock();
+        current = next;
         future = std::move(f);
         return wh;
     }
@@ -310,9 +407,11 @@ mcl::BufferStream::BufferStream(
 
     try
     {
+        auto const requests = std::make_shared<Requests>(server, protobuf_bs->id().value(), client_platform, map);
+
         buffer_depository = std::make_unique<BufferDepository>(
             client_platform->create_buffer_factory(), factory,
-            std::make_shared<Requests>(server, protobuf_bs->id().value(), client_platform),
+            requests,
             map,
             ideal_buffer_size, static_cast<MirPixelFormat>(protobuf_bs->pixel_format()), 
             protobuf_bs->buffer_usage(), nbuffers);
@@ -325,6 +424,9 @@ mcl::BufferStream::BufferStream(
         // bother the creation parameters with this stuff...
         if (user_swap_interval.is_set())
             set_swap_interval(user_swap_interval.value());
+
+        if (use_submission_ring())
+            requests->request_submission_ring();
     }
     catch (std::exception const& error)
     {
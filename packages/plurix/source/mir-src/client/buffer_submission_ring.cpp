@@ -0,0 +1,104 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer_submission_ring.h"
+
+#include "mir/dispatch/readable_fd.h"
+#include "mir/dispatch/threaded_dispatcher.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/mman.h>
+
+namespace mcl = mir::client;
+namespace md = mir::dispatch;
+namespace ring = mir::buffer_submission_ring;
+
+namespace
+{
+ring::Layout& map_layout(int shm)
+{
+    auto const mapping = mmap(nullptr, sizeof(ring::Layout), PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0);
+    if (mapping == MAP_FAILED)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to map buffer submission ring"}));
+    }
+
+    auto& layout = *static_cast<ring::Layout*>(mapping);
+    if (layout.version != ring::version)
+    {
+        munmap(mapping, sizeof(ring::Layout));
+        BOOST_THROW_EXCEPTION(std::runtime_error("Unsupported buffer submission ring version"));
+    }
+
+    return layout;
+}
+}
+
+mcl::BufferSubmissionRing::BufferSubmissionRing(
+    Fd const& shm,
+    Fd const& submission_doorbell,
+    Fd const& release_doorbell,
+    std::function<void(int)> const& on_release) :
+    on_release{on_release},
+    submission_doorbell{submission_doorbell},
+    release_doorbell{release_doorbell},
+    layout{map_layout(shm)}
+{
+    try
+    {
+        release_thread = std::make_unique<md::ThreadedDispatcher>(
+            "Mir/BufferRing",
+            std::make_shared<md::ReadableFd>(release_doorbell, [this] { process_releases(); }));
+    }
+    catch (...)
+    {
+        munmap(&layout, sizeof(ring::Layout));
+        throw;
+    }
+}
+
+mcl::BufferSubmissionRing::~BufferSubmissionRing()
+{
+    // Joins the release thread before the layout goes away
+    release_thread.reset();
+    munmap(&layout, sizeof(ring::Layout));
+}
+
+bool mcl::BufferSubmissionRing::submit(int buffer_id)
+{
+    std::lock_guard<decltype(submit_mutex)> lock{submit_mutex};
+
+    if (!ring::push(layout.submissions, buffer_id))
+        return false;
+
+    if (ring::needs_doorbell(layout.submissions))
+        ring::ring(submission_doorbell);
+
+    return true;
+}
+
+void mcl::BufferSubmissionRing::process_releases()
+{
+    ring::acknowledge(release_doorbell);
+    ring::drain(layout.releases, on_release);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_CLIENT_BUFFER_SUBMISSION_RING_H_
+#define MIR_CLIENT_BUFFER_SUBMISSION_RING_H_
+
+#include "mir/buffer_submission_ring.h"
+#include "mir/fd.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+namespace dispatch
+{
+class ThreadedDispatcher;
+}
+namespace client
+{
+/// The client end of a mir::buffer_submission_ring for one buffer stream.
+class BufferSubmissionRing
+{
+public:
+    /// \param on_release   called, on the ring's own thread, for each buffer the server releases
+    BufferSubmissionRing(
+        Fd const& shm,
+        Fd const& submission_doorbell,
+        Fd const& release_doorbell,
+        std::function<void(int)> const& on_release);
+    ~BufferSubmissionRing();
+
+    /// \returns false if the ring is full and the buffer should be submitted over the socket
+    bool submit(int buffer_id);
+
+private:
+    void process_releases();
+
+    std::function<void(int)> const on_release;
+    Fd const submission_doorbell;
+    Fd const release_doorbell;
+    buffer_submission_ring::Layout& layout;
+
+    std::mutex submit_mutex;    ///< There must only be one producer of submissions
+    std::unique_ptr<dispatch::ThreadedDispatcher> release_thread;
+};
+}
+}
+
+#endif /* MIR_CLIENT_BUFFER_SUBMISSION_RING_H_ */
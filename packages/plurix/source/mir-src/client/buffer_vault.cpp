@@ -81,62 +81,44 @@ mcl::BufferVault::~BufferVault()
 {
     buffer_factory->cancel_requests_with_context(this);
 
-    std::vector<std::shared_ptr<MirBuffer>> current_buffers;
+    BufferMap current_buffers;
 
-    std::unique_lock<std::mutex> lk(mutex);
-
-    // Prevent callbacks from allocating new buffers
-    being_destroyed = true;
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+
+        // Prevent callbacks from allocating new buffers
+        being_destroyed = true;
+
+        /*
+         * mir::AtomicCallback is atomic via locking: after set_callback() returns no thread
+         * is in, or will enter, the previous callback. wire_transfer_inbound() is called from
+         * that callback, and acquires BufferVault::mutex, so we must not hold it while calling
+         * set_callback(). Taking the buffers lets us release it.
+         */
+        current_buffers.swap(buffers);
+    }
 
-    for (auto& it : buffers)
+    /*
+     * Erase them from the SurfaceMap.
+     *
+     * After this point, the RPC layer will ignore any messages about
+     * these buffers.
+     *
+     * We don't need to explicitly ask the server to free them; they'll be
+     * freed with the BufferStream
+     */
     if (auto map = surface_map.lock())
     {
-        if (auto buffer = map->buffer(it.first))
-        {
-            /*
-             * Annoying wart:
-             *
-             * mir::AtomicCallback is atomic via locking, and we need it to be because
-             * we rely on the guarantee that after set_callback() returns no thread
-             * is in, or will enter, the previous callback.
-             *
-             * However!
-             *
-             * wire_transfer_inbound() is called from buffer->callback, and acquires
-             * BufferVault::mutex.
-             *
-             * This destuctor must call buffer->set_callback(), and has acquired
-             * BufferVault::mutex.
-             *
-             * So we've got a lock inversion.
-             *
-             * We can't unlock here, as wire_transfer_inbound() might mutate
-             * BufferVault::buffers, which we're iterating over.
-             *
-             * So store them up to process later...
-             */
-            current_buffers.push_back(buffer);
-
-            /*
-             * ...and erase them from the SurfaceMap.
-             *
-             * After this point, the RPC layer will ignore any messages about
-             * this buffer.
-             *
-             * We don't need to explicitly ask the server to free it; it'll be
-             * freed with the BufferStream
-             */
-            map->erase(it.first);
-        }
+        for (auto const& entry : current_buffers)
+            map->erase(entry.first);
     }
-    lk.unlock();
 
     /*
      * Now, ensure that no threads are in the existing buffer callbacks...
      */
-    for (auto const& buffer : current_buffers)
+    for (auto const& entry : current_buffers)
     {
-        buffer->set_callback(ignore_buffer, nullptr);
+        entry.second.buffer->set_callback(ignore_buffer, nullptr);
     }
 }
 
@@ -180,30 +162,27 @@ std::shared_ptr<mcl::MirBuffer> mcl::BufferVault::checked_buffer_from_map(int id
 mcl::BufferVault::BufferMap::iterator mcl::BufferVault::available_buffer()
 {
     auto it = std::find_if(buffers.begin(), buffers.end(),
-        [this](std::pair<int, Owner> const& entry) {
-            return ((entry.second == Owner::Self) &&
-                    (checked_buffer_from_map(entry.first)->size() == size) &&
+        [this](BufferMap::value_type const& entry) {
+            return ((entry.second.owner == Owner::Self) &&
+                    (entry.second.size == size) &&
                     (entry.first != last_received_id)); });
     if (it == buffers.end())
         it = std::find_if(buffers.begin(), buffers.end(),
-        [this](std::pair<int, Owner> const& entry) {
-            return ((entry.second == Owner::Self) &&
-                    (checked_buffer_from_map(entry.first)->size() == size)); });
+        [this](BufferMap::value_type const& entry) {
+            return ((entry.second.owner == Owner::Self) &&
+                    (entry.second.size == size)); });
     return it;
 }
 
-mcl::NoTLSFuture<std::shared_ptr<mcl::MirBuffer>> mcl::BufferVault::withdraw()
+std::shared_ptr<mcl::MirBuffer> mcl::BufferVault::withdraw_available(std::vector<int>& free_ids)
 {
-    std::vector<int> free_ids;
-    std::unique_lock<std::mutex> lk(mutex);
     if (disconnected_)
         BOOST_THROW_EXCEPTION(std::logic_error("server_disconnected"));
 
     //clean up incorrectly sized buffers
     for (auto it = buffers.begin(); it != buffers.end();)
     {
-        auto buffer = checked_buffer_from_map(it->first);
-        if ((it->second == Owner::Self) && (buffer->size() != size)) 
+        if ((it->second.owner == Owner::Self) && (it->second.size != size))
         {
             current_buffer_count--;
             free_ids.push_back(it->first);
@@ -213,15 +192,38 @@ mcl::NoTLSFuture<std::shared_ptr<mcl::MirBuffer>> mcl::BufferVault::withdraw()
         {
             it++;
         }
-    } 
+    }
 
-    mcl::NoTLSPromise<std::shared_ptr<mcl::MirBuffer>> promise;
     auto it = available_buffer();
+    if (it == buffers.end())
+        return nullptr;
+
+    it->second.owner = Owner::ContentProducer;
+    return it->second.buffer;
+}
+
+std::shared_ptr<mcl::MirBuffer> mcl::BufferVault::try_withdraw()
+{
+    std::vector<int> free_ids;
+    std::unique_lock<std::mutex> lk(mutex);
+    auto buffer = withdraw_available(free_ids);
+    lk.unlock();
+
+    for(auto& id : free_ids)
+        free_buffer(id);
+    return buffer;
+}
+
+mcl::NoTLSFuture<std::shared_ptr<mcl::MirBuffer>> mcl::BufferVault::withdraw()
+{
+    std::vector<int> free_ids;
+    std::unique_lock<std::mutex> lk(mutex);
+
+    mcl::NoTLSPromise<std::shared_ptr<mcl::MirBuffer>> promise;
     auto future = promise.get_future();
-    if (it != buffers.end())
+    if (auto buffer = withdraw_available(free_ids))
     {
-        it->second = Owner::ContentProducer;
-        promise.set_value(checked_buffer_from_map(it->first));
+        promise.set_value(buffer);
         lk.unlock();
     }
     else
@@ -247,11 +249,11 @@ void mcl::BufferVault::deposit(std::shared_ptr<mcl::MirBuffer> const& buffer)
 {
     std::lock_guard<std::mutex> lk(mutex);
     auto it = buffers.find(buffer->rpc_id());
-    if (it == buffers.end() || it->second != Owner::ContentProducer)
+    if (it == buffers.end() || it->second.owner != Owner::ContentProducer)
         BOOST_THROW_EXCEPTION(std::logic_error("buffer cannot be deposited"));
 
-    it->second = Owner::SelfWithContent;
-    checked_buffer_from_map(it->first)->increment_age();
+    it->second.owner = Owner::SelfWithContent;
+    it->second.buffer->increment_age();
 }
 
 MirWaitHandle* mcl::BufferVault::wire_transfer_outbound(
@@ -259,9 +261,9 @@ MirWaitHandle* mcl::BufferVault::wire_transfer_outbound(
 {
     std::unique_lock<std::mutex> lk(mutex);
     auto it = buffers.find(buffer->rpc_id());
-    if (it == buffers.end() || it->second != Owner::SelfWithContent)
+    if (it == buffers.end() || it->second.owner != Owner::SelfWithContent)
         BOOST_THROW_EXCEPTION(std::logic_error("buffer cannot be transferred"));
-    it->second = Owner::Server;
+    it->second.owner = Owner::Server;
     lk.unlock();
 
     buffer->submitted();
@@ -294,23 +296,23 @@ void mcl::BufferVault::wire_transfer_inbound(int buffer_id)
         return;
 
     last_received_id = buffer_id;
-    auto buffer = checked_buffer_from_map(buffer_id);
-    auto inbound_size = buffer->size();
     auto it = buffers.find(buffer_id);
     if (it == buffers.end())
     {
+        auto buffer = checked_buffer_from_map(buffer_id);
+        auto inbound_size = buffer->size();
         if (inbound_size != size)
         {
             lk.unlock();
             realloc_buffer(buffer_id, size, format, usage);
             return;
         }
-        buffers[buffer_id] = Owner::Self;
+        it = buffers.emplace(buffer_id, Entry{Owner::Self, buffer, inbound_size}).first;
     }
     else
     {
         auto should_decrease_count = (current_buffer_count > needed_buffer_count);
-        if (size != buffer->size() || should_decrease_count)
+        if (size != it->second.size || should_decrease_count)
         {
             auto id = it->first;
             buffers.erase(it);
@@ -325,14 +327,14 @@ void mcl::BufferVault::wire_transfer_inbound(int buffer_id)
         }
         else
         {
-            it->second = Owner::Self;
+            it->second.owner = Owner::Self;
         }
     }
 
     if (!promises.empty())
     {
-        buffers[buffer_id] = Owner::ContentProducer;
-        promises.front().set_value(buffer);
+        it->second.owner = Owner::ContentProducer;
+        promises.front().set_value(it->second.buffer);
         promises.pop_front();
     }
 
@@ -396,7 +398,7 @@ void mcl::BufferVault::set_interval(int i)
         while (current_buffer_count > needed_buffer_count)
         {
             auto it = std::find_if(buffers.begin(), buffers.end(),
-                [](auto const& entry) { return entry.second == Owner::Self; });
+                [](auto const& entry) { return entry.second.owner == Owner::Self; });
             if (it == buffers.end())
                 break;
             current_buffer_count--;
@@ -27,6 +27,7 @@
 #include "no_tls_future-inl.h"
 #include <deque>
 #include <map>
+#include <vector>
 
 namespace mir
 {
@@ -66,6 +67,9 @@ public:
     ~BufferVault();
 
     NoTLSFuture<std::shared_ptr<MirBuffer>> withdraw();
+    /// The buffer to draw into next, or nullptr if there is none yet (and withdraw() is needed).
+    /// Unlike withdraw() this never allocates.
+    std::shared_ptr<MirBuffer> try_withdraw();
     void deposit(std::shared_ptr<MirBuffer> const& buffer);
     void wire_transfer_inbound(int buffer_id);
     MirWaitHandle* wire_transfer_outbound(
@@ -77,8 +81,16 @@ public:
 
 private:
     enum class Owner;
-    typedef std::map<int, Owner> BufferMap;
+    struct Entry
+    {
+        Owner owner;
+        /// Cached from the SurfaceMap, which needs a lock (and a weak_ptr promotion) to consult
+        std::shared_ptr<MirBuffer> buffer;
+        geometry::Size size;
+    };
+    typedef std::map<int, Entry> BufferMap;
     BufferMap::iterator available_buffer();
+    std::shared_ptr<MirBuffer> withdraw_available(std::vector<int>& free_ids);
     void trigger_callback(std::unique_lock<std::mutex> lk);
 
     void alloc_buffer(geometry::Size size, MirPixelFormat format, int usage);
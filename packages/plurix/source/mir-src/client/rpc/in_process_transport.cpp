@@ -0,0 +1,168 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "in_process_transport.h"
+#include "mir/in_process_channel.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+namespace mclr = mir::client::rpc;
+namespace md = mir::dispatch;
+
+namespace
+{
+auto create_wakeup() -> mir::Fd
+{
+    mir::Fd wakeup{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+    if (wakeup < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to create eventfd for in-process transport"}));
+    }
+    return wakeup;
+}
+}
+
+mclr::InProcessTransport::InProcessTransport(mir::Fd const& socket_fd, std::shared_ptr<InProcessChannel> const& channel)
+    : socket_fd{socket_fd},
+      channel{channel},
+      wakeup{create_wakeup()}
+{
+    channel->to_client.set_notifier([wakeup = wakeup] { eventfd_write(wakeup, 1); });
+
+    // The server may already be waiting to read from the socket; shutting it down makes it
+    // switch to the channel instead
+    shutdown(socket_fd, SHUT_RDWR);
+
+    if (channel->to_client.available() > 0 || channel->to_client.closed())
+        eventfd_write(wakeup, 1);
+}
+
+mclr::InProcessTransport::~InProcessTransport()
+{
+    channel->to_client.set_notifier({});
+    channel->to_server.close();
+}
+
+void mclr::InProcessTransport::register_observer(std::shared_ptr<Observer> const& observer)
+{
+    observers.add(observer);
+}
+
+void mclr::InProcessTransport::unregister_observer(std::shared_ptr<Observer> const& observer)
+{
+    observers.remove(observer);
+}
+
+void mclr::InProcessTransport::receive_data(void* buffer, size_t bytes_requested)
+{
+    if (bytes_requested == 0)
+    {
+        BOOST_THROW_EXCEPTION(std::logic_error("Attempted to receive 0 bytes"));
+    }
+
+    // The server writes each message whole, so anything short means it has gone
+    if (!channel->to_client.read(buffer, bytes_requested))
+    {
+        observers.on_disconnected();
+        BOOST_THROW_EXCEPTION(std::runtime_error("Failed to read message from server: server has shutdown"));
+    }
+}
+
+void mclr::InProcessTransport::receive_data(void* buffer, size_t bytes_requested, std::vector<mir::Fd>& fds)
+{
+    receive_data(buffer, bytes_requested);
+
+    if (!channel->to_client.read_fds(fds))
+    {
+        BOOST_THROW_EXCEPTION(std::runtime_error("Failed to read expected fds from server"));
+    }
+}
+
+void mclr::InProcessTransport::send_message(
+    std::vector<uint8_t> const& buffer,
+    std::vector<mir::Fd> const& fds)
+{
+    if (channel->to_server.closed())
+    {
+        observers.on_disconnected();
+        BOOST_THROW_EXCEPTION(std::runtime_error("Failed to send message to server: server has shutdown"));
+    }
+
+    if (fds.empty())
+    {
+        channel->to_server.write(buffer.data(), buffer.size(), fds);
+    }
+    else
+    {
+        // As over the socket, the fds follow the message with a byte of their own. It all has to
+        // be written at once as the server reads the fds as soon as it has the message.
+        std::vector<uint8_t> message;
+        message.reserve(buffer.size() + 1);
+        message.insert(message.end(), buffer.begin(), buffer.end());
+        message.push_back('M');
+        channel->to_server.write(message.data(), message.size(), fds);
+    }
+}
+
+mir::Fd mclr::InProcessTransport::watch_fd() const
+{
+    return wakeup;
+}
+
+bool mclr::InProcessTransport::dispatch(md::FdEvents events)
+{
+    if (events & md::FdEvent::error)
+    {
+        observers.on_disconnected();
+        return false;
+    }
+
+    eventfd_t unused;
+    eventfd_read(wakeup, &unused);
+
+    // Anything written after the wakeup was consumed will ring it again
+    for (auto available = channel->to_client.available(); available > 0;)
+    {
+        observers.on_data_available();
+
+        auto const remaining = channel->to_client.available();
+        if (remaining >= available)
+            break;
+        available = remaining;
+    }
+
+    if (channel->to_client.closed() && channel->to_client.available() == 0)
+    {
+        observers.on_disconnected();
+        return false;
+    }
+
+    return true;
+}
+
+md::FdEvents mclr::InProcessTransport::relevant_events() const
+{
+    return md::FdEvent::readable;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_CLIENT_RPC_IN_PROCESS_TRANSPORT_H_
+#define MIR_CLIENT_RPC_IN_PROCESS_TRANSPORT_H_
+
+#include "stream_transport.h"
+#include "stream_socket_transport.h"
+
+namespace mir
+{
+class InProcessChannel;
+
+namespace client
+{
+namespace rpc
+{
+/**
+ * \brief Talks to a server in the same process without going through the socket
+ * Requests are queued in memory for the server's IPC thread. Replies and events are queued in
+ * memory too, and an eventfd wakes the dispatcher to read them. Messages are still
+ * protobuf-encoded; only the socket is bypassed.
+ */
+class InProcessTransport : public StreamTransport
+{
+public:
+    /// \param [in] socket_fd   The client end of the connection's socket, shut down once claimed
+    /// \param [in] channel     The channel claimed for socket_fd
+    InProcessTransport(Fd const& socket_fd, std::shared_ptr<InProcessChannel> const& channel);
+    ~InProcessTransport();
+
+    void register_observer(std::shared_ptr<Observer> const& observer) override;
+    void unregister_observer(std::shared_ptr<Observer> const& observer) override;
+
+    void receive_data(void* buffer, size_t bytes_requested) override;
+    void receive_data(void* buffer, size_t bytes_requested, std::vector<Fd>& fds) override;
+    void send_message(std::vector<uint8_t> const& buffer, std::vector<mir::Fd> const& fds) override;
+
+    Fd watch_fd() const override;
+    bool dispatch(mir::dispatch::FdEvents event) override;
+    mir::dispatch::FdEvents relevant_events() const override;
+
+private:
+    Fd const socket_fd;
+    std::shared_ptr<InProcessChannel> const channel;
+    Fd const wakeup;
+
+    TransportObservers observers;
+};
+
+}
+}
+}
+
+#endif // MIR_CLIENT_RPC_IN_PROCESS_TRANSPORT_H_
@@ -19,6 +19,8 @@
 #include "make_rpc_channel.h"
 #include "mir_protobuf_rpc_channel.h"
 #include "stream_socket_transport.h"
+#include "in_process_transport.h"
+#include "mir/in_process_channel.h"
 
 #include <cstring>
 
@@ -58,7 +60,12 @@ mclr::make_rpc_channel(
     if (fd_prefix.is_start_of(name))
     {
         auto const fd = atoi(name.c_str()+fd_prefix.size);
-        transport = std::make_unique<mclr::StreamSocketTransport>(mir::Fd{fd});
+
+        // An internal client is handed a socket by a server in this process: use its channel instead
+        if (auto const channel = mir::InProcessChannel::claim(fd))
+            transport = std::make_unique<mclr::InProcessTransport>(mir::Fd{fd}, channel);
+        else
+            transport = std::make_unique<mclr::StreamSocketTransport>(mir::Fd{fd});
     }
     else
     {
@@ -154,6 +154,13 @@ void mclr::DisplayServer::create_buffer_stream(
 {
     channel->call_method(std::string(__func__), request, response, done);
 }
+void mclr::DisplayServer::create_submission_ring(
+    mir::protobuf::BufferStreamId const* request,
+    mir::protobuf::SocketFD* response,
+    google::protobuf::Closure* done)
+{
+    channel->call_method(std::string(__func__), request, response, done);
+}
 void mclr::DisplayServer::release_buffer_stream(
     mir::protobuf::BufferStreamId const* request,
     mir::protobuf::Void* response,
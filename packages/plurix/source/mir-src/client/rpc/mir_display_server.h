@@ -163,6 +163,12 @@ public:
         mir::protobuf::InputConfigurationRequest const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) override;
+
+    /// Not (yet) part of mir::protobuf::DisplayServer: see mir/buffer_submission_ring.h
+    void create_submission_ring(
+        mir::protobuf::BufferStreamId const* request,
+        mir::protobuf::SocketFD* response,
+        google::protobuf::Closure* done);
 private:
     std::shared_ptr<mir::client::rpc::MirBasicRpcChannel> const channel;
 };
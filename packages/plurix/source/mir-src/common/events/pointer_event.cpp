@@ -104,6 +104,26 @@ void MirPointerEvent::set_dy(float dy)
     event.getInput().getPointer().setDy(dy);
 }
 
+float MirPointerEvent::unaccelerated_dx() const
+{
+    auto const reader = event.asReader().getInput().getPointer();
+    return reader.getHasUnaccelerated() ? reader.getUnacceleratedDx() : reader.getDx();
+}
+
+float MirPointerEvent::unaccelerated_dy() const
+{
+    auto const reader = event.asReader().getInput().getPointer();
+    return reader.getHasUnaccelerated() ? reader.getUnacceleratedDy() : reader.getDy();
+}
+
+void MirPointerEvent::set_unaccelerated_motion(float dx, float dy)
+{
+    auto ptr = event.getInput().getPointer();
+    ptr.setUnacceleratedDx(dx);
+    ptr.setUnacceleratedDy(dy);
+    ptr.setHasUnaccelerated(true);
+}
+
 float MirPointerEvent::vscroll() const
 {
     return event.asReader().getInput().getPointer().getVscroll();
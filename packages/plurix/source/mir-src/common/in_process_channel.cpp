@@ -0,0 +1,224 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/in_process_channel.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+struct Offer
+{
+    int server_fd;
+    dev_t client_dev;
+    ino_t client_ino;
+    std::weak_ptr<mir::InProcessChannel> channel;
+};
+
+std::mutex offers_mutex;
+std::vector<Offer> offers;
+
+auto file_stat(int fd) -> struct stat
+{
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to identify client socket"}));
+    }
+    return info;
+}
+}
+
+void mir::InProcessChannel::Stream::write(void const* data, size_t size, std::vector<Fd> const& fds)
+{
+    std::function<void()> notify_reader;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        if (is_closed)
+            return;
+
+        // Reclaim what has been read before growing the buffer
+        if (read_offset > 0 && read_offset == bytes.size())
+        {
+            bytes.clear();
+            read_offset = 0;
+        }
+
+        auto const begin = static_cast<uint8_t const*>(data);
+        bytes.insert(bytes.end(), begin, begin + size);
+
+        for (auto const& fd : fds)
+        {
+            Fd duplicate{::dup(fd)};
+            if (duplicate < 0)
+            {
+                BOOST_THROW_EXCEPTION((std::system_error{
+                    errno,
+                    std::system_category(),
+                    "Failed to duplicate fd for in-process client"}));
+            }
+            this->fds.push_back(std::move(duplicate));
+        }
+
+        notify_reader = notify;
+    }
+
+    if (notify_reader)
+        notify_reader();
+}
+
+auto mir::InProcessChannel::Stream::available() const -> size_t
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    return bytes.size() - read_offset;
+}
+
+auto mir::InProcessChannel::Stream::read(void* buffer, size_t size) -> bool
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    if (bytes.size() - read_offset < size)
+        return false;
+
+    memcpy(buffer, bytes.data() + read_offset, size);
+    read_offset += size;
+
+    if (read_offset == bytes.size())
+    {
+        bytes.clear();
+        read_offset = 0;
+    }
+    return true;
+}
+
+auto mir::InProcessChannel::Stream::read_fds(std::vector<Fd>& fds) -> bool
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    if (this->fds.size() < fds.size())
+        return false;
+
+    for (auto& fd : fds)
+    {
+        fd = std::move(this->fds.front());
+        this->fds.pop_front();
+    }
+    return true;
+}
+
+void mir::InProcessChannel::Stream::set_notifier(std::function<void()> const& notify)
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    this->notify = notify;
+}
+
+void mir::InProcessChannel::Stream::close()
+{
+    std::function<void()> notify_reader;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        if (is_closed)
+            return;
+
+        is_closed = true;
+        notify_reader = notify;
+    }
+
+    if (notify_reader)
+        notify_reader();
+}
+
+auto mir::InProcessChannel::Stream::closed() const -> bool
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    return is_closed;
+}
+
+void mir::InProcessChannel::offer(int server_fd, int client_fd, std::shared_ptr<InProcessChannel> const& channel)
+{
+    auto const client = file_stat(client_fd);
+
+    std::lock_guard<decltype(offers_mutex)> lock{offers_mutex};
+
+    // Connections the server refused, or whose client never connected, leave expired offers
+    offers.erase(
+        std::remove_if(offers.begin(), offers.end(), [](Offer const& offer) { return offer.channel.expired(); }),
+        offers.end());
+
+    offers.push_back({server_fd, client.st_dev, client.st_ino, channel});
+}
+
+auto mir::InProcessChannel::offered_to(int server_fd) -> std::shared_ptr<InProcessChannel>
+{
+    std::lock_guard<decltype(offers_mutex)> lock{offers_mutex};
+
+    for (auto const& offer : offers)
+    {
+        if (offer.server_fd == server_fd)
+            return offer.channel.lock();
+    }
+
+    return {};
+}
+
+void mir::InProcessChannel::withdraw(InProcessChannel const* channel)
+{
+    std::lock_guard<decltype(offers_mutex)> lock{offers_mutex};
+
+    offers.erase(
+        std::remove_if(
+            offers.begin(),
+            offers.end(),
+            [channel](Offer const& offer)
+            {
+                auto const offered = offer.channel.lock();
+                return !offered || offered.get() == channel;
+            }),
+        offers.end());
+}
+
+auto mir::InProcessChannel::claim(int client_fd) -> std::shared_ptr<InProcessChannel>
+{
+    struct stat client;
+    if (fstat(client_fd, &client) < 0 || !S_ISSOCK(client.st_mode))
+        return {};
+
+    std::lock_guard<decltype(offers_mutex)> lock{offers_mutex};
+
+    for (auto i = offers.begin(); i != offers.end(); ++i)
+    {
+        if (i->client_dev == client.st_dev && i->client_ino == client.st_ino)
+        {
+            auto const channel = i->channel.lock();
+            offers.erase(i);
+
+            if (channel)
+                channel->is_claimed = true;
+
+            return channel;
+        }
+    }
+
+    return {};
+}
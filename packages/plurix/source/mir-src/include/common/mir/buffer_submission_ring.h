@@ -0,0 +1,132 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_BUFFER_SUBMISSION_RING_H_
+#define MIR_BUFFER_SUBMISSION_RING_H_
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace mir
+{
+/**
+ * The shared memory layout used to pass buffer ids between a mirclient client and the server
+ * without a round trip through the socket.
+ *
+ * A ring is created per buffer stream (by the "create_submission_ring" request). The server
+ * replies with three fds: the shared memory, the submission doorbell and the release doorbell
+ * (both eventfds). Submitted buffer ids go client -> server; released buffer ids server -> client.
+ * Each direction is a single producer, single consumer queue.
+ *
+ * Doorbells are coalesced: the consumer marks itself idle before it drains the queue, and the
+ * producer only writes the eventfd if it was the one to clear that mark. A busy consumer is
+ * therefore never woken more than once for a batch of entries.
+ */
+namespace buffer_submission_ring
+{
+uint32_t const version{1};
+uint32_t const capacity{64};
+
+struct Queue
+{
+    std::atomic<uint32_t> head;             ///< Next slot the producer writes
+    std::atomic<uint32_t> tail;             ///< Next slot the consumer reads
+    std::atomic<uint32_t> consumer_idle;    ///< Non-zero if the consumer needs a doorbell
+    int32_t slots[capacity];
+};
+
+struct Layout
+{
+    uint32_t version;
+    Queue submissions;
+    Queue releases;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "shared atomics must match the layout");
+
+/// Called once by the side creating the shared memory
+inline void initialise(Layout& layout)
+{
+    for (auto queue : {&layout.submissions, &layout.releases})
+    {
+        queue->head = 0;
+        queue->tail = 0;
+        queue->consumer_idle = 1;
+    }
+    layout.version = version;
+}
+
+/// Producer side. \returns false if the queue is full (the caller should use the socket instead)
+inline bool push(Queue& queue, int32_t value)
+{
+    auto const head = queue.head.load(std::memory_order_relaxed);
+    if (head - queue.tail.load(std::memory_order_acquire) >= capacity)
+        return false;
+
+    queue.slots[head % capacity] = value;
+    queue.head.store(head + 1);
+    return true;
+}
+
+/// Producer side, after pushing. \returns true if the consumer needs waking
+inline bool needs_doorbell(Queue& queue)
+{
+    return queue.consumer_idle.exchange(0) != 0;
+}
+
+/// Consumer side: process everything queued, leaving the queue ready for the next doorbell
+template<typename Consume>
+void drain(Queue& queue, Consume const& consume)
+{
+    // Anything pushed after we read head will see consumer_idle set, and ring the doorbell
+    queue.consumer_idle.store(1);
+
+    auto tail = queue.tail.load(std::memory_order_relaxed);
+    auto const head = queue.head.load();
+
+    // The queue is writable by the other process: don't trust it to keep head in range
+    if (head - tail > capacity)
+        tail = head - capacity;
+
+    for (; tail != head; ++tail)
+    {
+        auto const value = queue.slots[tail % capacity];
+        queue.tail.store(tail + 1, std::memory_order_release);
+        consume(value);
+    }
+}
+
+inline void ring(int doorbell)
+{
+    uint64_t const one{1};
+    while (write(doorbell, &one, sizeof one) < 0 && errno == EINTR)
+        ;
+}
+
+inline void acknowledge(int doorbell)
+{
+    uint64_t count;
+    while (read(doorbell, &count, sizeof count) < 0 && errno == EINTR)
+        ;
+}
+}
+}
+
+#endif /* MIR_BUFFER_SUBMISSION_RING_H_ */
@@ -0,0 +1,74 @@
+/*
+ * Copyright © 2016 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: Brandon Schaefer <brandon.schaefer@canonical.com>
+ */
+
+#ifndef MIR_COMMON_POINTER_EVENT_H_
+#define MIR_COMMON_POINTER_EVENT_H_
+
+#include "mir/events/input_event.h"
+
+struct MirPointerEvent : MirInputEvent
+{
+    MirPointerEvent();
+    MirPointerEvent(MirInputDeviceId dev,
+                    std::chrono::nanoseconds et,
+                    MirInputEventModifiers mods,
+                    std::vector<uint8_t> const& cookie,
+                    MirPointerAction action,
+                    MirPointerButtons buttons,
+                    float x,
+                    float y,
+                    float dx,
+                    float dy,
+                    float vscroll,
+                    float hscroll);
+
+    float x() const;
+    void set_x(float x);
+
+    float y() const;
+    void set_y(float y);
+
+    float dx() const;
+    void set_dx(float x);
+
+    float dy() const;
+    void set_dy(float y);
+
+    /// The motion as reported by the device, before pointer acceleration was applied.
+    /// Events from sources that don't report it fall back to dx()/dy()
+    float unaccelerated_dx() const;
+    float unaccelerated_dy() const;
+    void set_unaccelerated_motion(float dx, float dy);
+
+    float vscroll() const;
+    void set_vscroll(float v);
+
+    float hscroll() const;
+    void set_hscroll(float h);
+
+    MirPointerAction action() const;
+    void set_action(MirPointerAction action);
+
+    MirPointerButtons buttons() const;
+    void set_buttons(MirPointerButtons buttons);
+
+    void set_dnd_handle(std::vector<uint8_t> const& handle);
+    MirBlob* dnd_handle() const;
+};
+
+#endif /* MIR_COMMON_POINTER_EVENT_H_ */
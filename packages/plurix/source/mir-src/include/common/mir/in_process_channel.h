@@ -0,0 +1,101 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_IN_PROCESS_CHANNEL_H_
+#define MIR_IN_PROCESS_CHANNEL_H_
+
+#include "mir/fd.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mir
+{
+/**
+ * Carries a mirclient connection between the server and a client in the same process.
+ *
+ * The server hands out one end of a socket pair for each connection it opens for a client
+ * (see mir::Server::open_client_socket()). It also offers a channel for that end: if the client
+ * connecting with the fd ("fd://") is in the same process it claims the channel, and from then
+ * on messages are handed across in memory. There's no syscall per request and requests are
+ * processed as the client writes them. The socket then only identifies the connection.
+ */
+class InProcessChannel
+{
+public:
+    /// A stream of bytes, with fds, written by one end of the channel and read by the other
+    class Stream
+    {
+    public:
+        /// Appends a message to the stream, then calls the notifier.
+        /// The fds are duplicated, as passing them over a socket would.
+        /// Writes to a closed stream are discarded.
+        void write(void const* data, size_t size, std::vector<Fd> const& fds);
+
+        auto available() const -> size_t;
+
+        /// Reads exactly \p size bytes. \returns false if they are not available
+        auto read(void* buffer, size_t size) -> bool;
+
+        /// Reads exactly fds.size() fds. \returns false if they are not available
+        auto read_fds(std::vector<Fd>& fds) -> bool;
+
+        /// \p notify is called after every write and on close, on the writer's thread and without
+        /// any lock held. It may be empty.
+        void set_notifier(std::function<void()> const& notify);
+
+        void close();
+        auto closed() const -> bool;
+
+    private:
+        std::mutex mutable mutex;
+        std::vector<uint8_t> bytes;
+        size_t read_offset{0};
+        std::deque<Fd> fds;
+        std::function<void()> notify;
+        bool is_closed{false};
+    };
+
+    Stream to_server;
+    Stream to_client;
+
+    /// Whether a client in this process has claimed the channel
+    auto claimed() const -> bool { return is_claimed; }
+
+    /// Offers \p channel to a client connecting with \p client_fd. The server end of the
+    /// connection, \p server_fd, can find it with offered_to()
+    static void offer(int server_fd, int client_fd, std::shared_ptr<InProcessChannel> const& channel);
+
+    /// \returns The channel offered for the server end of a connection, or null
+    static auto offered_to(int server_fd) -> std::shared_ptr<InProcessChannel>;
+
+    /// Withdraws any offer of \p channel, once the connection has ended
+    static void withdraw(InProcessChannel const* channel);
+
+    /// \returns The channel offered for \p client_fd, or null if its server is not in this process
+    static auto claim(int client_fd) -> std::shared_ptr<InProcessChannel>;
+
+private:
+    std::atomic<bool> is_claimed{false};
+};
+}
+
+#endif /* MIR_IN_PROCESS_CHANNEL_H_ */
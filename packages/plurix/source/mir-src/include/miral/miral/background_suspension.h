@@ -0,0 +1,59 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_BACKGROUND_SUSPENSION_H
+#define MIRAL_BACKGROUND_SUSPENSION_H
+
+#include <miral/application.h>
+
+#include <mir_toolkit/common.h>
+
+#include <chrono>
+#include <memory>
+
+namespace miral
+{
+class ApplicationInfo;
+class WindowInfo;
+class WindowManagerTools;
+
+/// Suspends applications that have had no visible windows (all hidden, minimized or
+/// occluded) for a while, and resumes them as soon as they are shown or focused.
+/// \remark Opt-in: a window management policy owns one of these and forwards its advise_*() calls.
+/// \remark Must not be destroyed while holding the window manager lock.
+/// \remark Since MirAL 2.10
+class BackgroundSuspension
+{
+public:
+    /// \param suspend_after     how long an application must be in the background before it is suspended
+    /// \param freeze_processes  whether to also stop (SIGSTOP) suspended processes
+    BackgroundSuspension(
+        WindowManagerTools const& tools,
+        std::chrono::milliseconds suspend_after,
+        bool freeze_processes);
+    ~BackgroundSuspension();
+
+    void advise_delete_app(ApplicationInfo const& app_info);
+    void advise_focus_gained(WindowInfo const& window_info);
+    void advise_state_change(WindowInfo const& window_info, MirWindowState state);
+
+private:
+    struct Self;
+    std::unique_ptr<Self> const self;
+};
+}
+
+#endif //MIRAL_BACKGROUND_SUSPENSION_H
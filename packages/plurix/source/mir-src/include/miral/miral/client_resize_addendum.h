@@ -0,0 +1,53 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_CLIENT_RESIZE_ADDENDUM_H
+#define MIRAL_CLIENT_RESIZE_ADDENDUM_H
+
+#include <mir/geometry/size.h>
+
+namespace miral
+{
+using namespace mir::geometry;
+class WindowInfo;
+class WindowManagementPolicy;
+
+/// Handles clients resizing their own windows.
+/// While a client is being resized interactively, or animating, it changes the size of its window
+/// on every frame. Such a modification (one that changes nothing but the size) doesn't go through
+/// WindowManagementPolicy::handle_modify_window(), but is offered to confirm_client_resize()
+/// and the confirmed size applied directly.
+/// \remark Since MirAL 2.10
+class ClientResizeAddendum
+{
+public:
+    /// Confirm (or adjust) the size a client has given its window.
+    /// The default accepts \p new_size unchanged.
+    /// \remark Called for every frame the client resizes on, with the window manager locked:
+    /// this should be cheap.
+    virtual auto confirm_client_resize(WindowInfo const& window_info, Size const& new_size) -> Size;
+
+    /// The addendum implemented by \p policy, or one with the default behaviour if it doesn't implement it
+    static auto from(WindowManagementPolicy* policy) -> ClientResizeAddendum*;
+
+    virtual ~ClientResizeAddendum() = default;
+    ClientResizeAddendum() = default;
+    ClientResizeAddendum(ClientResizeAddendum const&) = delete;
+    ClientResizeAddendum& operator=(ClientResizeAddendum const&) = delete;
+};
+}
+
+#endif //MIRAL_CLIENT_RESIZE_ADDENDUM_H
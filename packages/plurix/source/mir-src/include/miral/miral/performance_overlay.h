@@ -0,0 +1,54 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_PERFORMANCE_OVERLAY_H
+#define MIRAL_PERFORMANCE_OVERLAY_H
+
+#include <memory>
+
+namespace mir { class Server; }
+
+namespace miral
+{
+/// Draws a graph of recent compositor frames in the corner of each output, above everything else.
+/// Each frame is a bar as tall as the time spent compositing it: green if composited, blue if
+/// bypassed (handed to the display without compositing) and red if it followed a missed vblank.
+/// Beneath the bars a grey strip shows how many renderables each frame drew.
+/// \remark Off unless the "performance-overlay" option is given. A window management policy can
+/// hold a copy and enable(), disable() or toggle() it at any time; when off it costs a flag check per frame.
+/// \remark Since MirAL 2.10
+class PerformanceOverlay
+{
+public:
+    PerformanceOverlay();
+    ~PerformanceOverlay();
+    PerformanceOverlay(PerformanceOverlay const&);
+    auto operator=(PerformanceOverlay const&) -> PerformanceOverlay&;
+
+    void enable();
+    void disable();
+    void toggle();
+
+    void operator()(mir::Server& server) const;
+
+    struct Self;
+
+private:
+    std::shared_ptr<Self> self;
+};
+}
+
+#endif //MIRAL_PERFORMANCE_OVERLAY_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_
+#define MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_
+
+#include "mir/graphics/buffer_basic.h"
+#include "mir/geometry/size.h"
+
+#include <array>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * A buffer every pixel of which is the same colour.
+ *
+ * It has no storage: renderers should draw it as a plain fill rather than
+ * uploading and sampling a texture. It reports an alpha-less pixel format when
+ * the colour is opaque, so it counts as occluding what is beneath it.
+ */
+class SolidColourBuffer : public BufferBasic, public NativeBufferBase
+{
+public:
+    /// \param [in] rgba  Non-premultiplied colour, each component in [0, 1]
+    SolidColourBuffer(geometry::Size const& size, std::array<float, 4> const& rgba);
+
+    /// The colour with alpha premultiplied, as renderers blend it
+    auto premultiplied_colour() const -> std::array<float, 4>;
+
+    std::shared_ptr<NativeBuffer> native_buffer_handle() const override;
+    geometry::Size size() const override;
+    MirPixelFormat pixel_format() const override;
+    NativeBufferBase* native_buffer_base() override;
+
+private:
+    geometry::Size const size_;
+    std::array<float, 4> const rgba;
+};
+}
+}
+
+#endif /* MIR_GRAPHICS_SOLID_COLOUR_BUFFER_H_ */
@@ -0,0 +1,217 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "miral/background_suspension.h"
+
+#include <miral/application_info.h>
+#include <miral/window_info.h>
+#include <miral/window_manager_tools.h>
+
+#include <mir/scene/surface.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <csignal>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+bool is_hidden_state(MirWindowState state)
+{
+    return state == mir_window_state_minimized || state == mir_window_state_hidden;
+}
+
+// Has windows, and none of them can be seen
+bool is_background(miral::WindowManagerTools& tools, miral::ApplicationInfo& app_info)
+{
+    auto const& windows = app_info.windows();
+
+    if (windows.empty())
+        return false;
+
+    return std::all_of(begin(windows), end(windows), [&](miral::Window const& window)
+        {
+            if (is_hidden_state(tools.info_for(window).state()))
+                return true;
+
+            std::shared_ptr<mir::scene::Surface> const surface{window};
+            return surface->query(mir_window_attrib_visibility) == mir_window_visibility_occluded;
+        });
+}
+}
+
+struct miral::BackgroundSuspension::Self
+{
+    Self(WindowManagerTools const& tools, std::chrono::milliseconds suspend_after, bool freeze_processes);
+    ~Self();
+
+    struct State
+    {
+        std::chrono::steady_clock::time_point background_since;
+        bool background;
+        bool suspended;
+        bool frozen;
+    };
+
+    using Key = std::weak_ptr<mir::scene::Session>;
+
+    void check_applications();
+    void suspend(Application const& application, State& state);
+    void resume(Application const& application);
+
+    WindowManagerTools tools;
+    std::chrono::milliseconds const suspend_after;
+    bool const freeze_processes;
+
+    /// Only accessed under the window manager lock (or after the thread is joined)
+    std::map<Key, State, std::owner_less<Key>> applications;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping{false};
+    std::thread timer;
+};
+
+miral::BackgroundSuspension::Self::Self(
+    WindowManagerTools const& tools,
+    std::chrono::milliseconds suspend_after,
+    bool freeze_processes) :
+    tools{tools},
+    suspend_after{suspend_after},
+    freeze_processes{freeze_processes}
+{
+    // Occlusion changes aren't advised to the policy, so we look for them periodically
+    auto const poll_interval = std::max<std::chrono::milliseconds>(suspend_after/4, 100ms);
+
+    timer = std::thread{[this, poll_interval]
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            while (!cv.wait_for(lock, poll_interval, [this] { return stopping; }))
+            {
+                lock.unlock();
+                this->tools.invoke_under_lock([this] { check_applications(); });
+                lock.lock();
+            }
+        }};
+}
+
+miral::BackgroundSuspension::Self::~Self()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    cv.notify_all();
+    timer.join();
+
+    // Don't leave stopped processes behind us. Only those still connected: once a session
+    // has gone its pid may belong to some other process.
+    for (auto const& app : applications)
+    {
+        if (app.second.frozen)
+        {
+            if (auto const application = app.first.lock())
+                kill(application, SIGCONT);
+        }
+    }
+}
+
+void miral::BackgroundSuspension::Self::check_applications()
+{
+    auto const now = std::chrono::steady_clock::now();
+    auto const active_application = tools.active_window().application();
+
+    tools.for_each_application([&](ApplicationInfo& app_info)
+        {
+            auto const application = app_info.application();
+
+            if (application == active_application || !is_background(tools, app_info))
+            {
+                resume(application);
+                return;
+            }
+
+            auto& state = applications.emplace(
+                application, State{now, true, false, false}).first->second;
+
+            if (!state.background)
+            {
+                state.background = true;
+                state.background_since = now;
+            }
+
+            if (!state.suspended && now - state.background_since >= suspend_after)
+                suspend(application, state);
+        });
+}
+
+void miral::BackgroundSuspension::Self::suspend(Application const& application, State& state)
+{
+    apply_lifecycle_state_to(application, mir_lifecycle_state_will_suspend);
+    state.suspended = true;
+
+    if (freeze_processes)
+    {
+        // miral::kill() won't signal our own process (i.e. internal clients)
+        kill(application, SIGSTOP);
+        state.frozen = true;
+    }
+}
+
+void miral::BackgroundSuspension::Self::resume(Application const& application)
+{
+    auto const i = applications.find(application);
+    if (i == applications.end())
+        return;
+
+    if (i->second.frozen)
+        kill(application, SIGCONT);
+
+    if (i->second.suspended)
+        apply_lifecycle_state_to(application, mir_lifecycle_state_resumed);
+
+    applications.erase(i);
+}
+
+miral::BackgroundSuspension::BackgroundSuspension(
+    WindowManagerTools const& tools,
+    std::chrono::milliseconds suspend_after,
+    bool freeze_processes) :
+    self{std::make_unique<Self>(tools, suspend_after, freeze_processes)}
+{
+}
+
+miral::BackgroundSuspension::~BackgroundSuspension() = default;
+
+void miral::BackgroundSuspension::advise_delete_app(ApplicationInfo const& app_info)
+{
+    self->applications.erase(app_info.application());
+}
+
+void miral::BackgroundSuspension::advise_focus_gained(WindowInfo const& window_info)
+{
+    self->resume(window_info.window().application());
+}
+
+void miral::BackgroundSuspension::advise_state_change(WindowInfo const& window_info, MirWindowState state)
+{
+    if (!is_hidden_state(state))
+        self->resume(window_info.window().application());
+}
@@ -27,6 +27,7 @@
 #include <mir/scene/surface_creation_parameters.h>
 #include <mir/shell/display_layout.h>
 #include <mir/shell/persistent_surface_store.h>
+#include <mir/shell/surface_specification.h>
 #include <mir/shell/surface_ready_observer.h>
 
 #include <boost/throw_exception.hpp>
@@ -36,6 +37,55 @@
 using namespace mir;
 using namespace mir::geometry;
 
+namespace
+{
+/// The size, if that is all the modification changes (of what a WindowSpecification would take from it)
+auto client_size_only(mir::shell::SurfaceSpecification const& spec) -> mir::optional_value<Size>
+{
+    if (!spec.width.is_set() || !spec.height.is_set())
+        return {};
+
+    bool const only_size =
+        !spec.top_left.is_set() &&
+        !spec.pixel_format.is_set() &&
+        !spec.buffer_usage.is_set() &&
+        !spec.name.is_set() &&
+        !spec.output_id.is_set() &&
+        !spec.type.is_set() &&
+        !spec.state.is_set() &&
+        !spec.preferred_orientation.is_set() &&
+        !spec.aux_rect.is_set() &&
+        !spec.placement_hints.is_set() &&
+        !spec.surface_placement_gravity.is_set() &&
+        !spec.aux_rect_placement_gravity.is_set() &&
+        !spec.aux_rect_placement_offset_x.is_set() &&
+        !spec.aux_rect_placement_offset_y.is_set() &&
+        !spec.edge_attachment.is_set() &&
+        !spec.min_width.is_set() &&
+        !spec.min_height.is_set() &&
+        !spec.max_width.is_set() &&
+        !spec.max_height.is_set() &&
+        !spec.width_inc.is_set() &&
+        !spec.height_inc.is_set() &&
+        !spec.min_aspect.is_set() &&
+        !spec.max_aspect.is_set() &&
+        !spec.streams.is_set() &&
+        !spec.parent.is_set() &&
+        !spec.input_shape.is_set() &&
+        !spec.shell_chrome.is_set() &&
+        !spec.confine_pointer.is_set() &&
+        !spec.depth_layer.is_set() &&
+        !spec.attached_edges.is_set() &&
+        !spec.exclusive_rect.is_set() &&
+        !spec.application_id.is_set();
+
+    if (!only_size)
+        return {};
+
+    return Size{spec.width.value(), spec.height.value()};
+}
+}
+
 struct miral::BasicWindowManager::Locker
 {
     explicit Locker(miral::BasicWindowManager* self);
@@ -75,6 +125,7 @@ miral::BasicWindowManager::BasicWindowManager(
     persistent_surface_store{persistent_surface_store},
     policy(build(WindowManagerTools{this})),
     policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())},
+    policy_client_resize_addendum{ClientResizeAddendum::from(policy.get())},
     display_config_monitor{std::make_shared<DisplayConfigurationListeners>()}
 {
     display_config_monitor->add_listener(this);
@@ -185,6 +236,14 @@ void miral::BasicWindowManager::modify_surface(
         return;
     }
     auto& info = info_for(surface);
+
+    // Clients resizing (interactively, or animating) do so every frame: don't build a WindowSpecification for that
+    if (auto const new_size = client_size_only(modifications))
+    {
+        resize_for_client(info, new_size.value());
+        return;
+    }
+
     WindowSpecification mods{modifications};
     validate_modification_request(mods, info);
     place_and_size_for_state(mods, info);
@@ -1182,6 +1241,24 @@ void miral::BasicWindowManager::place_and_size(WindowInfo& root, Point const& ne
     move_tree(root, new_pos - root.window().top_left());
 }
 
+void miral::BasicWindowManager::resize_for_client(WindowInfo& window_info, Size const& new_size)
+{
+    if (new_size.width <= Width{0})
+        BOOST_THROW_EXCEPTION(std::runtime_error("width must be positive"));
+
+    if (new_size.height <= Height{0})
+        BOOST_THROW_EXCEPTION(std::runtime_error("height must be positive"));
+
+    auto const size = policy_client_resize_addendum->confirm_client_resize(window_info, new_size);
+    auto& window = window_info.window();
+
+    place_and_size(window_info, window.top_left(), size);
+
+    // As in modify_window(): the size of an attached window can change the application zones
+    if (window_info.state() == mir_window_state_attached)
+        update_windows_for_outputs();
+}
+
 void miral::BasicWindowManager::place_attached_to_zone(
     WindowInfo& info,
     Rectangle const& application_zone,
@@ -2483,9 +2560,14 @@ void miral::BasicWindowManager::advise_output_create(miral::Output const& output
     outputs.add(output.extents());
 
     auto area = std::make_shared<DisplayArea>(output);
+
+    // Only windows on areas the new output overlaps can end up somewhere else
+    auto changed_areas = display_areas_overlapping(area->area);
+    auto const displaced = fullscreen_windows_on(changed_areas);
+    changed_areas.push_back(area);
     display_areas.push_back(area);
 
-    update_windows_for_outputs();
+    update_windows_for_display_areas(changed_areas, displaced);
     policy->advise_output_create(output);
     policy_application_zone_addendum->advise_application_zone_create(area->application_zone);
 }
@@ -2497,16 +2579,34 @@ void miral::BasicWindowManager::advise_output_update(miral::Output const& update
     outputs.remove(original.extents());
     outputs.add(updated.extents());
 
+    std::vector<std::shared_ptr<DisplayArea>> changed_areas;
     for (auto& area : display_areas)
     {
         if (area->output && area->output.value().is_same_output(original))
         {
             area->output = updated;
+            if (area->area != updated.extents())
+                changed_areas.push_back(area);
+        }
+    }
+
+    // Changes that don't move or resize the output (power mode, scale, etc.) leave every window where it is
+    if (!changed_areas.empty())
+    {
+        auto const displaced = fullscreen_windows_on(changed_areas);
+
+        for (auto const& area : changed_areas)
             area->area = updated.extents();
+
+        for (auto const& overlapped : display_areas_overlapping(updated.extents()))
+        {
+            if (std::find(changed_areas.begin(), changed_areas.end(), overlapped) == changed_areas.end())
+                changed_areas.push_back(overlapped);
         }
+
+        update_windows_for_display_areas(changed_areas, displaced);
     }
 
-    update_windows_for_outputs();
     policy->advise_output_update(updated, original);
 }
 
@@ -2521,6 +2621,8 @@ void miral::BasicWindowManager::advise_output_delete(miral::Output const& output
             removed_areas.push_back(area);
     }
 
+    auto const displaced = fullscreen_windows_on(removed_areas);
+
     display_areas.erase(
         std::remove_if(
             display_areas.begin(),
@@ -2532,16 +2634,22 @@ void miral::BasicWindowManager::advise_output_delete(miral::Output const& output
 
     outputs.remove(output.extents());
 
+    // Only the areas that take on windows from the removed output need their windows re-placing
+    std::vector<std::shared_ptr<DisplayArea>> changed_areas;
     for (auto const& area : removed_areas)
     {
         for (auto const& window : area->attached_windows)
         {
             auto info{info_for(window)};
             update_attached_and_fullscreen_sets(info, info.state());
+
+            auto const new_area = display_area_for(info);
+            if (std::find(changed_areas.begin(), changed_areas.end(), new_area) == changed_areas.end())
+                changed_areas.push_back(new_area);
         }
     }
 
-    update_windows_for_outputs();
+    update_windows_for_display_areas(changed_areas, displaced);
     for (auto& area : removed_areas)
         policy_application_zone_addendum->advise_application_zone_delete(area->application_zone);
     policy->advise_output_delete(output);
@@ -2549,18 +2657,67 @@ void miral::BasicWindowManager::advise_output_delete(miral::Output const& output
 
 void miral::BasicWindowManager::update_windows_for_outputs()
 {
+    update_windows_for_display_areas(display_areas, {});
+}
+
+auto miral::BasicWindowManager::fullscreen_windows_on(std::vector<std::shared_ptr<DisplayArea>> const& areas) const
+-> std::set<Window>
+{
+    std::set<Window> result;
+
+    for (auto const& window : fullscreen_surfaces)
+    {
+        if (window)
+        {
+            auto const area = display_area_for(info_for(window));
+            if (std::find(areas.begin(), areas.end(), area) != areas.end())
+                result.insert(window);
+        }
+    }
+
+    return result;
+}
+
+auto miral::BasicWindowManager::display_areas_overlapping(Rectangle const& rect) const
+-> std::vector<std::shared_ptr<DisplayArea>>
+{
+    std::vector<std::shared_ptr<DisplayArea>> result;
+
+    for (auto const& area : display_areas)
+    {
+        if (area->area.overlaps(rect))
+            result.push_back(area);
+    }
+
+    return result;
+}
+
+void miral::BasicWindowManager::update_windows_for_display_areas(
+    std::vector<std::shared_ptr<DisplayArea>> const& changed_areas,
+    std::set<Window> const& displaced_fullscreen_windows)
+{
+    auto const changed = [&](std::shared_ptr<DisplayArea> const& area)
+        {
+            return std::find(changed_areas.begin(), changed_areas.end(), area) != changed_areas.end();
+        };
+
     for (auto const& window : fullscreen_surfaces)
     {
         if (window)
         {
             auto& info = info_for(window);
+            auto const area = display_area_for(info);
+
+            if (!changed(area) && !displaced_fullscreen_windows.count(window))
+                continue;
+
             auto const rect =
-                policy->confirm_placement_on_display(info, mir_window_state_fullscreen, display_area_for(info)->area);
+                policy->confirm_placement_on_display(info, mir_window_state_fullscreen, area->area);
             place_and_size(info, rect.top_left, rect.size);
         }
     }
 
-    for (auto& area : display_areas)
+    for (auto& area : changed_areas)
     {
         Rectangle zone_rect = area->area;
 
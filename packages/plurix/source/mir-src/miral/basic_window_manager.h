@@ -22,6 +22,7 @@
 #include "window_manager_tools_implementation.h"
 
 #include "miral/window_management_policy.h"
+#include "miral/client_resize_addendum.h"
 #include "miral/window_info.h"
 #include "active_outputs.h"
 #include "miral/application.h"
@@ -236,6 +237,7 @@ private:
 
     std::unique_ptr<WindowManagementPolicy> const policy;
     WindowManagementPolicy::ApplicationZoneAddendum* const policy_application_zone_addendum;
+    ClientResizeAddendum* const policy_client_resize_addendum;
 
     std::mutex mutex;
     SessionInfoMap app_info;
@@ -281,6 +283,7 @@ private:
     void erase(miral::WindowInfo const& info);
     void validate_modification_request(WindowSpecification const& modifications, WindowInfo const& window_info) const;
     void place_and_size(WindowInfo& root, Point const& new_pos, Size const& new_size);
+    void resize_for_client(WindowInfo& window_info, Size const& new_size);
     void place_attached_to_zone(
         WindowInfo& info,
         mir::geometry::Rectangle const& application_zone,
@@ -303,6 +306,12 @@ private:
     void advise_output_update(Output const& updated, Output const& original) override;
     void advise_output_delete(Output const& output) override;
     void update_windows_for_outputs();
+    /// Re-places fullscreen and attached windows, but only those on changed_areas (or displaced from elsewhere)
+    void update_windows_for_display_areas(
+        std::vector<std::shared_ptr<DisplayArea>> const& changed_areas,
+        std::set<Window> const& displaced_fullscreen_windows);
+    auto fullscreen_windows_on(std::vector<std::shared_ptr<DisplayArea>> const& areas) const -> std::set<Window>;
+    auto display_areas_overlapping(Rectangle const& rect) const -> std::vector<std::shared_ptr<DisplayArea>>;
 };
 }
 
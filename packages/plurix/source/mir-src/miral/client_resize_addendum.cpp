@@ -0,0 +1,34 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "miral/client_resize_addendum.h"
+#include "miral/window_management_policy.h"
+
+auto miral::ClientResizeAddendum::confirm_client_resize(WindowInfo const& /*window_info*/, Size const& new_size)
+    -> Size
+{
+    return new_size;
+}
+
+auto miral::ClientResizeAddendum::from(WindowManagementPolicy* policy) -> ClientResizeAddendum*
+{
+    auto result = dynamic_cast<miral::ClientResizeAddendum*>(policy);
+    if (result)
+        return result;
+
+    static miral::ClientResizeAddendum null_client_resize_addendum;
+    return &null_client_resize_addendum;
+}
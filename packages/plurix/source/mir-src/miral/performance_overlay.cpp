@@ -0,0 +1,334 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "miral/performance_overlay.h"
+
+#include <mir/compositor/display_buffer_compositor.h>
+#include <mir/compositor/display_buffer_compositor_factory.h>
+#include <mir/compositor/scene_element.h>
+#include <mir/geometry/displacement.h>
+#include <mir/graphics/display_buffer.h>
+#include <mir/graphics/renderable.h>
+#include <mir/graphics/solid_colour_buffer.h>
+#include <mir/options/option.h>
+#include <mir/server.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+
+namespace mc = mir::compositor;
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+char const* const overlay_option = "performance-overlay";
+
+using Clock = std::chrono::steady_clock;
+
+unsigned const history_length = 60;
+int const margin = 8;
+int const bar_width = 3;
+int const pixels_per_ms = 2;
+int const max_bar_height = 100;
+int const pixels_per_renderable = 2;
+int const max_count_height = 40;
+
+// Shorter gaps between frames are the compositor catching up, not the refresh rate
+auto const min_refresh_period = 4ms;
+
+struct Frame
+{
+    Clock::duration duration;
+    bool bypassed;
+    bool missed_vblank;
+    size_t renderables;
+};
+
+class Rectangle : public mg::Renderable
+{
+public:
+    Rectangle(geom::Rectangle const& area, std::shared_ptr<mg::Buffer> const& colour) :
+        area{area},
+        colour{colour}
+    {
+    }
+
+    unsigned int swap_interval() const override { return 1; }
+    ID id() const override { return this; }
+    std::shared_ptr<mg::Buffer> buffer() const override { return colour; }
+    geom::Rectangle screen_position() const override { return area; }
+    std::experimental::optional<geom::Rectangle> clip_area() const override { return {}; }
+    float alpha() const override { return 1.0f; }
+    glm::mat4 transformation() const override { return glm::mat4(); }
+    bool shaped() const override { return false; }
+
+private:
+    geom::Rectangle const area;
+    std::shared_ptr<mg::Buffer> const colour;
+};
+
+class OverlayElement : public mc::SceneElement
+{
+public:
+    OverlayElement(std::shared_ptr<mg::Renderable> const& renderable) :
+        renderable_{renderable}
+    {
+    }
+
+    std::shared_ptr<mg::Renderable> renderable() const override { return renderable_; }
+    void rendered() override {}
+    void occluded() override {}
+
+private:
+    std::shared_ptr<mg::Renderable> const renderable_;
+};
+
+/// Passes everything through to the real display buffer, noting what happened to the frame
+class RecordingDisplayBuffer : public mg::DisplayBuffer
+{
+public:
+    RecordingDisplayBuffer(mg::DisplayBuffer& wrapped) :
+        wrapped{wrapped}
+    {
+    }
+
+    geom::Rectangle view_area() const override { return wrapped.view_area(); }
+    glm::mat2 transformation() const override { return wrapped.transformation(); }
+    mg::NativeDisplayBuffer* native_display_buffer() override { return wrapped.native_display_buffer(); }
+
+    bool overlay(mg::RenderableList const& renderables) override
+    {
+        if (!recording)
+            return wrapped.overlay(renderables);
+
+        // Bypass is decided without the overlay's renderables: the overlay mustn't change what it measures.
+        // (So the overlay isn't seen on bypassed frames; the following composited frame shows them.)
+        auto end = renderables.end();
+        while (end != renderables.begin() && is_own(*(end - 1)))
+            --end;
+
+        mg::RenderableList const scene{renderables.begin(), end};
+        rendered = scene.size();
+        bypassed = wrapped.overlay(scene);
+        return bypassed;
+    }
+
+    bool recording{false};
+    std::vector<mg::Renderable::ID> own;
+
+    bool bypassed{false};
+    size_t rendered{0};
+
+private:
+    bool is_own(std::shared_ptr<mg::Renderable> const& renderable) const
+    {
+        return std::find(own.begin(), own.end(), renderable->id()) != own.end();
+    }
+
+    mg::DisplayBuffer& wrapped;
+};
+}
+
+struct miral::PerformanceOverlay::Self
+{
+    std::atomic<bool> enabled{false};
+};
+
+namespace
+{
+class OverlayCompositor : public mc::DisplayBufferCompositor
+{
+public:
+    OverlayCompositor(
+        std::shared_ptr<miral::PerformanceOverlay::Self> const& self,
+        mg::DisplayBuffer& display_buffer,
+        mc::DisplayBufferCompositorFactory& factory) :
+        self{self},
+        display_buffer{display_buffer},
+        wrapped{factory.create_compositor_for(this->display_buffer)},
+        background{solid({0.0f, 0.0f, 0.0f, 0.6f})},
+        reference{solid({1.0f, 1.0f, 1.0f, 0.5f})},
+        composited{solid({0.2f, 0.9f, 0.2f, 1.0f})},
+        bypassed{solid({0.3f, 0.5f, 1.0f, 1.0f})},
+        missed{solid({1.0f, 0.2f, 0.2f, 1.0f})},
+        count{solid({0.7f, 0.7f, 0.7f, 1.0f})}
+    {
+    }
+
+    void composite(mc::SceneElementSequence&& scene_elements) override
+    {
+        if (!self->enabled.load(std::memory_order_relaxed))
+        {
+            history.clear();
+            wrapped->composite(std::move(scene_elements));
+            return;
+        }
+
+        auto const start = Clock::now();
+        bool const missed_vblank = check_for_missed_vblank(start);
+
+        add_overlay_to(scene_elements);
+
+        display_buffer.recording = true;
+        wrapped->composite(std::move(scene_elements));
+        display_buffer.recording = false;
+
+        history.push_back({Clock::now() - start, display_buffer.bypassed, missed_vblank, display_buffer.rendered});
+        if (history.size() > history_length)
+            history.pop_front();
+    }
+
+private:
+    static auto solid(std::array<float, 4> const& rgba) -> std::shared_ptr<mg::Buffer>
+    {
+        return std::make_shared<mg::SolidColourBuffer>(geom::Size{1, 1}, rgba);
+    }
+
+    /// The display buffer doesn't tell us its refresh rate, so take it as the shortest gap seen between frames
+    bool check_for_missed_vblank(Clock::time_point now)
+    {
+        auto const interval = now - last_frame;
+        auto const first_frame = history.empty();
+        last_frame = now;
+
+        if (first_frame || interval < min_refresh_period)
+            return false;
+
+        refresh_period = std::min(refresh_period, interval);
+
+        // Much longer gaps are the scene being idle, not a frame being late
+        return interval > refresh_period * 3 / 2 && interval < refresh_period * 4;
+    }
+
+    void add_overlay_to(mc::SceneElementSequence& scene_elements)
+    {
+        display_buffer.own.clear();
+
+        auto const add = [&](geom::Rectangle const& area, std::shared_ptr<mg::Buffer> const& colour)
+            {
+                auto const renderable = std::make_shared<Rectangle>(area, colour);
+                display_buffer.own.push_back(renderable->id());
+                scene_elements.push_back(std::make_shared<OverlayElement>(renderable));
+            };
+
+        auto const origin = display_buffer.view_area().top_left + geom::Displacement{margin, margin};
+        int const width = history_length * bar_width;
+        int const bars_bottom = origin.y.as_int() + max_bar_height;
+        int const counts_bottom = bars_bottom + margin + max_count_height;
+
+        add({origin, {width, counts_bottom - origin.y.as_int()}}, background);
+
+        int x = origin.x.as_int() + int(history_length - history.size()) * bar_width;
+        for (auto const& frame : history)
+        {
+            using ms = std::chrono::duration<float, std::milli>;
+            int const height = std::min(max_bar_height, std::max(1, int(ms{frame.duration}.count() * pixels_per_ms)));
+            auto const& colour = frame.missed_vblank ? missed : frame.bypassed ? bypassed : composited;
+            add({{x, bars_bottom - height}, {bar_width, height}}, colour);
+
+            int const renderables = std::min(max_count_height, int(frame.renderables) * pixels_per_renderable);
+            if (renderables > 0)
+                add({{x, counts_bottom - renderables}, {bar_width, renderables}}, count);
+
+            x += bar_width;
+        }
+
+        // A line at the height of a whole refresh period: bars above it are frames that took too long
+        if (refresh_period < Clock::duration::max())
+        {
+            using ms = std::chrono::duration<float, std::milli>;
+            int const height = int(ms{refresh_period}.count() * pixels_per_ms);
+            if (height < max_bar_height)
+                add({{origin.x.as_int(), bars_bottom - height}, {width, 1}}, reference);
+        }
+    }
+
+    std::shared_ptr<miral::PerformanceOverlay::Self> const self;
+    RecordingDisplayBuffer display_buffer;
+    std::unique_ptr<mc::DisplayBufferCompositor> const wrapped;
+
+    std::shared_ptr<mg::Buffer> const background;
+    std::shared_ptr<mg::Buffer> const reference;
+    std::shared_ptr<mg::Buffer> const composited;
+    std::shared_ptr<mg::Buffer> const bypassed;
+    std::shared_ptr<mg::Buffer> const missed;
+    std::shared_ptr<mg::Buffer> const count;
+
+    std::deque<Frame> history;
+    Clock::time_point last_frame;
+    Clock::duration refresh_period{Clock::duration::max()};
+};
+
+class OverlayCompositorFactory : public mc::DisplayBufferCompositorFactory
+{
+public:
+    OverlayCompositorFactory(
+        std::shared_ptr<miral::PerformanceOverlay::Self> const& self,
+        std::shared_ptr<mc::DisplayBufferCompositorFactory> const& wrapped) :
+        self{self},
+        wrapped{wrapped}
+    {
+    }
+
+    std::unique_ptr<mc::DisplayBufferCompositor> create_compositor_for(mg::DisplayBuffer& display_buffer) override
+    {
+        return std::make_unique<OverlayCompositor>(self, display_buffer, *wrapped);
+    }
+
+private:
+    std::shared_ptr<miral::PerformanceOverlay::Self> const self;
+    std::shared_ptr<mc::DisplayBufferCompositorFactory> const wrapped;
+};
+}
+
+miral::PerformanceOverlay::PerformanceOverlay() :
+    self{std::make_shared<Self>()}
+{
+}
+
+miral::PerformanceOverlay::~PerformanceOverlay() = default;
+miral::PerformanceOverlay::PerformanceOverlay(PerformanceOverlay const&) = default;
+auto miral::PerformanceOverlay::operator=(PerformanceOverlay const&) -> PerformanceOverlay& = default;
+
+void miral::PerformanceOverlay::enable() { self->enabled = true; }
+void miral::PerformanceOverlay::disable() { self->enabled = false; }
+
+void miral::PerformanceOverlay::toggle()
+{
+    auto enabled = self->enabled.load();
+    while (!self->enabled.compare_exchange_weak(enabled, !enabled))
+        ;
+}
+
+void miral::PerformanceOverlay::operator()(mir::Server& server) const
+{
+    server.add_configuration_option(overlay_option, "Show compositor performance on each output", mir::OptionType::null);
+
+    server.wrap_display_buffer_compositor_factory(
+        [&server, self=self](std::shared_ptr<mc::DisplayBufferCompositorFactory> const& wrapped)
+            -> std::shared_ptr<mc::DisplayBufferCompositorFactory>
+        {
+            if (server.get_options()->is_set(overlay_option))
+                self->enabled = true;
+
+            return std::make_shared<OverlayCompositorFactory>(self, wrapped);
+        });
+}
@@ -363,7 +363,8 @@ miral::WindowManagementTrace::WindowManagementTrace(
     WindowManagementPolicyBuilder const& builder) :
     wrapped{wrapped},
     policy(builder(WindowManagerTools{this})),
-    policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())}
+    policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())},
+    policy_client_resize_addendum{ClientResizeAddendum::from(policy.get())}
 {
 }
 
@@ -927,3 +928,11 @@ try {
     return policy_application_zone_addendum->advise_application_zone_delete(application_zone);
 }
 MIRAL_TRACE_EXCEPTION
+
+auto miral::WindowManagementTrace::confirm_client_resize(WindowInfo const& window_info, Size const& new_size)
+-> Size
+try {
+    mir::log_info("%s window_info=%s, new_size=%s", __func__, dump_of(window_info).c_str(), dump_of(new_size).c_str());
+    return policy_client_resize_addendum->confirm_client_resize(window_info, new_size);
+}
+MIRAL_TRACE_EXCEPTION
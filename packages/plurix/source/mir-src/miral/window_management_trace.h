@@ -21,6 +21,7 @@
 
 #include "window_manager_tools_implementation.h"
 
+#include "miral/client_resize_addendum.h"
 #include "miral/window_manager_tools.h"
 #include "miral/window_management_options.h"
 #include "miral/window_management_policy.h"
@@ -32,6 +33,7 @@ namespace miral
 class WindowManagementTrace
     : public WindowManagementPolicy,
       public WindowManagementPolicy::ApplicationZoneAddendum,
+      public ClientResizeAddendum,
       WindowManagerToolsImplementation
 {
 public:
@@ -168,10 +170,13 @@ public:
 
     void advise_application_zone_delete(Zone const& application_zone) override;
 
+    auto confirm_client_resize(WindowInfo const& window_info, Size const& new_size) -> Size override;
+
 private:
     WindowManagerTools wrapped;
     std::unique_ptr<miral::WindowManagementPolicy> const policy;
     miral::WindowManagementPolicy::ApplicationZoneAddendum* const policy_application_zone_addendum;
+    miral::ClientResizeAddendum* const policy_client_resize_addendum;
     std::atomic<unsigned> mutable trace_count;
     std::function<void()> log_input;
 };
@@ -21,6 +21,9 @@
 
 #include <boost/throw_exception.hpp>
 #include <mutex>
+#include <type_traits>
+
+#include <wayland-server-core.h>
 
 #include "mir/graphics/egl_extensions.h"
 #include "mir/graphics/egl_error.h"
@@ -32,6 +35,7 @@
 #include "mir/executor.h"
 #include "mir/graphics/program_factory.h"
 #include "mir/graphics/program.h"
+#include "mir/raii.h"
 
 #include MIR_SERVER_GL_H
 
@@ -101,26 +105,20 @@ EGLint get_wl_egl_format(wl_resource* resource, mg::EGLExtensions::WaylandExtens
     return format;
 }
 
-class WaylandTexBuffer :
-    public mg::BufferBasic,
-    public mg::NativeBufferBase,
-    public mg::gl::Texture
+/// A client's wl_buffer imported as a GL texture
+class ImportedTexture
 {
 public:
     // Note: Must be called with a current EGL context
-    WaylandTexBuffer(
+    ImportedTexture(
         wl_resource* buffer,
         std::shared_ptr<mir::renderer::gl::Context> ctx,
         mg::EGLExtensions const& extensions,
-        std::function<void()>&& on_consumed,
-        std::function<void()>&& on_release,
         std::shared_ptr<mir::Executor> wayland_executor)
         : ctx{std::move(ctx)},
           tex{get_tex_id()},
-          on_consumed{std::move(on_consumed)},
-          on_release{std::move(on_release)},
-          size_{get_wl_buffer_size(buffer, *extensions.wayland)},
-          layout_{get_texture_layout(buffer, *extensions.wayland)},
+          size{get_wl_buffer_size(buffer, *extensions.wayland)},
+          layout{get_texture_layout(buffer, *extensions.wayland)},
           egl_format{get_wl_egl_format(buffer, *extensions.wayland)},
           wayland_executor{std::move(wayland_executor)}
     {
@@ -159,7 +157,7 @@ public:
         extensions.eglDestroyImageKHR(eglGetCurrentDisplay(), egl_image);
     }
 
-    ~WaylandTexBuffer()
+    ~ImportedTexture()
     {
         wayland_executor->spawn(
             [context = ctx, tex = tex]()
@@ -170,7 +168,89 @@ public:
 
               context->release_current();
             });
+    }
+
+    ImportedTexture(ImportedTexture const&) = delete;
+    ImportedTexture& operator=(ImportedTexture const&) = delete;
+
+    std::shared_ptr<mir::renderer::gl::Context> const ctx;
+    GLuint const tex;
+
+    geom::Size const size;
+    mg::gl::Texture::Layout const layout;
+    EGLint const egl_format;
+
+    std::shared_ptr<mir::Executor> const wayland_executor;
+};
+
+/*
+ * Clients cycle through the same few wl_buffers, so each is imported the first time it is
+ * committed and the import reused on every later commit, until the client destroys the wl_buffer.
+ */
+struct BoundImport
+{
+    static auto texture_for_buffer(
+        wl_resource* buffer,
+        std::shared_ptr<mir::renderer::gl::Context> const& ctx,
+        mg::EGLExtensions const& extensions,
+        std::shared_ptr<mir::Executor> const& wayland_executor) -> std::shared_ptr<ImportedTexture const>
+    {
+        if (auto notifier = wl_resource_get_destroy_listener(buffer, &on_buffer_destroyed))
+        {
+            BoundImport* me;
+            me = wl_container_of(notifier, me, destruction_listener);
+            return me->texture;
+        }
+
+        auto const context_guard = mir::raii::paired_calls(
+            [&ctx]() { ctx->make_current(); },
+            [&ctx]() { ctx->release_current(); });
+        auto const texture = std::make_shared<ImportedTexture const>(buffer, ctx, extensions, wayland_executor);
+
+        auto const me = new BoundImport;
+        me->texture = texture;
+        me->destruction_listener.notify = &on_buffer_destroyed;
+        wl_resource_add_destroy_listener(buffer, &me->destruction_listener);
 
+        return texture;
+    }
+
+private:
+    static void on_buffer_destroyed(wl_listener* listener, void*)
+    {
+        static_assert(
+            std::is_standard_layout<BoundImport>::value,
+            "BoundImport must be Standard Layout for wl_container_of to be defined behaviour");
+
+        // Buffers still waiting to be composited keep the texture alive until they are done with it
+        BoundImport* me;
+        me = wl_container_of(listener, me, destruction_listener);
+        delete me;
+    }
+
+    std::shared_ptr<ImportedTexture const> texture;
+    wl_listener destruction_listener;
+};
+
+/// One commit of a wl_buffer: the texture is shared with the buffer's other commits
+class WaylandTexBuffer :
+    public mg::BufferBasic,
+    public mg::NativeBufferBase,
+    public mg::gl::Texture
+{
+public:
+    WaylandTexBuffer(
+        std::shared_ptr<ImportedTexture const> texture,
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release)
+        : texture{std::move(texture)},
+          on_consumed{std::move(on_consumed)},
+          on_release{std::move(on_release)}
+    {
+    }
+
+    ~WaylandTexBuffer()
+    {
         on_release();
     }
 
@@ -181,7 +261,7 @@ public:
 
     mir::geometry::Size size() const override
     {
-        return size_;
+        return texture->size;
     }
 
     MirPixelFormat pixel_format() const override
@@ -189,7 +269,7 @@ public:
         /* TODO: These are lies, but the only piece of information external code uses
          * out of the MirPixelFormat is whether or not the buffer has an alpha channel.
          */
-        switch(egl_format)
+        switch(texture->egl_format)
         {
         case EGL_TEXTURE_RGB:
             return mir_pixel_format_xrgb_8888;
@@ -232,12 +312,12 @@ public:
 
     Layout layout() const override
     {
-        return layout_;
+        return texture->layout;
     }
 
     void bind() override
     {
-        glBindTexture(GL_TEXTURE_2D, tex);
+        glBindTexture(GL_TEXTURE_2D, texture->tex);
 
         std::lock_guard<decltype(consumed_mutex)> lock(consumed_mutex);
         on_consumed();
@@ -248,18 +328,11 @@ public:
     {
     }
 private:
-    std::shared_ptr<mir::renderer::gl::Context> const ctx;
-    GLuint const tex;
+    std::shared_ptr<ImportedTexture const> const texture;
 
     std::mutex consumed_mutex;
     std::function<void()> on_consumed;
     std::function<void()> const on_release;
-
-    geom::Size const size_;
-    Layout const layout_;
-    EGLint const egl_format;
-
-    std::shared_ptr<mir::Executor> const wayland_executor;
 };
 }
 
@@ -286,11 +359,9 @@ auto mg::wayland::buffer_from_resource(
     mg::EGLExtensions const& extensions,
     std::shared_ptr<mir::Executor> wayland_executor) -> std::unique_ptr<mg::Buffer>
 {
+    // Only a buffer's first commit needs the context, to import it
     return std::make_unique<WaylandTexBuffer>(
-        buffer,
-        ctx,
-        extensions,
+        BoundImport::texture_for_buffer(buffer, ctx, extensions, wayland_executor),
         std::move(on_consumed),
-        std::move(on_release),
-        wayland_executor);
+        std::move(on_release));
 }
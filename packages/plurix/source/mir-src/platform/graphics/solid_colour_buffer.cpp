@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/solid_colour_buffer.h"
+
+#include <algorithm>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+namespace
+{
+auto clamped(std::array<float, 4> rgba) -> std::array<float, 4>
+{
+    for (auto& component : rgba)
+        component = std::min(std::max(component, 0.0f), 1.0f);
+
+    return rgba;
+}
+}
+
+mg::SolidColourBuffer::SolidColourBuffer(geom::Size const& size, std::array<float, 4> const& rgba)
+    : size_{size},
+      rgba{clamped(rgba)}
+{
+}
+
+auto mg::SolidColourBuffer::premultiplied_colour() const -> std::array<float, 4>
+{
+    auto const alpha = rgba[3];
+    return {{rgba[0] * alpha, rgba[1] * alpha, rgba[2] * alpha, alpha}};
+}
+
+std::shared_ptr<mg::NativeBuffer> mg::SolidColourBuffer::native_buffer_handle() const
+{
+    return nullptr;
+}
+
+geom::Size mg::SolidColourBuffer::size() const
+{
+    return size_;
+}
+
+MirPixelFormat mg::SolidColourBuffer::pixel_format() const
+{
+    return rgba[3] < 1.0f ? mir_pixel_format_abgr_8888 : mir_pixel_format_xbgr_8888;
+}
+
+mg::NativeBufferBase* mg::SolidColourBuffer::native_buffer_base()
+{
+    return this;
+}
@@ -19,6 +19,7 @@
 #include "mir/shared_library.h"
 #include "mir/options/default_configuration.h"
 #include "mir/graphics/platform.h"
+#include "mir/input/platform.h"
 #include "mir/default_configuration.h"
 #include "mir/abnormal_exit.h"
 #include "mir/shared_library_prober.h"
@@ -42,6 +43,7 @@ char const* const mo::input_report_opt            = "input-report";
 char const* const mo::seat_report_opt            = "seat-report";
 char const* const mo::shared_library_prober_report_opt = "shared-library-prober-report";
 char const* const mo::shell_report_opt            = "shell-report";
+char const* const mo::startup_report_opt          = "startup-report";
 char const* const mo::name_opt                    = "name";
 char const* const mo::offscreen_opt               = "offscreen";
 char const* const mo::touchspots_opt              = "enable-touchspots";
@@ -50,8 +52,11 @@ char const* const mo::fatal_except_opt            = "on-fatal-error-except";
 char const* const mo::debug_opt                   = "debug";
 char const* const mo::composite_delay_opt         = "composite-delay";
 char const* const mo::enable_key_repeat_opt       = "enable-key-repeat";
+char const* const mo::touch_resampling_opt        = "touch-resampling";
+char const* const mo::emulate_session_display_modes_opt = "emulate-session-display-modes";
 char const* const mo::x11_display_opt             = "enable-x11";
 char const* const mo::wayland_extensions_opt      = "wayland-extensions";
+char const* const mo::wayland_dispatch_threads_opt = "wayland-dispatch-threads";
 char const* const mo::enable_mirclient_opt        = "enable-mirclient";
 
 char const* const mo::off_opt_value = "off";
@@ -182,6 +187,8 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "How to handle the SharedLibraryProber report. [{log,lttng,off}]")
         (shell_report_opt, po::value<std::string>()->default_value(off_opt_value),
          "How to handle the Shell report. [{log,off}]")
+        (startup_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "How to handle the startup timeline report. [{log,off}]")
         (composite_delay_opt, po::value<int>()->default_value(0),
             "Compositor frame delay in milliseconds (how long to wait for new "
             "frames from clients before compositing). Higher values result in "
@@ -198,6 +205,17 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Cursor (mouse pointer) to use [{auto,null,software}]")
         (enable_key_repeat_opt, po::value<bool>()->default_value(true),
              "Enable server generated key repeat")
+        (touch_resampling_opt, po::value<bool>()->default_value(false),
+             "Send continuously rendering Wayland clients one touch motion per frame, "
+             "resampled to the time the frame is expected to be shown. Clients that ask "
+             "for high resolution input timestamps still get the original samples")
+        (emulate_session_display_modes_opt, po::value<bool>()->default_value(true),
+             "When the focused application has its own display configuration, keep the hardware "
+             "modes of the base configuration and scale to the resolutions it asked for, rather "
+             "than changing modes on every focus switch")
+        (wayland_dispatch_threads_opt, po::value<int>()->default_value(1),
+             "Number of threads to share Wayland clients between. Clients of programs that "
+             "may attach GPU buffers are kept on the first thread")
         (fatal_except_opt, "On \"fatal error\" conditions [e.g. drivers behaving "
             "in unexpected ways] throw an exception (instead of a core dump)")
         (debug_opt, "Enable extra development debugging. "
@@ -227,6 +245,9 @@ void mo::DefaultConfiguration::add_platform_options()
     program_options.add_options()
         (platform_graphics_lib,
          po::value<std::string>(), "");
+    program_options.add_options()
+        (platform_input_lib,
+         po::value<std::string>(), "");
     program_options.add_options()
         (platform_path,
          po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
@@ -281,6 +302,40 @@ void mo::DefaultConfiguration::add_platform_options()
             }
         }
 
+        // Input modules have options too (and they are probed for separately, so may not be among the above)
+        auto input_libraries =
+            [env_libpath, &options]()
+            {
+                if (options.is_set(platform_input_lib))
+                {
+                    return std::vector<std::shared_ptr<mir::SharedLibrary>>{
+                        std::make_shared<mir::SharedLibrary>(
+                            options.get<std::string>(platform_input_lib))};
+                }
+                else
+                {
+                    mir::logging::NullSharedLibraryProberReport null_report;
+                    auto const plugin_path = env_libpath ? env_libpath : options.get<std::string>(platform_path);
+                    return mir::libraries_for_path(plugin_path, null_report);
+                }
+            }();
+
+        for (auto& platform : input_libraries)
+        {
+            try
+            {
+                auto add_platform_options = platform->load_function<mir::input::AddPlatformOptions>("add_input_platform_options", MIR_SERVER_INPUT_PLATFORM_VERSION);
+                add_platform_options(*this->program_options);
+
+                // The options refer to code in the library, so it has to stay loaded
+                platform_libraries.push_back(platform);
+            }
+            catch (std::runtime_error&)
+            {
+                // Not an input platform, or the wrong version
+            }
+        }
+
         // Remove the shared_ptrs to the libraries we've unloaded from the vector.
         platform_libraries.erase(
             std::remove(
@@ -26,6 +26,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mir
 {
@@ -43,7 +44,10 @@ typedef std::unique_ptr<drmModePlane,std::function<void(drmModePlane*)>> DRMMode
 typedef std::unique_ptr<drmModeObjectProperties,void(*)(drmModeObjectProperties*)> DRMModeObjectPropsUPtr;
 typedef std::unique_ptr<drmModePropertyRes,void(*)(drmModePropertyPtr)> DRMModePropertyUPtr;
 
+/// Query a connector, forcing the kernel to probe it (which may read EDID over DDC, so may be slow)
 DRMModeConnectorUPtr get_connector(int drm_fd, uint32_t id);
+/// Query the kernel's cached state of a connector without forcing a probe
+DRMModeConnectorUPtr get_connector_current(int drm_fd, uint32_t id);
 DRMModeEncoderUPtr get_encoder(int drm_fd, uint32_t id);
 DRMModeCrtcUPtr get_crtc(int drm_fd, uint32_t id);
 DRMModePlaneUPtr get_plane(int drm_fd, uint32_t id);
@@ -143,6 +147,7 @@ public:
     void for_each_crtc(std::function<void(DRMModeCrtcUPtr)> const& f) const;
 
     size_t num_connectors() const;
+    std::vector<uint32_t> connector_ids() const;
 
     size_t num_encoders() const;
 
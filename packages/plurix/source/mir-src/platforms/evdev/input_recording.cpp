@@ -0,0 +1,291 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_recording.h"
+
+#include "mir/input/device_capability.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mi = mir::input;
+namespace mier = mi::evdev::recording;
+
+namespace
+{
+char const magic[8] = {'M', 'I', 'R', 'I', 'N', 'R', 'E', 'C'};
+uint32_t const version{1};
+
+static_assert(std::is_trivially_copyable<mir::events::ContactState>::value, "contacts are recorded as raw bytes");
+
+template<typename T>
+void put(std::ostream& out, T const& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values are written directly");
+    out.write(reinterpret_cast<char const*>(&value), sizeof value);
+}
+
+void put(std::ostream& out, std::string const& value)
+{
+    put(out, static_cast<uint32_t>(value.size()));
+    out.write(value.data(), value.size());
+}
+
+template<typename T>
+void get(std::istream& in, T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values are read directly");
+    in.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+void get(std::istream& in, std::string& value)
+{
+    uint32_t size;
+    get(in, size);
+    if (!in)
+        return;
+    value.resize(size);
+    in.read(&value[0], size);
+}
+}
+
+mier::Writer::Writer(std::string const& path) :
+    file{path, std::ios::binary | std::ios::trunc}
+{
+    if (!file)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to create input recording: " + path});
+
+    file.write(magic, sizeof magic);
+    put(file, version);
+}
+
+void mier::Writer::write(Entry const& entry)
+{
+    put(file, entry.record);
+    put(file, entry.device);
+    put(file, static_cast<int64_t>(entry.time.count()));
+
+    switch (entry.record)
+    {
+    case Record::device_added:
+        put(file, entry.info.name);
+        put(file, entry.info.unique_id);
+        put(file, entry.info.capabilities.value());
+        break;
+
+    case Record::device_removed:
+        break;
+
+    case Record::key:
+        put(file, entry.key_action);
+        put(file, entry.keysym);
+        put(file, entry.scan_code);
+        break;
+
+    case Record::absolute_pointer:
+        put(file, entry.x);
+        put(file, entry.y);
+        // fallthrough
+    case Record::pointer:
+        put(file, entry.pointer_action);
+        put(file, entry.buttons);
+        put(file, entry.hscroll);
+        put(file, entry.vscroll);
+        put(file, entry.relative_x);
+        put(file, entry.relative_y);
+        break;
+
+    case Record::touch:
+        put(file, static_cast<uint32_t>(entry.contacts.size()));
+        for (auto const& contact : entry.contacts)
+            put(file, contact);
+        break;
+    }
+
+    // A recording is most often wanted of a session that ended badly: don't leave the end of it in a buffer
+    file.flush();
+}
+
+mier::Reader::Reader(std::string const& path) :
+    path{path},
+    file{path, std::ios::binary}
+{
+    char file_magic[sizeof magic];
+    uint32_t file_version{0};
+
+    file.read(file_magic, sizeof file_magic);
+    get(file, file_version);
+
+    if (!file || memcmp(file_magic, magic, sizeof magic) != 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Not an input recording: " + path});
+
+    if (file_version != version)
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Unsupported input recording version: " + path});
+}
+
+bool mier::Reader::read(Entry& entry)
+{
+    int64_t time;
+
+    get(file, entry.record);
+    get(file, entry.device);
+    get(file, time);
+
+    if (file.eof())
+        return false;
+
+    entry.time = std::chrono::nanoseconds{time};
+
+    switch (entry.record)
+    {
+    case Record::device_added:
+    {
+        DeviceCapabilities::value_type capabilities;
+        get(file, entry.info.name);
+        get(file, entry.info.unique_id);
+        get(file, capabilities);
+        entry.info.capabilities = DeviceCapabilities{capabilities};
+        break;
+    }
+
+    case Record::device_removed:
+        break;
+
+    case Record::key:
+        get(file, entry.key_action);
+        get(file, entry.keysym);
+        get(file, entry.scan_code);
+        break;
+
+    case Record::absolute_pointer:
+        get(file, entry.x);
+        get(file, entry.y);
+        // fallthrough
+    case Record::pointer:
+        get(file, entry.pointer_action);
+        get(file, entry.buttons);
+        get(file, entry.hscroll);
+        get(file, entry.vscroll);
+        get(file, entry.relative_x);
+        get(file, entry.relative_y);
+        break;
+
+    case Record::touch:
+    {
+        uint32_t count{0};
+        get(file, count);
+        entry.contacts.resize(file ? count : 0);
+        for (auto& contact : entry.contacts)
+            get(file, contact);
+        break;
+    }
+
+    default:
+        BOOST_THROW_EXCEPTION(std::runtime_error{"Corrupt input recording: " + path});
+    }
+
+    // A recording cut short (e.g. by the server being killed) ends at its last whole entry
+    return !file.fail();
+}
+
+mier::RecordingEventBuilder::RecordingEventBuilder(
+    EventBuilder* builder,
+    std::shared_ptr<Writer> const& writer,
+    uint32_t device) :
+    builder{builder},
+    writer{writer},
+    device{device}
+{
+}
+
+mir::EventUPtr mier::RecordingEventBuilder::key_event(
+    Timestamp timestamp, MirKeyboardAction action, xkb_keysym_t key_code, int scan_code)
+{
+    Entry entry{};
+    entry.record = Record::key;
+    entry.device = device;
+    entry.time = timestamp;
+    entry.key_action = action;
+    entry.keysym = key_code;
+    entry.scan_code = scan_code;
+    writer->write(entry);
+
+    return builder->key_event(timestamp, action, key_code, scan_code);
+}
+
+mir::EventUPtr mier::RecordingEventBuilder::touch_event(
+    Timestamp timestamp, std::vector<events::ContactState> const& contacts)
+{
+    Entry entry{};
+    entry.record = Record::touch;
+    entry.device = device;
+    entry.time = timestamp;
+    entry.contacts = contacts;
+    writer->write(entry);
+
+    return builder->touch_event(timestamp, contacts);
+}
+
+mir::EventUPtr mier::RecordingEventBuilder::pointer_event(
+    Timestamp timestamp, MirPointerAction action, MirPointerButtons buttons_pressed,
+    float hscroll_value, float vscroll_value, float relative_x_value, float relative_y_value)
+{
+    Entry entry{};
+    entry.record = Record::pointer;
+    entry.device = device;
+    entry.time = timestamp;
+    entry.pointer_action = action;
+    entry.buttons = buttons_pressed;
+    entry.hscroll = hscroll_value;
+    entry.vscroll = vscroll_value;
+    entry.relative_x = relative_x_value;
+    entry.relative_y = relative_y_value;
+    writer->write(entry);
+
+    return builder->pointer_event(
+        timestamp, action, buttons_pressed, hscroll_value, vscroll_value, relative_x_value, relative_y_value);
+}
+
+mir::EventUPtr mier::RecordingEventBuilder::pointer_event(
+    Timestamp timestamp, MirPointerAction action, MirPointerButtons buttons_pressed,
+    float x, float y, float hscroll_value, float vscroll_value, float relative_x_value, float relative_y_value)
+{
+    Entry entry{};
+    entry.record = Record::absolute_pointer;
+    entry.device = device;
+    entry.time = timestamp;
+    entry.pointer_action = action;
+    entry.buttons = buttons_pressed;
+    entry.x = x;
+    entry.y = y;
+    entry.hscroll = hscroll_value;
+    entry.vscroll = vscroll_value;
+    entry.relative_x = relative_x_value;
+    entry.relative_y = relative_y_value;
+    writer->write(entry);
+
+    return builder->pointer_event(
+        timestamp, action, buttons_pressed, x, y, hscroll_value, vscroll_value, relative_x_value, relative_y_value);
+}
+
+mir::EventUPtr mier::RecordingEventBuilder::device_state_event(float cursor_x, float cursor_y)
+{
+    // Only built by the seat, never by a device
+    return builder->device_state_event(cursor_x, cursor_y);
+}
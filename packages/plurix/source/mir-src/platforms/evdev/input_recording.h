@@ -0,0 +1,133 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_EVDEV_INPUT_RECORDING_H_
+#define MIR_INPUT_EVDEV_INPUT_RECORDING_H_
+
+#include "mir/input/event_builder.h"
+#include "mir/input/input_device_info.h"
+#include "mir/events/contact_state.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace input
+{
+namespace evdev
+{
+/**
+ * A recording of the evdev platform's devices, for the input-replay platform to play back.
+ *
+ * What is recorded is each device's calls to its EventBuilder rather than the events built, so
+ * that replay drives the server's own builder (and the seat behind it) exactly as the devices did.
+ * Values are stored in native byte order: a recording is meant to be replayed on the same kind
+ * of machine it was made on.
+ */
+namespace recording
+{
+enum class Record : uint8_t
+{
+    device_added = 1,
+    device_removed,
+    key,
+    pointer,
+    absolute_pointer,
+    touch
+};
+
+/// One entry of a recording: which of the fields are meaningful depends on the record
+struct Entry
+{
+    Record record;
+    uint32_t device;                ///< Numbered by the recording, not the input hub
+    std::chrono::nanoseconds time;  ///< CLOCK_MONOTONIC, as libinput timestamps events
+
+    InputDeviceInfo info;           ///< device_added
+
+    MirKeyboardAction key_action;   ///< key
+    xkb_keysym_t keysym;
+    int scan_code;
+
+    MirPointerAction pointer_action;    ///< pointer and absolute_pointer
+    MirPointerButtons buttons;
+    float x, y;                         ///< absolute_pointer only
+    float hscroll, vscroll;
+    float relative_x, relative_y;
+
+    std::vector<events::ContactState> contacts; ///< touch
+};
+
+class Writer
+{
+public:
+    explicit Writer(std::string const& path);
+
+    void write(Entry const& entry);
+
+private:
+    std::ofstream file;
+};
+
+class Reader
+{
+public:
+    explicit Reader(std::string const& path);
+
+    /// \returns false at the end of the recording
+    bool read(Entry& entry);
+
+private:
+    std::string const path;
+    std::ifstream file;
+};
+
+/// Records the calls a device makes to build its events, and passes them on
+class RecordingEventBuilder : public EventBuilder
+{
+public:
+    RecordingEventBuilder(EventBuilder* builder, std::shared_ptr<Writer> const& writer, uint32_t device);
+
+    EventUPtr key_event(Timestamp timestamp, MirKeyboardAction action, xkb_keysym_t key_code, int scan_code) override;
+
+    EventUPtr touch_event(Timestamp timestamp, std::vector<events::ContactState> const& contacts) override;
+
+    EventUPtr pointer_event(Timestamp timestamp, MirPointerAction action, MirPointerButtons buttons_pressed,
+                            float hscroll_value, float vscroll_value, float relative_x_value,
+                            float relative_y_value) override;
+
+    EventUPtr pointer_event(Timestamp timestamp, MirPointerAction action, MirPointerButtons buttons_pressed,
+                            float x, float y, float hscroll_value, float vscroll_value, float relative_x_value,
+                            float relative_y_value) override;
+
+    EventUPtr device_state_event(float cursor_x, float cursor_y) override;
+
+private:
+    EventBuilder* const builder;
+    std::shared_ptr<Writer> const writer;
+    uint32_t const device;
+};
+}
+}
+}
+}
+
+#endif // MIR_INPUT_EVDEV_INPUT_RECORDING_H_
@@ -21,6 +21,7 @@
 #include "libinput_device_ptr.h"
 #include "evdev_device_detection.h"
 #include "button_utils.h"
+#include "input_recording.h"
 
 #include "mir/input/input_sink.h"
 #include "mir/input/input_report.h"
@@ -29,6 +30,8 @@
 #include "mir/input/touchpad_settings.h"
 #include "mir/input/input_device_info.h"
 #include "mir/events/event_builders.h"
+#include "mir/events/event.h"
+#include "mir/events/pointer_event.h"
 #include "mir/geometry/displacement.h"
 #include "mir/dispatch/dispatchable.h"
 #include "mir/fd.h"
@@ -41,6 +44,7 @@
 #include <dlfcn.h>
 
 #include <boost/exception/diagnostic_information.hpp>
+#include <cmath>
 #include <cstring>
 #include <chrono>
 #include <sstream>
@@ -53,6 +57,10 @@ using namespace std::literals::chrono_literals;
 
 namespace
 {
+// The contact used for a tablet tool tip. It is beyond the range of multitouch slots, so the
+// tool and fingers on a combined pen and touch device can be tracked together.
+MirTouchId const stylus_touch_id{1024};
+
 double touch_major(libinput_event_touch*, uint32_t, uint32_t)
 {
     return 8;
@@ -123,18 +131,48 @@ void mie::LibInputDevice::add_device_of_group(LibInputDevicePtr dev)
     update_device_info();
 }
 
-mie::LibInputDevice::~LibInputDevice() = default;
+mie::LibInputDevice::~LibInputDevice()
+{
+    if (recording_writer)
+    {
+        recording::Entry entry{};
+        entry.record = recording::Record::device_removed;
+        entry.device = recording_id;
+        entry.time = std::chrono::steady_clock::now().time_since_epoch();
+        recording_writer->write(entry);
+    }
+}
 
 void mie::LibInputDevice::start(InputSink* sink, EventBuilder* builder)
 {
     this->sink = sink;
     this->builder = builder;
+
+    if (recording_writer)
+    {
+        recording_builder = std::make_unique<recording::RecordingEventBuilder>(builder, recording_writer, recording_id);
+        this->builder = recording_builder.get();
+    }
 }
 
 void mie::LibInputDevice::stop()
 {
     sink = nullptr;
     builder = nullptr;
+    recording_builder.reset();
+}
+
+void mie::LibInputDevice::record_to(std::shared_ptr<recording::Writer> const& writer, uint32_t id)
+{
+    recording_writer = writer;
+    recording_id = id;
+
+    recording::Entry entry{};
+    entry.record = recording::Record::device_added;
+    entry.device = id;
+    entry.time = std::chrono::steady_clock::now().time_since_epoch();
+    entry.info = info;
+    writer->write(entry);
 }
 
 void mie::LibInputDevice::process_event(libinput_event* event)
@@ -180,6 +218,30 @@ void mie::LibInputDevice::process_event(libinput_event* event)
                 sink->handle_input(convert_touch_frame(libinput_event_get_touch_event(event)));
             }
             break;
+        // A tablet tool in contact is a stylus touch: unlike pointer emulation it is not accelerated or
+        // hit-tested as a cursor, and each sample is sent at full rate with its own pressure.
+        // Hovering and tool buttons are not (yet) represented.
+        case LIBINPUT_EVENT_TABLET_TOOL_TIP:
+        {
+            auto const tool = libinput_event_get_tablet_tool_event(event);
+            if (libinput_event_tablet_tool_get_tip_state(tool) == LIBINPUT_TABLET_TOOL_TIP_DOWN)
+            {
+                if (is_output_active())
+                    sink->handle_input(convert_tablet_tool_event(tool, mir_touch_action_down));
+            }
+            else if (last_seen_properties.count(stylus_touch_id))
+            {
+                sink->handle_input(convert_tablet_tool_event(tool, mir_touch_action_up));
+            }
+            break;
+        }
+        case LIBINPUT_EVENT_TABLET_TOOL_AXIS:
+            if (last_seen_properties.count(stylus_touch_id) && is_output_active())
+            {
+                sink->handle_input(
+                    convert_tablet_tool_event(libinput_event_get_tablet_tool_event(event), mir_touch_action_change));
+            }
+            break;
         default:
             break;
         }
@@ -235,10 +297,16 @@ mir::EventUPtr mie::LibInputDevice::convert_motion_event(libinput_event_pointer*
 
     report->received_event_from_kernel(time.count(), EV_REL, 0, 0);
 
-    return builder->pointer_event(time, action, button_state,
-                                  hscroll_value, vscroll_value,
-                                  libinput_event_pointer_get_dx(pointer),
-                                  libinput_event_pointer_get_dy(pointer));
+    auto event = builder->pointer_event(time, action, button_state,
+                                        hscroll_value, vscroll_value,
+                                        libinput_event_pointer_get_dx(pointer),
+                                        libinput_event_pointer_get_dy(pointer));
+
+    event->to_input()->to_pointer()->set_unaccelerated_motion(
+        libinput_event_pointer_get_dx_unaccelerated(pointer),
+        libinput_event_pointer_get_dy_unaccelerated(pointer));
+
+    return event;
 }
 
 mir::EventUPtr mie::LibInputDevice::convert_absolute_motion_event(libinput_event_pointer* pointer)
@@ -309,9 +377,11 @@ mir::EventUPtr mie::LibInputDevice::convert_touch_frame(libinput_event_touch* to
     std::chrono::nanoseconds const time = std::chrono::microseconds(libinput_event_touch_get_time_usec(touch));
     report->received_event_from_kernel(time.count(), EV_SYN, 0, 0);
 
-    // TODO make libinput indicate tool type
-    auto const tool = mir_touch_tooltype_finger;
+    return touch_frame(time);
+}
 
+mir::EventUPtr mie::LibInputDevice::touch_frame(std::chrono::nanoseconds time)
+{
     std::vector<events::ContactState> contacts;
     for(auto it = begin(last_seen_properties); it != end(last_seen_properties);)
     {
@@ -321,7 +391,7 @@ mir::EventUPtr mie::LibInputDevice::convert_touch_frame(libinput_event_touch* to
         contacts.push_back(events::ContactState{
                            id,
                            data.action,
-                           tool,
+                           data.tool,
                            data.x,
                            data.y,
                            data.pressure,
@@ -341,6 +411,39 @@ mir::EventUPtr mie::LibInputDevice::convert_touch_frame(libinput_event_touch* to
     return builder->touch_event(time, contacts);
 }
 
+mir::EventUPtr mie::LibInputDevice::convert_tablet_tool_event(libinput_event_tablet_tool* tool, MirTouchAction action)
+{
+    std::chrono::nanoseconds const time = std::chrono::microseconds(libinput_event_tablet_tool_get_time_usec(tool));
+    report->received_event_from_kernel(time.count(), EV_ABS, 0, 0);
+
+    auto info = get_output_info();
+
+    uint32_t width = info.output_size.width.as_int();
+    uint32_t height = info.output_size.height.as_int();
+
+    auto& data = last_seen_properties[stylus_touch_id];
+    auto const capabilities = libinput_event_tablet_tool_get_tool(tool);
+
+    data.action = action;
+    data.tool = mir_touch_tooltype_stylus;
+    data.x = libinput_event_tablet_tool_get_x_transformed(tool, width);
+    data.y = libinput_event_tablet_tool_get_y_transformed(tool, height);
+    data.pressure = libinput_tablet_tool_has_pressure(capabilities) ?
+        libinput_event_tablet_tool_get_pressure(tool) : 1.0;
+
+    // The direction the pen leans, in degrees clockwise from the top of the screen
+    if (libinput_tablet_tool_has_tilt(capabilities))
+    {
+        auto const tilt_x = libinput_event_tablet_tool_get_tilt_x(tool);
+        auto const tilt_y = libinput_event_tablet_tool_get_tilt_y(tool);
+        data.orientation = std::atan2(tilt_x, -tilt_y) * 180.0 / M_PI;
+    }
+
+    info.transform_to_scene(data.x, data.y);
+
+    return touch_frame(time);
+}
+
 void mie::LibInputDevice::handle_touch_down(libinput_event_touch* touch)
 {
     MirTouchId const id = libinput_event_touch_get_slot(touch);
@@ -396,6 +499,7 @@ void mie::LibInputDevice::update_device_info()
     auto const mappings = {
         Mapping{"ID_INPUT_MOUSE", mi::DeviceCapability::pointer},
         Mapping{"ID_INPUT_TOUCHSCREEN", mi::DeviceCapability::touchscreen},
+        Mapping{"ID_INPUT_TABLET", mi::DeviceCapability::touchscreen},
         Mapping{"ID_INPUT_TOUCHPAD", Caps(mi::DeviceCapability::touchpad) | mi::DeviceCapability::pointer},
         Mapping{"ID_INPUT_JOYSTICK", mi::DeviceCapability::joystick},
         Mapping{"ID_INPUT_KEY", mi::DeviceCapability::keyboard},
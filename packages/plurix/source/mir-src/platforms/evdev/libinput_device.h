@@ -28,6 +28,7 @@
 #include "mir/input/touchscreen_settings.h"
 #include "mir/geometry/point.h"
 
+#include <chrono>
 #include <vector>
 #include <map>
 
@@ -35,6 +36,7 @@ struct libinput_event;
 struct libinput_event_keyboard;
 struct libinput_event_touch;
 struct libinput_event_pointer;
+struct libinput_event_tablet_tool;
 struct libinput_device_group;
 
 namespace mir
@@ -47,6 +49,11 @@ namespace evdev
 {
 struct PointerState;
 struct KeyboardState;
+namespace recording
+{
+class Writer;
+class RecordingEventBuilder;
+}
 
 class LibInputDevice : public input::InputDevice
 {
@@ -67,6 +74,9 @@ public:
     ::libinput_device* device() const;
     ::libinput_device_group* group();
     void add_device_of_group(LibInputDevicePtr ptr);
+
+    /// Records the device, and the events it builds from now on, as \a id in \a writer's recording
+    void record_to(std::shared_ptr<recording::Writer> const& writer, uint32_t id);
 private:
     EventUPtr convert_event(libinput_event_keyboard* keyboard);
     EventUPtr convert_button_event(libinput_event_pointer* pointer);
@@ -74,9 +84,11 @@ private:
     EventUPtr convert_absolute_motion_event(libinput_event_pointer* pointer);
     EventUPtr convert_axis_event(libinput_event_pointer* pointer);
     EventUPtr convert_touch_frame(libinput_event_touch* touch);
+    EventUPtr touch_frame(std::chrono::nanoseconds time);
     void handle_touch_down(libinput_event_touch* touch);
     void handle_touch_up(libinput_event_touch* touch);
     void handle_touch_motion(libinput_event_touch* touch);
+    EventUPtr convert_tablet_tool_event(libinput_event_tablet_tool* tool, MirTouchAction action);
     void update_device_info();
     bool is_output_active() const;
     OutputInfo get_output_info() const;
@@ -90,6 +102,10 @@ private:
     InputSink* sink{nullptr};
     EventBuilder* builder{nullptr};
 
+    std::shared_ptr<recording::Writer> recording_writer;
+    uint32_t recording_id{0};
+    std::unique_ptr<recording::RecordingEventBuilder> recording_builder;
+
     InputDeviceInfo info;
     mir::geometry::Point pointer_pos;
     MirPointerButtons button_state;
@@ -101,6 +117,7 @@ private:
     {
         ContactData() {}
         MirTouchAction action{mir_touch_action_change};
+        MirTouchTooltype tool{mir_touch_tooltype_finger};
         float x{0}, y{0}, major{0}, minor{0}, pressure{0}, orientation{0};
     };
     std::map<MirTouchId,ContactData> last_seen_properties;
@@ -130,12 +130,14 @@ mie::Platform::Platform(
         std::shared_ptr<InputDeviceRegistry> const& registry,
         std::shared_ptr<InputReport> const& report,
         std::unique_ptr<udev::Context>&& udev_context,
-        std::shared_ptr<ConsoleServices> const& console) :
+        std::shared_ptr<ConsoleServices> const& console,
+        std::shared_ptr<recording::Writer> const& recording) :
     report(report),
     udev_context(std::move(udev_context)),
     input_device_registry(registry),
     console{console},
-    platform_dispatchable{std::make_shared<md::MultiplexingDispatchable>()}
+    platform_dispatchable{std::make_shared<md::MultiplexingDispatchable>()},
+    recording{recording}
 {
 }
 
@@ -429,6 +431,9 @@ void mie::Platform::device_added(libinput_device* dev)
     {
         devices.emplace_back(std::make_shared<mie::LibInputDevice>(report, move(device_ptr)));
 
+        if (recording)
+            devices.back()->record_to(recording, recorded_devices++);
+
         input_device_registry->add_device(devices.back());
 
         report->opened_input_device(libinput_device_get_sysname(dev), "evdev-input");
@@ -55,6 +55,10 @@ namespace evdev
 {
 
 class LibInputDevice;
+namespace recording
+{
+class Writer;
+}
 
 class Platform : public input::Platform
 {
@@ -63,7 +67,8 @@ public:
         std::shared_ptr<InputDeviceRegistry> const& registry,
         std::shared_ptr<InputReport> const& report,
         std::unique_ptr<udev::Context>&& udev_context,
-        std::shared_ptr<ConsoleServices> const& console);
+        std::shared_ptr<ConsoleServices> const& console,
+        std::shared_ptr<recording::Writer> const& recording = {});
     std::shared_ptr<mir::dispatch::Dispatchable> dispatchable() override;
     void start() override;
     void stop() override;
@@ -82,6 +87,8 @@ private:
     std::shared_ptr<InputDeviceRegistry> const input_device_registry;
     std::shared_ptr<ConsoleServices> const console;
     std::shared_ptr<dispatch::MultiplexingDispatchable> const platform_dispatchable;
+    std::shared_ptr<recording::Writer> const recording;
+    uint32_t recorded_devices{0};
     std::shared_ptr<::libinput> lib;
     std::shared_ptr<dispatch::ReadableFd> libinput_dispatchable;
     std::shared_ptr<dispatch::Dispatchable> udev_dispatchable;
@@ -17,10 +17,14 @@
  */
 
 #include "platform.h"
+#include "input_recording.h"
 #include "mir/udev/wrapper.h"
 #include "mir/fd.h"
 #include "mir/assert_module_entry_point.h"
 #include "mir/libname.h"
+#include "mir/options/option.h"
+
+#include <boost/program_options/options_description.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -37,6 +41,8 @@ namespace mie = mi::evdev;
 
 namespace
 {
+char const* const record_input_option = "record-input";
+
 mir::ModuleProperties const description = {
     "mir:evdev-input",
     MIR_VERSION_MAJOR,
@@ -104,25 +110,34 @@ bool can_open_input_devices(mir::ConsoleServices& console)
 }
 
 mir::UniqueModulePtr<mi::Platform> create_input_platform(
-    mo::Option const& /*options*/,
+    mo::Option const& options,
     std::shared_ptr<mir::EmergencyCleanupRegistry> const& /*emergency_cleanup_registry*/,
     std::shared_ptr<mi::InputDeviceRegistry> const& input_device_registry,
     std::shared_ptr<mir::ConsoleServices> const& console,
     std::shared_ptr<mi::InputReport> const& report)
 {
     mir::assert_entry_point_signature<mi::CreatePlatform>(&create_input_platform);
+
+    std::shared_ptr<mie::recording::Writer> recording;
+    if (options.is_set(record_input_option))
+        recording = std::make_shared<mie::recording::Writer>(options.get<std::string>(record_input_option));
+
     return mir::make_module_ptr<mie::Platform>(
         input_device_registry,
         report,
         std::make_unique<mu::Context>(),
-        console);
+        console,
+        recording);
 }
 
 void add_input_platform_options(
-    boost::program_options::options_description& /*config*/)
+    boost::program_options::options_description& config)
 {
     mir::assert_entry_point_signature<mi::AddPlatformOptions>(&add_input_platform_options);
-    // no options to add yet
+    config.add_options()
+        (record_input_option,
+         boost::program_options::value<std::string>(),
+         "[evdev-input specific] Record the input devices to this file, for replay by the input-replay platform");
 }
 
 mi::PlatformPriority probe_input_platform(
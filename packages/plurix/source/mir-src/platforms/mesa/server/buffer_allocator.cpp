@@ -378,10 +378,6 @@ std::shared_ptr<mg::Buffer> mgm::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release)
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
-
     return mg::wayland::buffer_from_resource(
         buffer,
         std::move(on_consumed),
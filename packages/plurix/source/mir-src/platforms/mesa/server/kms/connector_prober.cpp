@@ -0,0 +1,180 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "connector_prober.h"
+#include "kms-utils/drm_mode_resources.h"
+
+#include "mir/log.h"
+
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <sys/eventfd.h>
+
+namespace mgm = mir::graphics::mesa;
+namespace mgk = mir::graphics::kms;
+
+mgm::ConnectorProber::ConnectorProber(std::chrono::milliseconds debounce, std::chrono::milliseconds max_delay)
+    : debounce{debounce},
+      max_delay{max_delay},
+      probed_signal{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)}
+{
+    if (probed_signal < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to create connector probe eventfd"}));
+    }
+
+    worker = std::thread{[this] { run(); }};
+}
+
+mgm::ConnectorProber::~ConnectorProber()
+{
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        stopping = true;
+    }
+    work_available.notify_all();
+    worker.join();
+}
+
+void mgm::ConnectorProber::probe(int drm_fd, uint32_t connector_id)
+{
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        pending.emplace(drm_fd, connector_id);
+    }
+    work_available.notify_all();
+}
+
+void mgm::ConnectorProber::already_probed(int drm_fd, uint32_t connector_id)
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    probed_elsewhere.emplace(drm_fd, connector_id);
+}
+
+auto mgm::ConnectorProber::fd() const -> int
+{
+    return probed_signal;
+}
+
+void mgm::ConnectorProber::acknowledge()
+{
+    eventfd_t unused;
+    eventfd_read(probed_signal, &unused);
+}
+
+void mgm::ConnectorProber::run()
+{
+    std::unique_lock<decltype(mutex)> lock{mutex};
+
+    while (!stopping)
+    {
+        work_available.wait(lock, [this] { return stopping || !pending.empty(); });
+
+        // Hotplug events tend to arrive in bursts (docks, flaky cables), let the burst settle
+        auto const deadline = std::chrono::steady_clock::now() + max_delay;
+        while (!stopping)
+        {
+            auto const settled = std::min(std::chrono::steady_clock::now() + debounce, deadline);
+            if (work_available.wait_until(lock, settled) == std::cv_status::timeout ||
+                std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+        }
+
+        if (stopping)
+            break;
+
+        decltype(pending) batch;
+        batch.swap(pending);
+
+        for (auto const& connector : probed_elsewhere)
+            probed_connectors[connector.first].insert(connector.second);
+        probed_elsewhere.clear();
+
+        lock.unlock();
+
+        for (auto const& request : batch)
+        {
+            auto const drm_fd = request.first;
+            auto const connector_id = request.second;
+
+            try
+            {
+                if (connector_id == all_connectors)
+                {
+                    mgk::DRMModeResources resources{drm_fd};
+                    for (auto const id : resources.connector_ids())
+                    {
+                        // Only wanted for the side effect of updating the kernel's cached state
+                        mgk::get_connector(drm_fd, id);
+                        probed_connectors[drm_fd].insert(id);
+                    }
+                }
+                else
+                {
+                    mgk::get_connector(drm_fd, connector_id);
+                    probed_connectors[drm_fd].insert(connector_id);
+                }
+            }
+            catch (std::exception const& error)
+            {
+                // The connector may have gone away (such as an MST connector on an unplugged dock);
+                // the main loop's update will pick that up from the cached state
+                mir::log_debug("Failed to probe DRM connector %u: %s", connector_id, error.what());
+            }
+        }
+
+        std::set<int> devices;
+        for (auto const& request : batch)
+            devices.insert(request.first);
+
+        for (auto const drm_fd : devices)
+            probe_new_connectors(drm_fd);
+
+        if (eventfd_write(probed_signal, 1) < 0)
+        {
+            mir::log_error("Failed to signal completion of DRM connector probe: %s", strerror(errno));
+        }
+
+        lock.lock();
+    }
+}
+
+void mgm::ConnectorProber::probe_new_connectors(int drm_fd)
+{
+    // The main loop reads only the cached state, so connectors that the event didn't name (such
+    // as those created when an MST hub is plugged in) need probing here before it sees them
+    try
+    {
+        auto& probed = probed_connectors[drm_fd];
+        mgk::DRMModeResources resources{drm_fd};
+        for (auto const id : resources.connector_ids())
+        {
+            if (probed.insert(id).second)
+                mgk::get_connector(drm_fd, id);
+        }
+    }
+    catch (std::exception const& error)
+    {
+        mir::log_debug("Failed to probe new DRM connectors: %s", error.what());
+    }
+}
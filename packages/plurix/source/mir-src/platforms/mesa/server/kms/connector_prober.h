@@ -0,0 +1,97 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_MESA_CONNECTOR_PROBER_H_
+#define MIR_GRAPHICS_MESA_CONNECTOR_PROBER_H_
+
+#include "mir/fd.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace mir
+{
+namespace graphics
+{
+namespace mesa
+{
+
+/**
+ * Forces the kernel to probe DRM connectors on a worker thread.
+ *
+ * Probing a connector may read its EDID over DDC, which can take tens of milliseconds per
+ * connector, so it must not happen on the main loop. Requests arriving within the debounce
+ * interval of each other are handled as one batch, but a batch is never delayed by more than
+ * max_delay after its first request (so a storm of events can't postpone updates indefinitely).
+ * Connectors that have appeared on the device since the last batch (such as those behind an
+ * MST hub) are probed along with it. Once a batch has been probed fd() becomes readable, and
+ * the kernel's cached connector state (see kms::get_connector_current()) is up to date.
+ */
+class ConnectorProber
+{
+public:
+    static uint32_t constexpr all_connectors = 0;
+
+    ConnectorProber(std::chrono::milliseconds debounce, std::chrono::milliseconds max_delay);
+    ~ConnectorProber();
+
+    /// Queue a probe of one connector, or of all_connectors on the device
+    void probe(int drm_fd, uint32_t connector_id);
+
+    /// Record a connector that has been probed elsewhere (such as at startup), so batches
+    /// don't treat it as new
+    void already_probed(int drm_fd, uint32_t connector_id);
+
+    /// Readable once a batch of probes has completed
+    auto fd() const -> int;
+
+    /// Clears fd(), must be called from fd()'s handler
+    void acknowledge();
+
+private:
+    ConnectorProber(ConnectorProber const&) = delete;
+    ConnectorProber& operator=(ConnectorProber const&) = delete;
+
+    void run();
+    void probe_new_connectors(int drm_fd);
+
+    std::chrono::milliseconds const debounce;
+    std::chrono::milliseconds const max_delay;
+    mir::Fd const probed_signal;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::set<std::pair<int, uint32_t>> pending;
+    std::set<std::pair<int, uint32_t>> probed_elsewhere;
+    bool stopping{false};
+
+    /// Connectors already probed, by DRM fd. Only used by the worker
+    std::map<int, std::set<uint32_t>> probed_connectors;
+
+    std::thread worker;
+};
+
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_MESA_CONNECTOR_PROBER_H_ */
@@ -46,6 +46,8 @@
 #include <stdexcept>
 #include <algorithm>
 #include <unordered_map>
+#include <cstdlib>
+#include <sys/stat.h>
 
 namespace mgm = mir::graphics::mesa;
 namespace mg = mir::graphics;
@@ -175,6 +177,7 @@ mgm::Display::Display(std::vector<std::shared_ptr<helpers::DRMHelper>> const& dr
       vt(vt),
       listener(listener),
       monitor(mir::udev::Context()),
+      connector_prober{std::chrono::milliseconds{50}, std::chrono::milliseconds{250}},
       shared_egl{*gl_config},
       output_container{
           std::make_shared<RealKMSOutputContainer>(
@@ -203,6 +206,13 @@ mgm::Display::Display(std::vector<std::shared_ptr<helpers::DRMHelper>> const& dr
 
     log_drm_details(drm);
 
+    // Enumerating the outputs has probed every connector: the first hotplug batch needn't again
+    output_container->for_each_output(
+        [this](std::shared_ptr<KMSOutput> const& output)
+        {
+            connector_prober.already_probed(output->drm_fd(), output->id());
+        });
+
     initial_conf_policy->apply_to(current_display_configuration);
 
     configure(current_display_configuration);
@@ -261,19 +271,31 @@ void mgm::Display::register_configuration_change_handler(
     EventHandlerRegister& handlers,
     DisplayConfigurationChangeHandler const& conf_change_handler)
 {
+    // Probing connectors is slow, so the udev handler only queues up the connectors to probe
+    // and the configuration is updated (from the kernel's cached state) once they're done
     handlers.register_fd_handler(
         {monitor.fd()},
         this,
         make_module_ptr<std::function<void(int)>>(
-            [conf_change_handler, this](int)
+            [this](int)
             {
-                monitor.process_events([conf_change_handler, this]
-                                       (mir::udev::Monitor::EventType, mir::udev::Device const&)
+                monitor.process_events([this]
+                                       (mir::udev::Monitor::EventType, mir::udev::Device const& device)
                                        {
-                                            dirty_configuration = true;
-                                            conf_change_handler();
+                                            queue_connector_probes(device);
                                        });
             }));
+
+    handlers.register_fd_handler(
+        {connector_prober.fd()},
+        this,
+        make_module_ptr<std::function<void(int)>>(
+            [conf_change_handler, this](int)
+            {
+                connector_prober.acknowledge();
+                dirty_configuration = true;
+                conf_change_handler();
+            }));
 }
 
 void mgm::Display::register_pause_resume_handlers(
@@ -352,6 +374,35 @@ auto mgm::Display::create_hardware_cursor() -> std::shared_ptr<graphics::Cursor>
     return locked_cursor;
 }
 
+void mgm::Display::queue_connector_probes(mir::udev::Device const& device)
+{
+    // Newer kernels name the connector that changed; otherwise we have to probe all of them
+    uint32_t connector_id = ConnectorProber::all_connectors;
+    if (auto const connector = device.property("CONNECTOR"))
+    {
+        connector_id = std::strtoul(connector, nullptr, 10);
+    }
+
+    bool device_found{false};
+    for (auto const& helper : drm)
+    {
+        struct stat info;
+        if (fstat(helper->fd, &info) == 0 && info.st_rdev == device.devnum())
+        {
+            connector_prober.probe(helper->fd, connector_id);
+            device_found = true;
+        }
+    }
+
+    if (!device_found)
+    {
+        for (auto const& helper : drm)
+        {
+            connector_prober.probe(helper->fd, ConnectorProber::all_connectors);
+        }
+    }
+}
+
 void mgm::Display::clear_connected_unused_outputs()
 {
     current_display_configuration.for_each_output([&](DisplayConfigurationOutput const& conf_output)
@@ -559,8 +610,26 @@ void mgm::Display::configure_locked(
             }
         });
 
-    if (!comp)
+    if (comp)
+    {
+        /*
+         * Gamma is just a CRTC property, so it is updated in place: there's no need
+         * to wait for page flips or disturb the display buffers (and hence the compositor).
+         */
+        for (auto const id : outputs_with_changed_gamma(current_display_configuration, kms_conf))
+        {
+            kms_conf.for_each_output(
+                [&](DisplayConfigurationOutput const& conf_output)
+                {
+                    if (conf_output.id == id)
+                        current_display_configuration.get_output_for(id)->set_gamma(conf_output.gamma);
+                });
+        }
+    }
+    else
+    {
         display_buffers = std::move(display_buffers_new);
+    }
 
     /* Store applied configuration */
     current_display_configuration = kms_conf;
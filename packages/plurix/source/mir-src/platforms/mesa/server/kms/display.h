@@ -22,6 +22,7 @@
 #include "mir/graphics/display.h"
 #include "mir/renderer/gl/context_source.h"
 #include "real_kms_output_container.h"
+#include "connector_prober.h"
 #include "real_kms_display_configuration.h"
 #include "display_helpers.h"
 #include "egl_helper.h"
@@ -104,6 +105,7 @@ public:
 
 private:
     void clear_connected_unused_outputs();
+    void queue_connector_probes(mir::udev::Device const& device);
 
     mutable std::mutex configuration_mutex;
     std::vector<std::shared_ptr<helpers::DRMHelper>> const drm;
@@ -111,6 +113,7 @@ private:
     std::shared_ptr<ConsoleServices> const vt;
     std::shared_ptr<DisplayReport> const listener;
     mir::udev::Monitor monitor;
+    ConnectorProber connector_prober;
     helpers::EGLHelper shared_egl;
     std::vector<std::unique_ptr<DisplayBuffer>> display_buffers;
     std::shared_ptr<KMSOutputContainer> const output_container;
@@ -79,7 +79,10 @@ public:
     virtual Frame last_frame() const = 0;
 
     /**
-     * Re-probe the hardware state of this connector.
+     * Re-read the hardware state of this connector.
+     *
+     * This uses the kernel's cached connector state and does not force a probe, so
+     * any probing (see ConnectorProber) needs to have been done beforehand.
      *
      * \throws std::system_error if the underlying DRM connector has disappeared.
      */
@@ -184,9 +184,10 @@ void mgm::RealKMSDisplayConfiguration::update()
 
 // Compatibility means conf1 can be attained from conf2 (and vice versa)
 // without recreating the display buffers (e.g. conf1 and conf2 are identical
-// except one of the outputs of conf1 is rotated w.r.t. that of conf2). If
-// the two outputs differ in their power state, the display buffers would need
-// to be allocated/destroyed, and hence should not be considered compatible.
+// except one of the outputs of conf1 is rotated w.r.t. that of conf2, or has
+// different gamma). If the two outputs differ in their power state, the display
+// buffers would need to be allocated/destroyed, and hence should not be
+// considered compatible.
 bool mgm::compatible(mgm::RealKMSDisplayConfiguration const& conf1, mgm::RealKMSDisplayConfiguration const& conf2)
 {
     bool compatible{
@@ -210,6 +211,7 @@ bool mgm::compatible(mgm::RealKMSDisplayConfiguration const& conf1, mgm::RealKMS
                 clone.scale = conf1.outputs[i].first.scale;
                 clone.form_factor = conf1.outputs[i].first.form_factor;
                 clone.custom_logical_size = conf1.outputs[i].first.custom_logical_size;
+                clone.gamma = conf1.outputs[i].first.gamma;
                 compatible &= (conf1.outputs[i].first == clone);
             }
             else
@@ -219,3 +221,35 @@ bool mgm::compatible(mgm::RealKMSDisplayConfiguration const& conf1, mgm::RealKMS
 
     return compatible;
 }
+
+auto mgm::outputs_with_changed_gamma(
+    mgm::RealKMSDisplayConfiguration const& from,
+    mgm::RealKMSDisplayConfiguration const& to) -> std::vector<DisplayConfigurationOutputId>
+{
+    std::vector<DisplayConfigurationOutputId> changed;
+
+    if (from.outputs.size() != to.outputs.size())
+        return changed;
+
+    for (unsigned int i = 0; i < to.outputs.size(); ++i)
+    {
+        auto const& old_output = from.outputs[i].first;
+        auto const& new_output = to.outputs[i].first;
+
+        // Outputs that aren't lit have no CRTC to set the gamma on; it is applied when they're next set up
+        if (!new_output.connected || !new_output.used || new_output.power_mode != mir_power_mode_on)
+            continue;
+
+        if (new_output.gamma_supported != mir_output_gamma_supported)
+            continue;
+
+        if (old_output.gamma.red != new_output.gamma.red ||
+            old_output.gamma.green != new_output.gamma.green ||
+            old_output.gamma.blue != new_output.gamma.blue)
+        {
+            changed.push_back(new_output.id);
+        }
+    }
+
+    return changed;
+}
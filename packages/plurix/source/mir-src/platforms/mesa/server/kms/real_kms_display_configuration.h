@@ -36,6 +36,8 @@ class KMSOutputContainer;
 class RealKMSDisplayConfiguration : public KMSDisplayConfiguration
 {
 friend bool compatible(RealKMSDisplayConfiguration const& conf1, RealKMSDisplayConfiguration const& conf2);
+friend auto outputs_with_changed_gamma(RealKMSDisplayConfiguration const& from, RealKMSDisplayConfiguration const& to)
+    -> std::vector<DisplayConfigurationOutputId>;
 
 public:
     RealKMSDisplayConfiguration(std::shared_ptr<KMSOutputContainer> const& displays);
@@ -62,6 +64,10 @@ private:
 
 bool compatible(RealKMSDisplayConfiguration const& conf1, RealKMSDisplayConfiguration const& conf2);
 
+/// The lit outputs of compatible configurations whose gamma can be updated in place (without a modeset)
+auto outputs_with_changed_gamma(RealKMSDisplayConfiguration const& from, RealKMSDisplayConfiguration const& to)
+    -> std::vector<DisplayConfigurationOutputId>;
+
 }
 }
 }
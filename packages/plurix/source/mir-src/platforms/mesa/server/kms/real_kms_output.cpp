@@ -400,7 +400,7 @@ void mgm::RealKMSOutput::set_gamma(mg::GammaCurves const& gamma)
 
 void mgm::RealKMSOutput::refresh_hardware_state()
 {
-    connector = kms::get_connector(drm_fd_, connector->connector_id);
+    connector = kms::get_connector_current(drm_fd_, connector->connector_id);
     current_crtc = nullptr;
 
     if (connector->encoder_id)
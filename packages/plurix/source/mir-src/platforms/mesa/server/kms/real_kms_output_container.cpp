@@ -45,18 +45,17 @@ void mgm::RealKMSOutputContainer::update_from_hardware_state()
     {
         kms::DRMModeResources resources{drm_fd};
 
-
-        for (auto &&connector : resources.connectors())
+        for (auto const connector_id : resources.connector_ids())
         {
             // Caution: O(n²) here, but n is the number of outputs, so should
             // conservatively be << 100.
             auto existing_output = std::find_if(
                 outputs.begin(),
                 outputs.end(),
-                [&connector, drm_fd](auto const &candidate)
+                [connector_id, drm_fd](auto const &candidate)
                 {
                     return
-                        connector->connector_id == candidate->id() &&
+                        connector_id == candidate->id() &&
                         drm_fd == candidate->drm_fd();
                 });
 
@@ -71,13 +70,18 @@ void mgm::RealKMSOutputContainer::update_from_hardware_state()
             }
             else
             {
+                // At startup there is no cached state to trust, so force a probe. After that
+                // updates follow a ConnectorProber batch, which has already probed new connectors
                 new_outputs.push_back(std::make_shared<RealKMSOutput>(
                     drm_fd,
-                    std::move(connector),
+                    enumerated ?
+                        kms::get_connector_current(drm_fd, connector_id) :
+                        kms::get_connector(drm_fd, connector_id),
                     construct_page_flipper(drm_fd)));
             }
         }
 
     }
     outputs = new_outputs;
+    enumerated = true;
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_device.h"
+#include "input_recording.h"
+
+#include "mir/input/device_capability.h"
+#include "mir/input/event_builder.h"
+#include "mir/input/input_sink.h"
+#include "mir/input/pointer_settings.h"
+#include "mir/input/touchpad_settings.h"
+#include "mir/input/touchscreen_settings.h"
+
+namespace mi = mir::input;
+namespace mirp = mi::replay;
+namespace mier = mi::evdev::recording;
+
+mirp::InputDevice::InputDevice(InputDeviceInfo const& info) :
+    info(info)
+{
+}
+
+void mirp::InputDevice::start(InputSink* sink, EventBuilder* builder)
+{
+    this->sink = sink;
+    this->builder = builder;
+}
+
+void mirp::InputDevice::stop()
+{
+    sink = nullptr;
+    builder = nullptr;
+}
+
+mi::InputDeviceInfo mirp::InputDevice::get_device_info()
+{
+    return info;
+}
+
+mir::optional_value<mi::PointerSettings> mirp::InputDevice::get_pointer_settings() const
+{
+    optional_value<PointerSettings> ret;
+    if (contains(info.capabilities, DeviceCapability::pointer))
+        ret = PointerSettings();
+
+    return ret;
+}
+
+void mirp::InputDevice::apply_settings(PointerSettings const&)
+{
+    // Acceleration and scroll scaling were applied when the events were recorded
+}
+
+mir::optional_value<mi::TouchpadSettings> mirp::InputDevice::get_touchpad_settings() const
+{
+    optional_value<TouchpadSettings> ret;
+    if (contains(info.capabilities, DeviceCapability::touchpad))
+        ret = TouchpadSettings();
+
+    return ret;
+}
+
+void mirp::InputDevice::apply_settings(TouchpadSettings const&)
+{
+}
+
+mir::optional_value<mi::TouchscreenSettings> mirp::InputDevice::get_touchscreen_settings() const
+{
+    optional_value<TouchscreenSettings> ret;
+    if (contains(info.capabilities, DeviceCapability::touchscreen))
+        ret = TouchscreenSettings();
+
+    return ret;
+}
+
+void mirp::InputDevice::apply_settings(TouchscreenSettings const&)
+{
+}
+
+void mirp::InputDevice::replay(mier::Entry const& entry, std::chrono::nanoseconds event_time)
+{
+    if (!sink)
+        return;
+
+    switch (entry.record)
+    {
+    case mier::Record::key:
+        sink->handle_input(builder->key_event(event_time, entry.key_action, entry.keysym, entry.scan_code));
+        break;
+
+    case mier::Record::pointer:
+        sink->handle_input(builder->pointer_event(
+            event_time, entry.pointer_action, entry.buttons,
+            entry.hscroll, entry.vscroll, entry.relative_x, entry.relative_y));
+        break;
+
+    case mier::Record::absolute_pointer:
+        sink->handle_input(builder->pointer_event(
+            event_time, entry.pointer_action, entry.buttons, entry.x, entry.y,
+            entry.hscroll, entry.vscroll, entry.relative_x, entry.relative_y));
+        break;
+
+    case mier::Record::touch:
+        sink->handle_input(builder->touch_event(event_time, entry.contacts));
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_REPLAY_INPUT_DEVICE_H_
+#define MIR_INPUT_REPLAY_INPUT_DEVICE_H_
+
+#include "mir/input/input_device.h"
+#include "mir/input/input_device_info.h"
+
+#include <chrono>
+
+namespace mir
+{
+namespace input
+{
+namespace evdev
+{
+namespace recording
+{
+struct Entry;
+}
+}
+namespace replay
+{
+/// Stands in for a recorded device, presenting the same name, id and capabilities to the input hub
+class InputDevice : public input::InputDevice
+{
+public:
+    explicit InputDevice(InputDeviceInfo const& info);
+
+    void start(InputSink* sink, EventBuilder* builder) override;
+    void stop() override;
+
+    InputDeviceInfo get_device_info() override;
+
+    optional_value<PointerSettings> get_pointer_settings() const override;
+    void apply_settings(PointerSettings const& settings) override;
+    optional_value<TouchpadSettings> get_touchpad_settings() const override;
+    void apply_settings(TouchpadSettings const& settings) override;
+    optional_value<TouchscreenSettings> get_touchscreen_settings() const override;
+    void apply_settings(TouchscreenSettings const& settings) override;
+
+    /// Builds and sends the event recorded in \a entry, as happening at \a event_time
+    void replay(evdev::recording::Entry const& entry, std::chrono::nanoseconds event_time);
+
+private:
+    InputDeviceInfo const info;
+
+    InputSink* sink{nullptr};
+    EventBuilder* builder{nullptr};
+};
+}
+}
+}
+
+#endif // MIR_INPUT_REPLAY_INPUT_DEVICE_H_
@@ -0,0 +1,231 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "platform.h"
+#include "input_device.h"
+
+#include "mir/dispatch/multiplexing_dispatchable.h"
+#include "mir/dispatch/readable_fd.h"
+#include "mir/input/input_device_registry.h"
+#include "mir/input/input_report.h"
+
+#define MIR_LOG_COMPONENT "replay-input"
+#include "mir/log.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <system_error>
+
+namespace md = mir::dispatch;
+namespace mi = mir::input;
+namespace mirp = mi::replay;
+namespace mier = mi::evdev::recording;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// In fast replay, how many entries to replay before letting the rest of the input stack catch up
+int const fast_batch_size = 64;
+
+mir::Fd make_timer()
+{
+    mir::Fd timer{timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK)};
+    if (timer == mir::Fd::invalid)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to create input replay timer"}));
+    }
+    return timer;
+}
+
+auto now() -> std::chrono::nanoseconds
+{
+    // The same clock as libinput (and so the recording) timestamps events with
+    return std::chrono::steady_clock::now().time_since_epoch();
+}
+}
+
+mirp::Platform::Platform(
+    std::shared_ptr<InputDeviceRegistry> const& registry,
+    std::shared_ptr<InputReport> const& report,
+    std::string const& recording,
+    Timing timing) :
+    registry{registry},
+    report{report},
+    recording{recording},
+    timing{timing},
+    platform_dispatchable{std::make_shared<md::MultiplexingDispatchable>()},
+    timer{make_timer()},
+    timer_dispatchable{std::make_shared<md::ReadableFd>(timer, [this] { replay_due_entries(); })}
+{
+}
+
+mirp::Platform::~Platform() = default;
+
+std::shared_ptr<md::Dispatchable> mirp::Platform::dispatchable()
+{
+    return platform_dispatchable;
+}
+
+void mirp::Platform::start()
+{
+    // Each start replays the recording from the beginning
+    reader = std::make_unique<mier::Reader>(recording);
+    have_next_entry = reader->read(next_entry);
+    time_offset = have_next_entry ? now() - next_entry.time : 0ns;
+
+    platform_dispatchable->add_watch(timer_dispatchable);
+    schedule_next_entry();
+}
+
+void mirp::Platform::stop()
+{
+    platform_dispatchable->remove_watch(timer_dispatchable);
+
+    itimerspec const disarm{};
+    timerfd_settime(timer, 0, &disarm, nullptr);
+
+    for (auto const& device : devices)
+        registry->remove_device(device.second);
+    devices.clear();
+
+    reader.reset();
+    have_next_entry = false;
+}
+
+void mirp::Platform::pause_for_config()
+{
+}
+
+void mirp::Platform::continue_after_config()
+{
+}
+
+void mirp::Platform::replay_due_entries()
+{
+    uint64_t expirations;
+    if (read(timer, &expirations, sizeof expirations) < 0)
+        return;     // Nothing due after all (e.g. re-armed since the wakeup)
+
+    auto const replay_time = now();
+    auto budget = fast_batch_size;
+
+    try
+    {
+        while (have_next_entry)
+        {
+            if (timing == Timing::original)
+            {
+                if (next_entry.time + time_offset > replay_time)
+                    break;
+
+                replay(next_entry, next_entry.time + time_offset);
+            }
+            else
+            {
+                if (budget-- == 0)
+                    break;
+
+                // Keep event times close to the clock they're compared with (e.g. for touch resampling)
+                replay(next_entry, now());
+            }
+
+            have_next_entry = reader->read(next_entry);
+        }
+    }
+    catch (std::exception const& error)
+    {
+        mir::log_error("Abandoning input replay of %s: %s", recording.c_str(), error.what());
+        have_next_entry = false;
+    }
+
+    if (have_next_entry)
+        schedule_next_entry();
+    else
+        mir::log_info("Finished replaying %s", recording.c_str());
+}
+
+void mirp::Platform::replay(mier::Entry const& entry, std::chrono::nanoseconds event_time)
+{
+    switch (entry.record)
+    {
+    case mier::Record::device_added:
+    {
+        auto const device = std::make_shared<InputDevice>(entry.info);
+        auto const previous = devices.find(entry.device);
+        if (previous != devices.end())
+            registry->remove_device(previous->second);
+
+        devices[entry.device] = device;
+        registry->add_device(device);
+        report->opened_input_device(entry.info.name.c_str(), "replay-input");
+        break;
+    }
+
+    case mier::Record::device_removed:
+    {
+        auto const device = devices.find(entry.device);
+        if (device != devices.end())
+        {
+            registry->remove_device(device->second);
+            devices.erase(device);
+        }
+        break;
+    }
+
+    default:
+    {
+        auto const device = devices.find(entry.device);
+        if (device != devices.end())
+            device->second->replay(entry, event_time);
+        break;
+    }
+    }
+}
+
+void mirp::Platform::schedule_next_entry()
+{
+    if (!have_next_entry)
+        return;
+
+    itimerspec when{};
+    int flags{0};
+
+    if (timing == Timing::original)
+    {
+        auto const due = next_entry.time + time_offset;
+        when.it_value.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(due).count();
+        when.it_value.tv_nsec = (due % 1s).count();
+        flags = TFD_TIMER_ABSTIME;
+    }
+    else
+    {
+        // As soon as possible, but after whatever else is waiting to be dispatched
+        when.it_value.tv_nsec = 1;
+    }
+
+    // An absolute time already past fires immediately, so a late entry isn't lost
+    if (when.it_value.tv_sec == 0 && when.it_value.tv_nsec == 0)
+        when.it_value.tv_nsec = 1;
+
+    timerfd_settime(timer, flags, &when, nullptr);
+}
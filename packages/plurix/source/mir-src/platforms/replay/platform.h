@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_REPLAY_PLATFORM_H_
+#define MIR_INPUT_REPLAY_PLATFORM_H_
+
+#include "input_recording.h"
+
+#include "mir/input/platform.h"
+#include "mir/fd.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mir
+{
+namespace dispatch
+{
+class MultiplexingDispatchable;
+class ReadableFd;
+}
+namespace input
+{
+class InputDeviceRegistry;
+class InputReport;
+namespace replay
+{
+class InputDevice;
+
+enum class Timing
+{
+    original,       ///< Each event is replayed as long after the last as it was recorded
+    fast            ///< Events are replayed as fast as the input stack will take them
+};
+
+/// Replays a recording made by the evdev platform, adding and removing devices as they were
+class Platform : public input::Platform
+{
+public:
+    Platform(
+        std::shared_ptr<InputDeviceRegistry> const& registry,
+        std::shared_ptr<InputReport> const& report,
+        std::string const& recording,
+        Timing timing);
+    ~Platform();
+
+    std::shared_ptr<dispatch::Dispatchable> dispatchable() override;
+    void start() override;
+    void stop() override;
+    void pause_for_config() override;
+    void continue_after_config() override;
+
+private:
+    void replay_due_entries();
+    void replay(evdev::recording::Entry const& entry, std::chrono::nanoseconds event_time);
+    void schedule_next_entry();
+
+    std::shared_ptr<InputDeviceRegistry> const registry;
+    std::shared_ptr<InputReport> const report;
+    std::string const recording;
+    Timing const timing;
+
+    std::shared_ptr<dispatch::MultiplexingDispatchable> const platform_dispatchable;
+    Fd const timer;
+    std::shared_ptr<dispatch::ReadableFd> const timer_dispatchable;
+
+    std::unique_ptr<evdev::recording::Reader> reader;
+    evdev::recording::Entry next_entry;
+    bool have_next_entry{false};
+    /// Added to a recorded time to give the time it is replayed at
+    std::chrono::nanoseconds time_offset;
+
+    std::unordered_map<uint32_t, std::shared_ptr<InputDevice>> devices;
+};
+}
+}
+}
+
+#endif // MIR_INPUT_REPLAY_PLATFORM_H_
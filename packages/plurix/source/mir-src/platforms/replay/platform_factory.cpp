@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "platform.h"
+#include "mir/assert_module_entry_point.h"
+#include "mir/libname.h"
+#include "mir/module_properties.h"
+#include "mir/options/option.h"
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace mo = mir::options;
+namespace mi = mir::input;
+namespace mirp = mi::replay;
+
+namespace
+{
+char const* const replay_input_option = "replay-input";
+char const* const replay_timing_option = "replay-input-timing";
+
+mir::ModuleProperties const description = {
+    "mir:replay-input",
+    MIR_VERSION_MAJOR,
+    MIR_VERSION_MINOR,
+    MIR_VERSION_MICRO,
+    mir::libname()
+};
+
+auto timing_from(mo::Option const& options) -> mirp::Timing
+{
+    auto const timing = options.get<std::string>(replay_timing_option);
+
+    if (timing == "original")
+        return mirp::Timing::original;
+    else if (timing == "fast")
+        return mirp::Timing::fast;
+
+    BOOST_THROW_EXCEPTION(std::runtime_error{"Invalid " + std::string{replay_timing_option} + ": " + timing});
+}
+}
+
+mir::UniqueModulePtr<mi::Platform> create_input_platform(
+    mo::Option const& options,
+    std::shared_ptr<mir::EmergencyCleanupRegistry> const& /*emergency_cleanup_registry*/,
+    std::shared_ptr<mi::InputDeviceRegistry> const& input_device_registry,
+    std::shared_ptr<mir::ConsoleServices> const& /*console*/,
+    std::shared_ptr<mi::InputReport> const& report)
+{
+    mir::assert_entry_point_signature<mi::CreatePlatform>(&create_input_platform);
+    return mir::make_module_ptr<mirp::Platform>(
+        input_device_registry,
+        report,
+        options.get<std::string>(replay_input_option),
+        timing_from(options));
+}
+
+void add_input_platform_options(
+    boost::program_options::options_description& config)
+{
+    mir::assert_entry_point_signature<mi::AddPlatformOptions>(&add_input_platform_options);
+    config.add_options()
+        (replay_input_option,
+         boost::program_options::value<std::string>(),
+         "[replay-input specific] Replay input recorded (with --record-input) to this file instead of using real devices")
+        (replay_timing_option,
+         boost::program_options::value<std::string>()->default_value("original"),
+         "[replay-input specific] How to pace replay: \"original\" (as recorded) or \"fast\" (as fast as possible)");
+}
+
+mi::PlatformPriority probe_input_platform(
+    mo::Option const& options,
+    mir::ConsoleServices& /*console*/)
+{
+    mir::assert_entry_point_signature<mi::ProbePlatform>(&probe_input_platform);
+
+    // Only ever wanted when asked for: replay shouldn't stand in for real devices by accident
+    if (options.is_set(replay_input_option) &&
+        std::ifstream{options.get<std::string>(replay_input_option)}.good())
+    {
+        return mi::PlatformPriority::best;
+    }
+
+    return mi::PlatformPriority::unsupported;
+}
+
+mir::ModuleProperties const* describe_input_module()
+{
+    mir::assert_entry_point_signature<mi::DescribeModule>(&describe_input_module);
+    return &description;
+}
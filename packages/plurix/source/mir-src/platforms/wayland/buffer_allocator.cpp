@@ -123,10 +123,6 @@ auto mgw::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release) -> std::shared_ptr<Buffer>
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
-
     return mg::wayland::buffer_from_resource(
         buffer,
         std::move(on_consumed),
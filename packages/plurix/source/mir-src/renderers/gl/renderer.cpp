@@ -23,6 +23,7 @@
 #include "mir/gl/default_program_factory.h"
 #include "mir/graphics/renderable.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/solid_colour_buffer.h"
 #include "mir/graphics/display_buffer.h"
 #include "mir/gl/tessellation_helpers.h"
 #include "mir/gl/texture_cache.h"
@@ -123,6 +124,17 @@ const GLchar* const mrg::Renderer::default_fshader =
     "}\n"
 };
 
+const GLchar* const mrg::Renderer::solid_colour_fshader =
+{   // No texture to sample: the colour is premultiplied and already scaled by the renderable's alpha
+    "#ifdef GL_ES\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "uniform vec4 colour;\n"
+    "void main() {\n"
+    "   gl_FragColor = colour;\n"
+    "}\n"
+};
+
 namespace
 {
 template<void (* deleter)(GLuint)>
@@ -348,6 +360,7 @@ mrg::Renderer::Program::Program(GLuint program_id)
     transform_uniform = glGetUniformLocation(id, "transform");
     screen_to_gl_coords_uniform = glGetUniformLocation(id, "screen_to_gl_coords");
     alpha_uniform = glGetUniformLocation(id, "alpha");
+    colour_uniform = glGetUniformLocation(id, "colour");
 }
 
 mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
@@ -355,6 +368,7 @@ mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
       clear_color{0.0f, 0.0f, 0.0f, 0.0f},
       default_program(family.add_program(vshader, default_fshader)),
       alpha_program(family.add_program(vshader, alpha_fshader)),
+      solid_colour_program(family.add_program(vshader, solid_colour_fshader)),
       program_factory{std::make_unique<ProgramFactory>()},
       texture_cache(mgl::DefaultProgramFactory().create_texture_cache()),
       display_transform(1)
@@ -465,6 +479,15 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
         );
     }
 
+    if (auto const solid = std::dynamic_pointer_cast<mg::SolidColourBuffer>(renderable.buffer()))
+    {
+        draw_solid_colour(renderable, *solid);
+
+        if (clip_area)
+            glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
     auto const texture = std::dynamic_pointer_cast<mg::gl::Texture>(renderable.buffer());
     auto const surface_tex =
         [this, &renderable, need_fallback = !static_cast<bool>(texture)]() -> std::shared_ptr<mir::gl::Texture>
@@ -514,23 +537,7 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
 
     auto const& prog = *maybe_prog;
 
-    glUseProgram(prog.id);
-    if (prog.last_used_frameno != frameno)
-    {   // Avoid reloading the screen-global uniforms on every renderable
-        // TODO: We actually only need to bind these *once*, right? Not once per frame?
-        prog.last_used_frameno = frameno;
-        for (auto i = 0u; i < prog.tex_uniforms.size(); ++i)
-        {
-            if (prog.tex_uniforms[i] != -1)
-            {
-                glUniform1i(prog.tex_uniforms[i], i);
-            }
-        }
-        glUniformMatrix4fv(prog.display_transform_uniform, 1, GL_FALSE,
-                           glm::value_ptr(display_transform));
-        glUniformMatrix4fv(prog.screen_to_gl_coords_uniform, 1, GL_FALSE,
-                           glm::value_ptr(screen_to_gl_coords));
-    }
+    use_program(prog);
 
     glActiveTexture(GL_TEXTURE0);
 
@@ -650,6 +657,76 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
     }
 }
 
+void mrg::Renderer::use_program(Program const& prog) const
+{
+    glUseProgram(prog.id);
+    if (prog.last_used_frameno != frameno)
+    {   // Avoid reloading the screen-global uniforms on every renderable
+        // TODO: We actually only need to bind these *once*, right? Not once per frame?
+        prog.last_used_frameno = frameno;
+        for (auto i = 0u; i < prog.tex_uniforms.size(); ++i)
+        {
+            if (prog.tex_uniforms[i] != -1)
+            {
+                glUniform1i(prog.tex_uniforms[i], i);
+            }
+        }
+        glUniformMatrix4fv(prog.display_transform_uniform, 1, GL_FALSE,
+                           glm::value_ptr(display_transform));
+        glUniformMatrix4fv(prog.screen_to_gl_coords_uniform, 1, GL_FALSE,
+                           glm::value_ptr(screen_to_gl_coords));
+    }
+}
+
+void mrg::Renderer::draw_solid_colour(mg::Renderable const& renderable, mg::SolidColourBuffer const& buffer) const
+{
+    auto const& prog = solid_colour_program;
+
+    use_program(prog);
+
+    auto const& rect = renderable.screen_position();
+    GLfloat centrex = rect.top_left.x.as_int() +
+                      rect.size.width.as_int() / 2.0f;
+    GLfloat centrey = rect.top_left.y.as_int() +
+                      rect.size.height.as_int() / 2.0f;
+    glUniform2f(prog.centre_uniform, centrex, centrey);
+
+    glm::mat4 const transform = renderable.transformation();
+    glUniformMatrix4fv(prog.transform_uniform, 1, GL_FALSE,
+                       glm::value_ptr(transform));
+
+    auto colour = buffer.premultiplied_colour();
+    for (auto& component : colour)
+        component *= renderable.alpha();
+    glUniform4fv(prog.colour_uniform, 1, colour.data());
+
+    if (colour[3] < 1.0f)
+    {
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA,
+                            GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else
+    {
+        glDisable(GL_BLEND);
+    }
+
+    primitives.clear();
+    tessellate(primitives, renderable);
+
+    glEnableVertexAttribArray(prog.position_attr);
+
+    for (auto const& p : primitives)
+    {
+        glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
+                              GL_FALSE, sizeof(mgl::Vertex),
+                              &p.vertices[0].position);
+        glDrawArrays(p.type, 0, p.nvertices);
+    }
+
+    glDisableVertexAttribArray(prog.position_attr);
+}
+
 void mrg::Renderer::set_viewport(geometry::Rectangle const& rect)
 {
     if (rect == viewport)
@@ -36,7 +36,7 @@
 namespace mir
 {
 namespace gl { class TextureCache; }
-namespace graphics { class DisplayBuffer; }
+namespace graphics { class DisplayBuffer; class SolidColourBuffer; }
 namespace renderer
 {
 namespace gl
@@ -85,6 +85,7 @@ public:
         GLint transform_uniform = -1;
         GLint screen_to_gl_coords_uniform = -1;
         GLint alpha_uniform = -1;
+        GLint colour_uniform = -1;
         mutable long long last_used_frameno = 0;
 
         Program(GLuint program_id);
@@ -117,16 +118,19 @@ protected:
     mutable long long frameno = 0;
 
     ProgramFamily family;
-    Program default_program, alpha_program;
+    Program default_program, alpha_program, solid_colour_program;
 
     static const GLchar* const vshader;
     static const GLchar* const default_fshader;
     static const GLchar* const alpha_fshader;
+    static const GLchar* const solid_colour_fshader;
 
     virtual void draw(graphics::Renderable const& renderable) const;
 
 private:
     void update_gl_viewport();
+    void draw_solid_colour(graphics::Renderable const& renderable, graphics::SolidColourBuffer const& buffer) const;
+    void use_program(Program const& prog) const;
 
     class ProgramFactory;
     std::unique_ptr<ProgramFactory> const program_factory;
@@ -30,14 +30,21 @@
 #include "mir/graphics/display_configuration.h"
 #include "mir/input/input_manager.h"
 #include "mir/input/input_dispatcher.h"
+#include "mir/options/option.h"
+#include "mir/options/configuration.h"
+#include "mir/abnormal_exit.h"
 #include "mir/log.h"
 #include "mir/unwind_helpers.h"
 
 #include <boost/exception/diagnostic_information.hpp>
 
 #include <chrono>
+#include <future>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace mc = mir::compositor;
 namespace mf = mir::frontend;
@@ -45,19 +52,121 @@ namespace mg = mir::graphics;
 namespace mi = mir::input;
 namespace msh = mir::shell;
 
+namespace
+{
+/// Times each step of bringing up the server, and logs them all once it is up (--startup-report=log)
+class StartupTimeline
+{
+public:
+    explicit StartupTimeline(bool enabled) :
+        enabled{enabled},
+        origin{std::chrono::steady_clock::now()},
+        main_thread{std::this_thread::get_id()}
+    {
+    }
+
+    /// Runs \a step (on the calling thread), recording how long it took
+    template<typename Step>
+    auto time(char const* component, Step const& step) -> decltype(step())
+    {
+        Timer const timer{*this, component};
+        return step();
+    }
+
+    void report() const
+    {
+        if (!enabled)
+            return;
+
+        using ms = std::chrono::duration<double, std::milli>;
+        std::lock_guard<decltype(mutex)> lock{mutex};
+
+        mir::log_info("Startup timeline (ms since the server began construction):");
+        for (auto const& entry : entries)
+        {
+            mir::log_info(
+                "  %8.1f .. %8.1f  %s%s",
+                ms{entry.begin - origin}.count(),
+                ms{entry.end - origin}.count(),
+                entry.component.c_str(),
+                entry.parallel ? " (in parallel)" : "");
+        }
+        mir::log_info("Server started after %.1f ms", ms{std::chrono::steady_clock::now() - origin}.count());
+    }
+
+private:
+    struct Entry
+    {
+        std::string component;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+        bool parallel;
+    };
+
+    struct Timer
+    {
+        Timer(StartupTimeline& timeline, char const* component) :
+            timeline{timeline},
+            component{component},
+            begin{std::chrono::steady_clock::now()}
+        {
+        }
+
+        ~Timer()
+        {
+            if (!timeline.enabled)
+                return;
+
+            std::lock_guard<decltype(timeline.mutex)> lock{timeline.mutex};
+            timeline.entries.push_back(
+                {component, begin, std::chrono::steady_clock::now(), std::this_thread::get_id() != timeline.main_thread});
+        }
+
+        StartupTimeline& timeline;
+        char const* const component;
+        std::chrono::steady_clock::time_point const begin;
+    };
+
+    bool const enabled;
+    std::chrono::steady_clock::time_point const origin;
+    std::thread::id const main_thread;
+
+    std::mutex mutable mutex;
+    std::vector<Entry> entries;
+};
+
+bool startup_report_enabled(mir::ServerConfiguration& config)
+{
+    auto const report = config.the_options()->get<std::string>(mir::options::startup_report_opt);
+
+    if (report == "log")
+        return true;
+    else if (report == "off")
+        return false;
+
+    throw mir::AbnormalExit("Invalid report option: " + report + " (valid options are: \"off\" and \"log\")");
+}
+}
+
 struct mir::DisplayServer::Private
 {
+    /*
+     * Construction stays on this thread: the server configuration's the_*() accessors aren't
+     * threadsafe, and the components share too much of the object graph to build apart.
+     * What happens concurrently is starting them (see DisplayServer::run()).
+     */
     Private(ServerConfiguration& config)
-        : emergency_cleanup{config.the_emergency_cleanup()},
-          graphics_platform{config.the_graphics_platform()},
-          display{config.the_display()},
-          input_dispatcher{config.the_input_dispatcher()},
-          compositor{config.the_compositor()},
-          connector{config.the_connector()},
-          wayland_connector{config.the_wayland_connector()},
-          xwayland_connector{config.the_xwayland_connector()},
-          prompt_connector{config.the_prompt_connector()},
-          input_manager{config.the_input_manager()},
+        : timeline{startup_report_enabled(config)},
+          emergency_cleanup{config.the_emergency_cleanup()},
+          graphics_platform{timeline.time("graphics platform", [&] { return config.the_graphics_platform(); })},
+          display{timeline.time("display", [&] { return config.the_display(); })},
+          input_dispatcher{timeline.time("input dispatcher", [&] { return config.the_input_dispatcher(); })},
+          compositor{timeline.time("compositor", [&] { return config.the_compositor(); })},
+          connector{timeline.time("connector", [&] { return config.the_connector(); })},
+          wayland_connector{timeline.time("wayland connector", [&] { return config.the_wayland_connector(); })},
+          xwayland_connector{timeline.time("xwayland connector", [&] { return config.the_xwayland_connector(); })},
+          prompt_connector{timeline.time("prompt connector", [&] { return config.the_prompt_connector(); })},
+          input_manager{timeline.time("input manager", [&] { return config.the_input_manager(); })},
           main_loop{config.the_main_loop()},
           server_status_listener{config.the_server_status_listener()},
           display_changer{config.the_display_changer()},
@@ -186,6 +295,7 @@ struct mir::DisplayServer::Private
         display_changer->configure_for_hardware_change(conf);
     }
 
+    StartupTimeline timeline;
     std::shared_ptr<EmergencyCleanup> const emergency_cleanup; // Hold this so it does not get freed prematurely
     std::shared_ptr<mg::Platform> const graphics_platform; // Hold this so the platform is loaded once
     std::shared_ptr<mg::Display> const display;
@@ -222,16 +332,26 @@ void mir::DisplayServer::run()
 {
     mir::log_info("Mir version " MIR_VERSION);
 
-    auto const& server = *p.load();
+    auto& server = *p.load();
+
+    // Starting input (opening and enumerating devices, compiling keymaps) doesn't depend on
+    // the compositor or the frontends, and is often the slowest part: let it run alongside them.
+    // Clients can connect meanwhile; they just won't see input devices until these are added.
+    auto input_started = std::async(std::launch::async, [&server]
+        {
+            server.timeline.time("input manager start", [&] { server.input_manager->start(); });
+        });
+
+    server.timeline.time("compositor start", [&] { server.compositor->start(); });
+    server.timeline.time("input dispatcher start", [&] { server.input_dispatcher->start(); });
+    server.timeline.time("prompt connector start", [&] { server.prompt_connector->start(); });
+    server.timeline.time("connector start", [&] { server.connector->start(); });
+    server.timeline.time("wayland connector start", [&] { server.wayland_connector->start(); });
+    server.timeline.time("xwayland connector start", [&] { server.xwayland_connector->start(); });
 
-    server.compositor->start();
-    server.input_manager->start();
-    server.input_dispatcher->start();
-    server.prompt_connector->start();
-    server.connector->start();
-    server.wayland_connector->start();
-    server.xwayland_connector->start();
+    input_started.get();
 
+    server.timeline.report();
     server.server_status_listener->started();
 
     server.main_loop->run();
@@ -0,0 +1,178 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer_submission_ring.h"
+#include "protobuf_buffer_packer.h"
+
+#include "mir/anonymous_shm_file.h"
+#include "mir/buffer_submission_ring.h"
+
+#include "mir/dispatch/multiplexing_dispatchable.h"
+#include "mir/dispatch/readable_fd.h"
+#include "mir/dispatch/threaded_dispatcher.h"
+#include "mir/graphics/buffer.h"
+#include "mir/graphics/platform_ipc_operations.h"
+#include "mir/log.h"
+
+#include "mir_protobuf.pb.h"
+
+#include <boost/throw_exception.hpp>
+#include <mutex>
+#include <system_error>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace md = mir::dispatch;
+namespace mfd = mir::frontend::detail;
+namespace ring = mir::buffer_submission_ring;
+
+namespace
+{
+/// All rings are serviced by a single thread: the work per doorbell is tiny
+md::MultiplexingDispatchable& ring_dispatcher()
+{
+    static auto const multiplexer = std::make_shared<md::MultiplexingDispatchable>();
+    static md::ThreadedDispatcher const thread{"Mir/BufferRing", multiplexer};
+
+    return *multiplexer;
+}
+
+mir::Fd make_doorbell()
+{
+    mir::Fd doorbell{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+    if (doorbell == mir::Fd::invalid)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{
+            errno,
+            std::system_category(),
+            "Failed to create buffer submission doorbell"}));
+    }
+    return doorbell;
+}
+}
+
+/// Everything the ring thread uses. The watch shares it, so a dispatch that was already under way when
+/// the ring is destroyed still has somewhere to run, and then finds nothing to submit to.
+struct mf::BufferSubmissionRing::Submissions
+{
+    Submissions(std::function<void(mg::BufferID)> const& submit) :
+        submit{submit},
+        shm{sizeof(ring::Layout)},
+        layout{*static_cast<ring::Layout*>(shm.base_ptr())},
+        doorbell{make_doorbell()}
+    {
+        ring::initialise(layout);
+    }
+
+    void process()
+    {
+        ring::acknowledge(doorbell);
+
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        drain();
+    }
+
+    /// Requires mutex
+    void drain()
+    {
+        ring::drain(layout.submissions, [this](int32_t buffer_id)
+            {
+                if (!submit)
+                    return;
+
+                try
+                {
+                    submit(mg::BufferID{static_cast<uint32_t>(buffer_id)});
+                }
+                catch (std::exception const& error)
+                {
+                    // The client has broken the protocol (e.g. an unknown buffer id), but it's only hurting itself
+                    mir::log_warning("Discarding buffer submission: %s", error.what());
+                }
+            });
+    }
+
+    /// Held while submitting, so the stream's submissions are made one at a time and in order
+    std::mutex mutex;
+    /// Cleared, under mutex, when the ring is destroyed
+    std::function<void(mg::BufferID)> submit;
+
+    mir::AnonymousShmFile shm;
+    ring::Layout& layout;
+    mir::Fd const doorbell;
+};
+
+mf::BufferSubmissionRing::BufferSubmissionRing(
+    std::shared_ptr<mg::PlatformIpcOperations> const& ipc_operations,
+    std::function<void(mg::BufferID)> const& submit) :
+    ipc_operations{ipc_operations},
+    submissions{std::make_shared<Submissions>(submit)},
+    release_doorbell{make_doorbell()},
+    watch{std::make_shared<md::ReadableFd>(
+        submissions->doorbell,
+        [submissions = submissions] { submissions->process(); })}
+{
+    ring_dispatcher().add_watch(watch);
+}
+
+mf::BufferSubmissionRing::~BufferSubmissionRing()
+{
+    ring_dispatcher().remove_watch(watch);
+
+    // remove_watch() doesn't wait for a dispatch that has already started: wait for it here, and
+    // leave nothing for one that starts later to call
+    std::lock_guard<decltype(submissions->mutex)> lock{submissions->mutex};
+    submissions->submit = nullptr;
+}
+
+auto mf::BufferSubmissionRing::client_fds() const -> std::vector<Fd>
+{
+    return {Fd{IntOwnedFd{submissions->shm.fd()}}, submissions->doorbell, release_doorbell};
+}
+
+bool mf::BufferSubmissionRing::release(mg::Buffer& buffer)
+{
+    // Platforms that need to send data (e.g. fences) with the release still use the socket
+    if (release_payload == ReleasePayload::unknown)
+    {
+        mir::protobuf::Buffer update;
+        mfd::ProtobufBufferPacker packer{&update};
+        ipc_operations->pack_buffer(packer, buffer, mg::BufferIpcMsgType::update_msg);
+
+        release_payload = (update.fd_size() != 0 || update.data_size() != 0) ?
+            ReleasePayload::some : ReleasePayload::none;
+    }
+
+    if (release_payload == ReleasePayload::some)
+        return false;
+
+    std::lock_guard<decltype(release_mutex)> lock{release_mutex};
+
+    if (!ring::push(submissions->layout.releases, buffer.id().as_value()))
+        return false;
+
+    if (ring::needs_doorbell(submissions->layout.releases))
+        ring::ring(release_doorbell);
+
+    return true;
+}
+
+void mf::BufferSubmissionRing::submit_after_queued(std::function<void()> const& submission)
+{
+    std::lock_guard<decltype(submissions->mutex)> lock{submissions->mutex};
+    submissions->drain();
+    submission();
+}
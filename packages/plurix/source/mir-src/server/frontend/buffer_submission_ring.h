@@ -0,0 +1,82 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_BUFFER_SUBMISSION_RING_H_
+#define MIR_FRONTEND_BUFFER_SUBMISSION_RING_H_
+
+#include "mir/fd.h"
+#include "mir/graphics/buffer_id.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mir
+{
+namespace dispatch
+{
+class ReadableFd;
+}
+namespace graphics
+{
+class Buffer;
+class PlatformIpcOperations;
+}
+namespace frontend
+{
+/// The server end of a mir::buffer_submission_ring for one buffer stream.
+class BufferSubmissionRing
+{
+public:
+    /// \param submit   called, on the ring dispatch thread, for each buffer the client submits
+    BufferSubmissionRing(
+        std::shared_ptr<graphics::PlatformIpcOperations> const& ipc_operations,
+        std::function<void(graphics::BufferID)> const& submit);
+    ~BufferSubmissionRing();
+
+    /// The fds to send to the client: the shared memory, the submission doorbell and the release doorbell
+    auto client_fds() const -> std::vector<Fd>;
+
+    /// Run a submission that came some other way (over the socket) after everything already in the ring,
+    /// so that the stream's buffers are submitted in the order the client sent them
+    void submit_after_queued(std::function<void()> const& submission);
+
+    /// Tell the client it can reuse buffer
+    /// \returns false if the release needs to go over the socket (the ring is full, or
+    ///          the platform needs to send more than the buffer id)
+    bool release(graphics::Buffer& buffer);
+
+private:
+    struct Submissions;
+
+    std::shared_ptr<graphics::PlatformIpcOperations> const ipc_operations;
+    std::shared_ptr<Submissions> const submissions;
+    Fd const release_doorbell;
+    std::shared_ptr<dispatch::ReadableFd> const watch;
+
+    std::mutex release_mutex;   ///< There must only be one producer of releases
+
+    enum class ReleasePayload { unknown, none, some };
+    /// Whether the platform sends fds or data with a release: the same for every buffer of the stream,
+    /// so only the first release is packed to find out
+    std::atomic<ReleasePayload> release_payload{ReleasePayload::unknown};
+};
+}
+}
+
+#endif /* MIR_FRONTEND_BUFFER_SUBMISSION_RING_H_ */
@@ -0,0 +1,76 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config_event_encoder.h"
+#include "protobuf_buffer_packer.h"
+
+#include "mir/graphics/display_configuration.h"
+#include "mir/input/mir_input_config_serialization.h"
+
+#include "mir_protobuf_wire.pb.h"
+#include "mir_protobuf.pb.h"
+
+namespace mfd = mir::frontend::detail;
+namespace mg = mir::graphics;
+namespace mp = mir::protobuf;
+namespace mi = mir::input;
+
+namespace
+{
+auto wire_encode(mp::EventSequence const& seq) -> mfd::ConfigEventEncoder::Encoded
+{
+    mp::wire::Result result;
+    result.add_events(seq.SerializeAsString());
+
+    return std::make_shared<std::string const>(result.SerializeAsString());
+}
+}
+
+mfd::ConfigEventEncoder::ConfigEventEncoder() = default;
+mfd::ConfigEventEncoder::~ConfigEventEncoder() = default;
+
+auto mfd::ConfigEventEncoder::encode(mg::DisplayConfiguration const& config) -> Encoded
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    // Comparing is far cheaper than packing and serializing the outputs again
+    if (!encoded_display_config || !packs_the_same(*display_config, config))
+    {
+        mp::EventSequence seq;
+        pack_protobuf_display_configuration(*seq.mutable_display_configuration(), config);
+
+        encoded_display_config = wire_encode(seq);
+        display_config = config.clone();
+    }
+
+    return encoded_display_config;
+}
+
+auto mfd::ConfigEventEncoder::encode(MirInputConfig const& config) -> Encoded
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (!encoded_input_config || !(input_config == config))
+    {
+        mp::EventSequence seq;
+        seq.set_input_configuration(mi::serialize_input_config(config));
+
+        encoded_input_config = wire_encode(seq);
+        input_config = config;
+    }
+
+    return encoded_input_config;
+}
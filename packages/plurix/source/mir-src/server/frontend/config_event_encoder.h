@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_CONFIG_EVENT_ENCODER_H_
+#define MIR_FRONTEND_CONFIG_EVENT_ENCODER_H_
+
+#include "mir/input/mir_input_config.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mir
+{
+namespace graphics { class DisplayConfiguration; }
+namespace frontend
+{
+namespace detail
+{
+/// Encodes configuration events ready to be written to a client socket.
+///
+/// Configuration changes are broadcast to every connected client with the same content. Rather
+/// than each client's EventSender serializing it again, the first does so and the rest share the
+/// encoded message (until the configuration next changes).
+class ConfigEventEncoder
+{
+public:
+    ConfigEventEncoder();
+    ~ConfigEventEncoder();
+
+    using Encoded = std::shared_ptr<std::string const>;
+
+    auto encode(graphics::DisplayConfiguration const& config) -> Encoded;
+    auto encode(MirInputConfig const& config) -> Encoded;
+
+private:
+    std::mutex mutex;
+
+    std::unique_ptr<graphics::DisplayConfiguration> display_config;
+    Encoded encoded_display_config;
+
+    MirInputConfig input_config;
+    Encoded encoded_input_config;
+};
+}
+}
+}
+
+#endif /* MIR_FRONTEND_CONFIG_EVENT_ENCODER_H_ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cookie_minting_event_sink.h"
+
+#include "mir/cookie/authority.h"
+#include "mir/events/event.h"
+#include "mir_toolkit/events/input/input_event.h"
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+
+mf::CookieMintingEventSink::CookieMintingEventSink(
+    std::unique_ptr<EventSink> wrapped,
+    std::shared_ptr<cookie::Authority> const& cookie_authority) :
+    wrapped{std::move(wrapped)},
+    cookie_authority{cookie_authority}
+{
+}
+
+void mf::CookieMintingEventSink::handle_event(EventUPtr&& event)
+{
+    if (event->type() == mir_event_type_input)
+    {
+        auto const input_event = event->to_input();
+
+        if (mir_input_event_has_cookie(input_event) && input_event->cookie().empty())
+        {
+            auto const cookie = cookie_authority->make_cookie(input_event->event_time().count());
+            input_event->set_cookie(cookie->serialize());
+        }
+    }
+
+    wrapped->handle_event(std::move(event));
+}
+
+void mf::CookieMintingEventSink::handle_lifecycle_event(MirLifecycleState state)
+{
+    wrapped->handle_lifecycle_event(state);
+}
+
+void mf::CookieMintingEventSink::handle_display_config_change(mg::DisplayConfiguration const& config)
+{
+    wrapped->handle_display_config_change(config);
+}
+
+void mf::CookieMintingEventSink::handle_error(ClientVisibleError const& error)
+{
+    wrapped->handle_error(error);
+}
+
+void mf::CookieMintingEventSink::handle_input_config_change(MirInputConfig const& config)
+{
+    wrapped->handle_input_config_change(config);
+}
+
+void mf::CookieMintingEventSink::send_ping(int32_t serial)
+{
+    wrapped->send_ping(serial);
+}
+
+void mf::CookieMintingEventSink::send_buffer(BufferStreamId id, mg::Buffer& buffer, mg::BufferIpcMsgType type)
+{
+    wrapped->send_buffer(id, buffer, type);
+}
+
+void mf::CookieMintingEventSink::add_buffer(mg::Buffer& buffer)
+{
+    wrapped->add_buffer(buffer);
+}
+
+void mf::CookieMintingEventSink::error_buffer(geometry::Size size, MirPixelFormat format, std::string const& error)
+{
+    wrapped->error_buffer(size, format, error);
+}
+
+void mf::CookieMintingEventSink::update_buffer(mg::Buffer& buffer)
+{
+    wrapped->update_buffer(buffer);
+}
+
+mf::CookieMintingEventSinkFactory::CookieMintingEventSinkFactory(
+    std::shared_ptr<EventSinkFactory> const& wrapped,
+    std::shared_ptr<cookie::Authority> const& cookie_authority) :
+    wrapped{wrapped},
+    cookie_authority{cookie_authority}
+{
+}
+
+auto mf::CookieMintingEventSinkFactory::create_sink(std::shared_ptr<MessageSender> const& sender)
+    -> std::unique_ptr<EventSink>
+{
+    return std::make_unique<CookieMintingEventSink>(wrapped->create_sink(sender), cookie_authority);
+}
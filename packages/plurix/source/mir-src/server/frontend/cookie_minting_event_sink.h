@@ -0,0 +1,81 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_COOKIE_MINTING_EVENT_SINK_H_
+#define MIR_FRONTEND_COOKIE_MINTING_EVENT_SINK_H_
+
+#include "mir/frontend/event_sink.h"
+#include "event_sink_factory.h"
+
+#include <memory>
+
+namespace mir
+{
+namespace cookie
+{
+class Authority;
+}
+namespace frontend
+{
+
+/**
+ * Adaptor that signs input events as they are sent to a client.
+ *
+ * Input events are built without cookies (minting one is an HMAC per event). The cookie
+ * is a function of the event timestamp alone, so it is computed here only for the events
+ * that carry one (see mir_input_event_has_cookie()) and only when they leave the server.
+ */
+class CookieMintingEventSink : public EventSink
+{
+public:
+    CookieMintingEventSink(
+        std::unique_ptr<EventSink> wrapped,
+        std::shared_ptr<cookie::Authority> const& cookie_authority);
+
+    void handle_event(EventUPtr&& event) override;
+    void handle_lifecycle_event(MirLifecycleState state) override;
+    void handle_display_config_change(graphics::DisplayConfiguration const& config) override;
+    void handle_error(ClientVisibleError const& error) override;
+    void handle_input_config_change(MirInputConfig const& config) override;
+    void send_ping(int32_t serial) override;
+    void send_buffer(BufferStreamId id, graphics::Buffer& buffer, graphics::BufferIpcMsgType type) override;
+    void add_buffer(graphics::Buffer& buffer) override;
+    void error_buffer(geometry::Size size, MirPixelFormat format, std::string const& error) override;
+    void update_buffer(graphics::Buffer& buffer) override;
+
+private:
+    std::unique_ptr<EventSink> const wrapped;
+    std::shared_ptr<cookie::Authority> const cookie_authority;
+};
+
+/// Wraps every sink created by another factory in a CookieMintingEventSink
+class CookieMintingEventSinkFactory : public EventSinkFactory
+{
+public:
+    CookieMintingEventSinkFactory(
+        std::shared_ptr<EventSinkFactory> const& wrapped,
+        std::shared_ptr<cookie::Authority> const& cookie_authority);
+
+    std::unique_ptr<EventSink> create_sink(std::shared_ptr<MessageSender> const& sender) override;
+
+private:
+    std::shared_ptr<EventSinkFactory> const wrapped;
+    std::shared_ptr<cookie::Authority> const cookie_authority;
+};
+}
+}
+
+#endif /* MIR_FRONTEND_COOKIE_MINTING_EVENT_SINK_H_ */
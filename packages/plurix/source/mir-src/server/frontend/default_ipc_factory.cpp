@@ -24,6 +24,7 @@
 #include "authorizing_input_config_changer.h"
 #include "unauthorized_screencast.h"
 #include "resource_cache.h"
+#include "cookie_minting_event_sink.h"
 #include "mir/frontend/session_authorizer.h"
 #include "mir/frontend/event_sink.h"
 #include "event_sink_factory.h"
@@ -295,7 +296,7 @@ std::shared_ptr<mf::detail::DisplayServer> mf::DefaultIpcFactory::make_ipc_serve
         changer,
         buffer_allocator,
         sm_observer,
-        sink_factory,
+        std::make_shared<CookieMintingEventSinkFactory>(sink_factory, cookie_authority),
         message_sender,
         effective_screencast,
         connection_context,
@@ -31,6 +31,12 @@ class DisplayServer : public mir::protobuf::DisplayServer
 {
 public:
     virtual void client_pid(int pid) = 0;
+
+    /// Set up a mir::buffer_submission_ring for the stream. The response holds the ring's fds.
+    virtual void create_submission_ring(
+        mir::protobuf::BufferStreamId const* request,
+        mir::protobuf::SocketFD* response,
+        google::protobuf::Closure* done) = 0;
 };
 }
 }
@@ -17,13 +17,13 @@
  */
 
 #include "event_sender.h"
+#include "config_event_encoder.h"
 #include "mir/events/event.h"
 #include "mir/frontend/client_constants.h"
 #include "mir/graphics/display_configuration.h"
 #include "mir/variable_length_array.h"
 #include "mir/input/device.h"
 #include "mir/input/mir_input_config.h"
-#include "mir/input/mir_input_config_serialization.h"
 #include "mir/input/mir_pointer_config.h"
 #include "mir/input/mir_touchpad_config.h"
 #include "mir/input/mir_keyboard_config.h"
@@ -40,13 +40,14 @@ namespace mg = mir::graphics;
 namespace mfd = mir::frontend::detail;
 namespace mev = mir::events;
 namespace mp = mir::protobuf;
-namespace mi = mir::input;
 
 mfd::EventSender::EventSender(
     std::shared_ptr<MessageSender> const& socket_sender,
-    std::shared_ptr<mg::PlatformIpcOperations> const& buffer_packer) :
+    std::shared_ptr<mg::PlatformIpcOperations> const& buffer_packer,
+    std::shared_ptr<ConfigEventEncoder> const& config_encoder) :
     sender(socket_sender),
-    buffer_packer(buffer_packer)
+    buffer_packer(buffer_packer),
+    config_encoder(config_encoder)
 {
 }
 
@@ -64,12 +65,7 @@ void mfd::EventSender::handle_event(EventUPtr&& event)
 void mfd::EventSender::handle_display_config_change(
     graphics::DisplayConfiguration const& display_config)
 {
-    mp::EventSequence seq;
-
-    auto protobuf_config = seq.mutable_display_configuration();
-    mfd::pack_protobuf_display_configuration(*protobuf_config, display_config);
-
-    send_event_sequence(seq, {});
+    send_encoded(*config_encoder->encode(display_config));
 }
 
 void mfd::EventSender::handle_lifecycle_event(
@@ -95,10 +91,7 @@ void mfd::EventSender::send_ping(int32_t serial)
 
 void mfd::EventSender::handle_input_config_change(MirInputConfig const& config)
 {
-    mp::EventSequence seq;
-
-    seq.set_input_configuration(mi::serialize_input_config(config));
-    send_event_sequence(seq, {});
+    send_encoded(*config_encoder->encode(config));
 }
 
 void mfd::EventSender::send_event_sequence(mp::EventSequence& seq, FdSets const& fds)
@@ -132,6 +125,19 @@ void mfd::EventSender::send_event_sequence(mp::EventSequence& seq, FdSets const&
     }
 }
 
+void mfd::EventSender::send_encoded(std::string const& encoded)
+{
+    try
+    {
+        sender->send(encoded.data(), encoded.size(), {});
+    }
+    catch (std::exception const& error)
+    {
+        // TODO: We should report this state.
+        (void) error;
+    }
+}
+
 void mfd::EventSender::add_buffer(graphics::Buffer& buffer)
 {
     mp::EventSequence seq;
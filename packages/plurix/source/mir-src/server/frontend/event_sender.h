@@ -36,13 +36,15 @@ class MessageSender;
 
 namespace detail
 {
+class ConfigEventEncoder;
 
 class EventSender : public  mir::frontend::EventSink
 {
 public:
     explicit EventSender(
         std::shared_ptr<MessageSender> const& socket_sender,
-        std::shared_ptr<graphics::PlatformIpcOperations> const& buffer_packer);
+        std::shared_ptr<graphics::PlatformIpcOperations> const& buffer_packer,
+        std::shared_ptr<ConfigEventEncoder> const& config_encoder);
     void handle_event(EventUPtr&& event) override;
     void handle_lifecycle_event(MirLifecycleState state) override;
     void handle_display_config_change(graphics::DisplayConfiguration const& config) override;
@@ -57,9 +59,11 @@ public:
 private:
     void send_event_sequence(protobuf::EventSequence&, FdSets const&);
     void send_buffer(protobuf::EventSequence&, graphics::Buffer&, graphics::BufferIpcMsgType);
+    void send_encoded(std::string const& encoded);
 
     std::shared_ptr<MessageSender> const sender;
     std::shared_ptr<graphics::PlatformIpcOperations> const buffer_packer;
+    std::shared_ptr<ConfigEventEncoder> const config_encoder;
 };
 
 }
@@ -0,0 +1,207 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "in_process_messenger.h"
+#include "mir/frontend/client_constants.h"
+#include "mir/in_process_channel.h"
+#include "mir/variable_length_array.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace mfd = mf::detail;
+namespace bs = boost::system;
+namespace ba = boost::asio;
+
+mfd::InProcessMessenger::InProcessMessenger(
+    std::shared_ptr<ba::local::stream_protocol::socket> const& socket,
+    std::shared_ptr<InProcessChannel> const& channel)
+    : SocketMessenger{socket},
+      socket{socket},
+      channel{channel}
+{
+}
+
+mfd::InProcessMessenger::~InProcessMessenger()
+{
+    channel->to_server.set_notifier({});
+    channel->to_client.close();
+    InProcessChannel::withdraw(channel.get());
+}
+
+void mfd::InProcessMessenger::send(char const* data, size_t length, FdSets const& fd_sets)
+{
+    if (!channel->claimed())
+    {
+        SocketMessenger::send(data, length, fd_sets);
+        return;
+    }
+
+    // The same stream the client would read from the socket: a size header, then the message,
+    // then a byte for each set of fds (the fds themselves travel alongside)
+    static size_t const header_size{2};
+    size_t fd_set_count{0};
+    std::vector<Fd> fds;
+    for (auto const& fd_set : fd_sets)
+    {
+        fds.insert(fds.end(), fd_set.begin(), fd_set.end());
+        ++fd_set_count;
+    }
+
+    mir::VariableLengthArray<mf::serialization_buffer_size> whole_message{header_size + length + fd_set_count};
+
+    whole_message.data()[0] = static_cast<unsigned char>((length >> 8) & 0xff);
+    whole_message.data()[1] = static_cast<unsigned char>((length >> 0) & 0xff);
+    std::copy(data, data + length, whole_message.data() + header_size);
+    std::fill_n(whole_message.data() + header_size + length, fd_set_count, 'M');
+
+    channel->to_client.write(whole_message.data(), whole_message.size(), fds);
+}
+
+void mfd::InProcessMessenger::async_receive_msg(MirReadHandler const& handler, ba::mutable_buffers_1 const& buffer)
+{
+    if (!channel->claimed())
+    {
+        // The client either reads the socket, or shuts it down when it claims the channel. In the
+        // latter case the read fails, and is then made from the channel instead.
+        std::weak_ptr<InProcessMessenger> const weak_self{shared_from_this()};
+        SocketMessenger::async_receive_msg(
+            [weak_self, handler, buffer](bs::error_code const& error, size_t size)
+            {
+                auto const self = weak_self.lock();
+                if (error && self && self->channel->claimed())
+                    self->async_receive_msg(handler, buffer);
+                else
+                    handler(error, size);
+            },
+            buffer);
+        return;
+    }
+
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        pending_handler = handler;
+        pending_buffer = buffer;
+
+        if (!listening)
+        {
+            // The client writes on its own thread: requests are handled on the server's IPC thread,
+            // as they would be from the socket
+            std::weak_ptr<InProcessMessenger> const weak_self{shared_from_this()};
+            channel->to_server.set_notifier(
+                [weak_self, socket = socket]
+                {
+                    socket->get_io_service().post(
+                        [weak_self]
+                        {
+                            if (auto const self = weak_self.lock())
+                                self->deliver();
+                        });
+                });
+            listening = true;
+        }
+    }
+
+    deliver();
+}
+
+void mfd::InProcessMessenger::deliver()
+{
+    // Completing the read may drop the connection's last reference to us
+    auto const keep_alive = shared_from_this();
+
+    std::unique_lock<decltype(mutex)> lock{mutex};
+
+    // Whoever is already delivering will pick up anything that has just arrived
+    if (delivering)
+        return;
+
+    delivering = true;
+
+    while (pending_handler &&
+           (channel->to_server.available() >= ba::buffer_size(pending_buffer) || channel->to_server.closed()))
+    {
+        auto const handler = std::move(pending_handler);
+        auto const buffer = pending_buffer;
+        pending_handler = nullptr;
+        lock.unlock();
+
+        auto const size = ba::buffer_size(buffer);
+        bs::error_code error;
+        if (!channel->to_server.read(ba::buffer_cast<void*>(buffer), size))
+            error = ba::error::eof;
+
+        try
+        {
+            handler(error, size);
+        }
+        catch (...)
+        {
+            // Propagate to the IPC thread, as the socket's read handler would
+            lock.lock();
+            delivering = false;
+            throw;
+        }
+
+        lock.lock();
+    }
+
+    delivering = false;
+}
+
+bs::error_code mfd::InProcessMessenger::receive_msg(ba::mutable_buffers_1 const& buffer)
+{
+    if (!channel->claimed())
+        return SocketMessenger::receive_msg(buffer);
+
+    if (!channel->to_server.read(ba::buffer_cast<void*>(buffer), ba::buffer_size(buffer)))
+        return ba::error::eof;
+
+    return {};
+}
+
+size_t mfd::InProcessMessenger::available_bytes()
+{
+    if (!channel->claimed())
+        return SocketMessenger::available_bytes();
+
+    return channel->to_server.available();
+}
+
+mf::SessionCredentials mfd::InProcessMessenger::client_creds()
+{
+    if (!channel->claimed())
+        return SocketMessenger::client_creds();
+
+    return {getpid(), getuid(), getgid()};
+}
+
+void mfd::InProcessMessenger::receive_fds(std::vector<Fd>& fds)
+{
+    if (!channel->claimed())
+    {
+        SocketMessenger::receive_fds(fds);
+        return;
+    }
+
+    char dummy;
+    if (!channel->to_server.read(&dummy, 1) || !channel->to_server.read_fds(fds))
+        BOOST_THROW_EXCEPTION(std::runtime_error("Failed to receive fds from in-process client"));
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_IN_PROCESS_MESSENGER_H_
+#define MIR_FRONTEND_IN_PROCESS_MESSENGER_H_
+
+#include "socket_messenger.h"
+
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+class InProcessChannel;
+
+namespace frontend
+{
+namespace detail
+{
+/// The server end of a connection that may be claimed by a client in the same process.
+/// Until the client claims the channel this is a SocketMessenger. Once it has, messages are
+/// read from and written to the channel instead, and each request is processed (by the read
+/// handler) on the server's IPC thread, just as if it had come from the socket.
+/// \note Messages are still protobuf-encoded: the RPC layers on both sides are built around the
+///       wire format, so this only saves the socket (the send, recv and fd passing), not the encoding.
+class InProcessMessenger : public SocketMessenger,
+                           public std::enable_shared_from_this<InProcessMessenger>
+{
+public:
+    InProcessMessenger(
+        std::shared_ptr<boost::asio::local::stream_protocol::socket> const& socket,
+        std::shared_ptr<InProcessChannel> const& channel);
+    ~InProcessMessenger();
+
+    void send(char const* data, size_t length, FdSets const& fds) override;
+
+    void async_receive_msg(MirReadHandler const& handler, boost::asio::mutable_buffers_1 const& buffer) override;
+    boost::system::error_code receive_msg(boost::asio::mutable_buffers_1 const& buffer) override;
+    size_t available_bytes() override;
+    SessionCredentials client_creds() override;
+    void receive_fds(std::vector<Fd>& fds) override;
+
+private:
+    /// Completes the pending read if the channel now holds enough for it
+    void deliver();
+
+    std::shared_ptr<boost::asio::local::stream_protocol::socket> const socket;
+    std::shared_ptr<InProcessChannel> const channel;
+
+    std::mutex mutex;
+    bool listening{false};
+    bool delivering{false};
+    MirReadHandler pending_handler;
+    boost::asio::mutable_buffers_1 pending_buffer{nullptr, 0};
+};
+}
+}
+}
+
+#endif /* MIR_FRONTEND_IN_PROCESS_MESSENGER_H_ */
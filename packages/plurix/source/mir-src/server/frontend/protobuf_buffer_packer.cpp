@@ -21,6 +21,9 @@
 #include "mir/graphics/display_configuration.h"
 #include "mir_protobuf.pb.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace mfd = mir::frontend::detail;
 namespace mg = mir::graphics;
 namespace mp = mir::protobuf;
@@ -94,6 +97,69 @@ void pack_protobuf_display_output(mp::DisplayOutput& protobuf_output,
     protobuf_output.set_custom_logical_size(display_output.custom_logical_size.is_set());
 }
 
+// Compares every field pack_protobuf_display_card() packs
+bool cards_pack_the_same(mg::DisplayConfigurationCard const& a, mg::DisplayConfigurationCard const& b)
+{
+    return a.id == b.id &&
+           a.max_simultaneous_outputs == b.max_simultaneous_outputs;
+}
+
+// Compares every field pack_protobuf_display_output() packs
+bool outputs_pack_the_same(mg::DisplayConfigurationOutput const& a, mg::DisplayConfigurationOutput const& b)
+{
+    if (a.modes.size() != b.modes.size())
+        return false;
+
+    for (size_t i = 0; i != a.modes.size(); ++i)
+    {
+        if (a.modes[i].size != b.modes[i].size || a.modes[i].vrefresh_hz != b.modes[i].vrefresh_hz)
+            return false;
+    }
+
+    return a.id == b.id &&
+           a.card_id == b.card_id &&
+           a.type == b.type &&
+           a.pixel_formats == b.pixel_formats &&
+           a.preferred_mode_index == b.preferred_mode_index &&
+           a.physical_size_mm == b.physical_size_mm &&
+           a.connected == b.connected &&
+           a.used == b.used &&
+           a.top_left == b.top_left &&
+           a.current_mode_index == b.current_mode_index &&
+           a.current_format == b.current_format &&
+           a.power_mode == b.power_mode &&
+           a.orientation == b.orientation &&
+           a.scale == b.scale &&
+           a.form_factor == b.form_factor &&
+           a.subpixel_arrangement == b.subpixel_arrangement &&
+           a.gamma_supported == b.gamma_supported &&
+           a.gamma.red == b.gamma.red &&
+           a.gamma.green == b.gamma.green &&
+           a.gamma.blue == b.gamma.blue &&
+           a.edid == b.edid &&
+           a.extents().size == b.extents().size &&
+           a.custom_logical_size.is_set() == b.custom_logical_size.is_set();
+}
+}
+
+bool mfd::packs_the_same(mg::DisplayConfiguration const& a, mg::DisplayConfiguration const& b)
+{
+    std::vector<mg::DisplayConfigurationCard> a_cards, b_cards;
+    a.for_each_card([&a_cards](mg::DisplayConfigurationCard const& card) { a_cards.push_back(card); });
+    b.for_each_card([&b_cards](mg::DisplayConfigurationCard const& card) { b_cards.push_back(card); });
+
+    if (a_cards.size() != b_cards.size() ||
+        !std::equal(a_cards.begin(), a_cards.end(), b_cards.begin(), &cards_pack_the_same))
+    {
+        return false;
+    }
+
+    std::vector<mg::DisplayConfigurationOutput> a_outputs, b_outputs;
+    a.for_each_output([&a_outputs](mg::DisplayConfigurationOutput const& output) { a_outputs.push_back(output); });
+    b.for_each_output([&b_outputs](mg::DisplayConfigurationOutput const& output) { b_outputs.push_back(output); });
+
+    return a_outputs.size() == b_outputs.size() &&
+           std::equal(a_outputs.begin(), a_outputs.end(), b_outputs.begin(), &outputs_pack_the_same);
 }
 
 void mfd::pack_protobuf_display_configuration(mp::DisplayConfiguration& protobuf_config,
@@ -43,6 +43,11 @@ namespace detail
 void pack_protobuf_display_configuration(protobuf::DisplayConfiguration& protobuf_config,
                                          graphics::DisplayConfiguration const& display_config);
 
+/// Whether pack_protobuf_display_configuration() would pack both configurations the same.
+/// This is far cheaper than packing them. It may find a difference that isn't packed, but never
+/// misses one that is.
+bool packs_the_same(graphics::DisplayConfiguration const& a, graphics::DisplayConfiguration const& b);
+
 class ProtobufBufferPacker : public graphics::BufferIpcMessage
 {
 public:
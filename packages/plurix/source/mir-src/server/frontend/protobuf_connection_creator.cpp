@@ -20,14 +20,17 @@
 
 #include "mir/frontend/session_credentials.h"
 #include "event_sender.h"
+#include "config_event_encoder.h"
 #include "event_sink_factory.h"
 #include "protobuf_message_processor.h"
 #include "protobuf_responder.h"
 #include "socket_messenger.h"
+#include "in_process_messenger.h"
 #include "socket_connection.h"
 
 #include "protobuf_ipc_factory.h"
 #include "mir/frontend/session_authorizer.h"
+#include "mir/in_process_channel.h"
 
 namespace mf = mir::frontend;
 namespace mfd = mir::frontend::detail;
@@ -43,7 +46,8 @@ mf::ProtobufConnectionCreator::ProtobufConnectionCreator(
     operations(operations),
     report(report),
     next_session_id(0),
-    connections(std::make_shared<mfd::Connections<mfd::SocketConnection>>())
+    connections(std::make_shared<mfd::Connections<mfd::SocketConnection>>()),
+    config_encoder(std::make_shared<mfd::ConfigEventEncoder>())
 {
 }
 
@@ -62,18 +66,22 @@ namespace
 class ProtobufEventFactory : public mf::EventSinkFactory
 {
 public:
-    ProtobufEventFactory(std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations)
-        : ops{operations}
+    ProtobufEventFactory(
+        std::shared_ptr<mir::graphics::PlatformIpcOperations> const& operations,
+        std::shared_ptr<mfd::ConfigEventEncoder> const& config_encoder)
+        : ops{operations},
+          config_encoder{config_encoder}
     {
     }
 
     std::unique_ptr<mf::EventSink>
     create_sink(std::shared_ptr<mf::MessageSender> const& messenger)
     {
-        return std::make_unique<mf::detail::EventSender>(messenger, ops);
+        return std::make_unique<mf::detail::EventSender>(messenger, ops, config_encoder);
     };
 private:
     std::shared_ptr<mir::graphics::PlatformIpcOperations> const ops;
+    std::shared_ptr<mfd::ConfigEventEncoder> const config_encoder;
 };
 }
 
@@ -81,7 +89,12 @@ void mf::ProtobufConnectionCreator::create_connection_for(
     std::shared_ptr<boost::asio::local::stream_protocol::socket> const& socket,
     ConnectionContext const& connection_context)
 {
-    auto const messenger = std::make_shared<detail::SocketMessenger>(socket);
+    std::shared_ptr<detail::SocketMessenger> messenger;
+    if (auto const channel = InProcessChannel::offered_to(socket->native_handle()))
+        messenger = std::make_shared<detail::InProcessMessenger>(socket, channel);
+    else
+        messenger = std::make_shared<detail::SocketMessenger>(socket);
+
     auto const creds = messenger->client_creds();
 
     if (session_authorizer->connection_is_allowed(creds))
@@ -95,7 +108,7 @@ void mf::ProtobufConnectionCreator::create_connection_for(
             message_sender,
             ipc_factory->make_ipc_server(
                 creds,
-                std::make_shared<ProtobufEventFactory>(operations),
+                std::make_shared<ProtobufEventFactory>(operations, config_encoder),
                 messenger,
                 connection_context),
             report);
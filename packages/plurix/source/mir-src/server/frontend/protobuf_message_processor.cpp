@@ -278,6 +278,10 @@ bool mfd::ProtobufMessageProcessor::dispatch(
         {
             invoke(this, display_server.get(), &DisplayServer::create_buffer_stream, invocation);
         }
+        else if ("create_submission_ring" == invocation.method_name())
+        {
+            invoke(this, display_server.get(), &DisplayServer::create_submission_ring, invocation);
+        }
         else if ("release_buffer_stream" == invocation.method_name())
         {
             invoke(this, display_server.get(), &DisplayServer::release_buffer_stream, invocation);
@@ -24,6 +24,7 @@
 #include "mir/frontend/mir_client_session.h"
 #include "mir/emergency_cleanup_registry.h"
 #include "mir/thread_name.h"
+#include "mir/in_process_channel.h"
 
 #include <boost/exception/errinfo_errno.hpp>
 #include <boost/throw_exception.hpp>
@@ -272,6 +273,11 @@ int mf::BasicConnector::client_socket_fd(std::function<void(std::shared_ptr<scen
 
     report->creating_socket_pair(socket_fd[server], socket_fd[client]);
 
+    // If the client turns out to be in this process it can skip the socket. The connection
+    // created for the server socket takes ownership of the channel.
+    auto const channel = std::make_shared<InProcessChannel>();
+    InProcessChannel::offer(socket_fd[server], socket_fd[client], channel);
+
     create_session_for(make_socket_self_contained(io_service, server_socket), connect_handler);
 
     return socket_fd[client];
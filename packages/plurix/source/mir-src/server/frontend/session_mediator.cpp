@@ -65,6 +65,7 @@
 
 #include "mir/geometry/rectangles.h"
 #include "protobuf_buffer_packer.h"
+#include "buffer_submission_ring.h"
 #include "protobuf_input_converter.h"
 
 #include "mir_toolkit/client_types.h"
@@ -394,20 +395,28 @@ namespace
         AutoSendBuffer(
             std::shared_ptr<mg::Buffer> const& wrapped,
             mir::Executor& executor,
-            std::weak_ptr<mf::BufferSink> const& sink)
+            std::weak_ptr<mf::BufferSink> const& sink,
+            std::weak_ptr<mf::BufferSubmissionRing> const& ring)
             : buffer{wrapped},
               executor{executor},
-              sink{sink}
+              sink{sink},
+              ring{ring}
         {
         }
         ~AutoSendBuffer()
         {
             executor.spawn(
-                [maybe_sink = sink, maybe_to_send = std::weak_ptr<mg::Buffer>(buffer)]()
+                [maybe_sink = sink, maybe_ring = ring, maybe_to_send = std::weak_ptr<mg::Buffer>(buffer)]()
                 {
-                    if (auto const live_sink = maybe_sink.lock())
+                    if (auto const& to_send = maybe_to_send.lock())
                     {
-                        if (auto const& to_send = maybe_to_send.lock())
+                        if (auto const live_ring = maybe_ring.lock())
+                        {
+                            if (live_ring->release(*to_send))
+                                return;
+                        }
+
+                        if (auto const live_sink = maybe_sink.lock())
                             live_sink->update_buffer(*to_send);
                     }
                 });
@@ -442,6 +451,7 @@ namespace
         std::shared_ptr<mg::Buffer> buffer;
         mir::Executor& executor;
         std::weak_ptr<mf::BufferSink> const sink;
+        std::weak_ptr<mf::BufferSubmissionRing> const ring;
     };
 
 }
@@ -454,20 +464,56 @@ void mf::SessionMediator::submit_buffer(
     auto const mir_client_session = weak_mir_client_session.lock();
     if (!mir_client_session) BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
     observer->session_submit_buffer_called(mir_client_session->name());
-    
+
     mf::BufferStreamId const stream_id{request->id().value()};
-    mg::BufferID const buffer_id{static_cast<uint32_t>(request->buffer().buffer_id())};
-    auto stream = mir_client_session->buffer_stream(stream_id);
 
-    mfd::ProtobufBufferPacker request_msg{const_cast<mir::protobuf::Buffer*>(&request->buffer())};
-    auto b = buffer_cache.at(buffer_id);
-    ipc_operations->unpack_buffer(request_msg, *b);
+    std::shared_ptr<BufferSubmissionRing> ring;
+    {
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        auto const r = submission_rings.find(stream_id);
+        if (r != submission_rings.end())
+            ring = r->second;
+    }
 
-    stream->submit_buffer(std::make_shared<AutoSendBuffer>(b, executor, event_sink));
+    if (ring)
+    {
+        // The client only uses the socket when the ring is full: what it has already queued goes first
+        ring->submit_after_queued(
+            [&] { submit_buffer(*mir_client_session, stream_id, request->buffer()); });
+    }
+    else
+    {
+        submit_buffer(*mir_client_session, stream_id, request->buffer());
+    }
 
     done->Run();
 }
 
+void mf::SessionMediator::submit_buffer(
+    MirClientSession& session,
+    BufferStreamId stream_id,
+    mir::protobuf::Buffer const& buffer)
+{
+    mg::BufferID const buffer_id{static_cast<uint32_t>(buffer.buffer_id())};
+    auto stream = session.buffer_stream(stream_id);
+
+    std::shared_ptr<mg::Buffer> b;
+    std::weak_ptr<BufferSubmissionRing> ring;
+    {
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        b = buffer_cache.at(buffer_id);
+
+        auto const r = submission_rings.find(stream_id);
+        if (r != submission_rings.end())
+            ring = r->second;
+    }
+
+    mfd::ProtobufBufferPacker request_msg{const_cast<mir::protobuf::Buffer*>(&buffer)};
+    ipc_operations->unpack_buffer(request_msg, *b);
+
+    stream->submit_buffer(std::make_shared<AutoSendBuffer>(b, executor, event_sink, ring));
+}
+
 namespace
 {
 bool validate_buffer_request(mir::protobuf::BufferStreamParameters const& req)
@@ -544,7 +590,10 @@ void mf::SessionMediator::allocate_buffers(
             }
 
             // TODO: Throw if insert fails (duplicate ID)?
-            buffer_cache.insert(std::make_pair(buffer->id(), buffer));
+            {
+                std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+                buffer_cache.insert(std::make_pair(buffer->id(), buffer));
+            }
             event_sink->add_buffer(*buffer);
         }
         catch (std::exception const& err)
@@ -594,9 +643,12 @@ void mf::SessionMediator::release_buffers(
             }
         }
     }
-    for (auto const& buffer_id : to_release)
     {
-        buffer_cache.erase(buffer_id);
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        for (auto const& buffer_id : to_release)
+        {
+            buffer_cache.erase(buffer_id);
+        }
     }
    done->Run();
 }
@@ -991,7 +1043,11 @@ void mf::SessionMediator::screencast_to_buffer(
     google::protobuf::Closure* done)
 {
     ScreencastSessionId const screencast_session_id{request->id().value()};
-    auto buffer = buffer_cache.at(mg::BufferID{request->buffer_id()});
+    std::shared_ptr<mg::Buffer> buffer;
+    {
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        buffer = buffer_cache.at(mg::BufferID{request->buffer_id()});
+    }
     screencast->capture(screencast_session_id, buffer);
     done->Run();
 }
@@ -1041,18 +1097,79 @@ void mf::SessionMediator::release_buffer_stream(
 
     auto const id = BufferStreamId(request->value());
 
+    std::shared_ptr<BufferSubmissionRing> ring;
+    {
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        auto const r = submission_rings.find(id);
+        if (r != submission_rings.end())
+        {
+            ring = std::move(r->second);
+            submission_rings.erase(r);
+        }
+    }
+    // Stop taking submissions (this waits for any in progress on the ring thread, so not under buffer_mutex)
+    ring.reset();
+
     mir_client_session->destroy_buffer_stream(id);
 
-    auto const associated_range = stream_associated_buffers.equal_range(id) ;
-    for (auto match = associated_range.first; match != associated_range.second; ++match)
     {
-        buffer_cache.erase(match->second);
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        auto const associated_range = stream_associated_buffers.equal_range(id);
+        for (auto match = associated_range.first; match != associated_range.second; ++match)
+        {
+            buffer_cache.erase(match->second);
+        }
     }
     stream_associated_buffers.erase(id);
 
     done->Run();
 }
 
+void mf::SessionMediator::create_submission_ring(
+    mir::protobuf::BufferStreamId const* request,
+    mir::protobuf::SocketFD* response,
+    google::protobuf::Closure* done)
+{
+    auto const mir_client_session = weak_mir_client_session.lock();
+
+    if (mir_client_session.get() == nullptr)
+        BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
+
+    auto const id = BufferStreamId(request->value());
+
+    // Fail early (on the socket) if the stream doesn't exist
+    mir_client_session->buffer_stream(id);
+
+    auto const ring = std::make_shared<BufferSubmissionRing>(
+        ipc_operations,
+        [this, id, weak_session = weak_mir_client_session](mg::BufferID buffer_id)
+        {
+            auto const session = weak_session.lock();
+            if (!session)
+                return;
+
+            observer->session_submit_buffer_called(session->name());
+
+            mir::protobuf::Buffer buffer;
+            buffer.set_buffer_id(buffer_id.as_value());
+            submit_buffer(*session, id, buffer);
+        });
+
+    {
+        std::lock_guard<decltype(buffer_mutex)> lock{buffer_mutex};
+        if (!submission_rings.insert(std::make_pair(id, ring)).second)
+            BOOST_THROW_EXCEPTION(std::runtime_error("Buffer stream already has a submission ring"));
+    }
+
+    for (auto const& fd : ring->client_fds())
+    {
+        response->add_fd(fd);
+        resource_cache->save_fd(response, fd);
+    }
+
+    done->Run();
+}
+
 
 auto mf::SessionMediator::prompt_session_connect_handler(detail::PromptSessionId prompt_session_id) const
 -> std::function<void(std::shared_ptr<scene::Session> const&)>
@@ -82,6 +82,7 @@ class PromptSession;
 class BufferStream;
 class InputConfigurationChanger;
 class BufferMap;
+class BufferSubmissionRing;
 
 namespace detail
 {
@@ -209,6 +210,10 @@ public:
         mir::protobuf::BufferStreamParameters const* request,
         mir::protobuf::BufferStream* response,
         google::protobuf::Closure* done) override;
+    void create_submission_ring(
+        mir::protobuf::BufferStreamId const* request,
+        mir::protobuf::SocketFD* response,
+        google::protobuf::Closure* done) override;
     void release_buffer_stream(
         mir::protobuf::BufferStreamId const* request,
         mir::protobuf::Void* response,
@@ -273,6 +278,11 @@ public:
         google::protobuf::Closure* done) override;
 
 private:
+    void submit_buffer(
+        MirClientSession& session,
+        BufferStreamId stream_id,
+        mir::protobuf::Buffer const& buffer);
+
     void pack_protobuf_buffer(protobuf::Buffer& protobuf_buffer,
                               graphics::Buffer* graphics_buffer,
                               graphics::BufferIpcMsgType msg_type);
@@ -305,6 +315,8 @@ private:
     std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<InputConfigurationChanger> const input_changer;
     std::vector<mir::ExtensionDescription> const extensions;
+    /// Guards buffer_cache and submission_rings, which are also used by the submission ring thread
+    std::mutex mutable buffer_mutex;
     std::unordered_map<graphics::BufferID, std::shared_ptr<graphics::Buffer>> buffer_cache;
     std::unordered_multimap<BufferStreamId, graphics::BufferID> stream_associated_buffers;
     std::shared_ptr<graphics::GraphicBufferAllocator> const allocator;
@@ -317,6 +329,9 @@ private:
     detail::PromptSessionStore prompt_sessions;
 
     std::map<frontend::SurfaceId, frontend::BufferStreamId> legacy_default_stream_map;
+
+    // Last, so the rings (and their callbacks into us) go before anything else
+    std::map<BufferStreamId, std::shared_ptr<BufferSubmissionRing>> submission_rings;
 };
 
 }
@@ -17,8 +17,12 @@
  */
 
 #include "data_device.h"
+#include "deleted_for_resource.h"
+#include "wayland_utils.h"
 #include "wl_seat.h"
 
+#include "mir/executor.h"
+
 #include <vector>
 #include <algorithm>
 
@@ -38,10 +42,31 @@ namespace
 class DataDeviceManager;
 class DataSource;
 struct DataDevice;
+struct DataOffer;
+
+/// What a DataOffer offers: the data source of one of our clients, or the selection of a
+/// client on another display
+struct SelectionSource
+{
+    SelectionSource() = default;
+    virtual ~SelectionSource();
+
+    virtual auto mime_types() const -> std::vector<std::string> const& = 0;
+    virtual void send_send(std::string const& mime_type, mir::Fd fd) = 0;
+
+    void add_listener(DataOffer* listener);
+    void remove_listener(DataOffer* listener);
+
+    std::vector<DataOffer*> listeners;
+
+private:
+    SelectionSource(SelectionSource const&) = delete;
+    SelectionSource& operator=(SelectionSource const&) = delete;
+};
 
 struct DataOffer : mw::DataOffer
 {
-    DataOffer(DataSource* source, DataDevice* device);
+    DataOffer(SelectionSource* source, DataDevice* device);
 
     void accept(uint32_t serial, std::experimental::optional<std::string> const& mime_type) override
     {
@@ -63,10 +88,11 @@ struct DataOffer : mw::DataOffer
 
     void offer(std::string const& mime_type);
 
-    DataSource* const source;
+    /// Null once the source has gone
+    SelectionSource* source;
 };
 
-struct DataSource : mw::DataSource
+struct DataSource : mw::DataSource, SelectionSource
 {
 public:
     DataSource(wl_resource* new_resource, DataDeviceManager* manager)
@@ -92,15 +118,31 @@ public:
             send_cancelled_event();
     }
 
-    void add_listener(DataOffer* listener);
-    void remove_listener(DataOffer* listener);
+    auto mime_types() const -> std::vector<std::string> const& override { return offered_mime_types; }
 
     bool destroyed = false;
     DataDeviceManager* const manager; // Actually, this probably needs to be a listener list?
-    std::vector<DataOffer*> listeners;
-    std::vector<std::string> mime_types;
+    std::vector<std::string> offered_mime_types;
+
+    void send_send(std::string const& mime_type, mir::Fd fd) override;
+};
+
+/// The selection of a client on another display
+struct RemoteSelection : SelectionSource
+{
+    RemoteSelection(std::shared_ptr<mf::Clipboard::Selection const> const& selection)
+        : selection{selection}
+    {
+    }
+
+    auto mime_types() const -> std::vector<std::string> const& override { return selection->mime_types; }
+
+    void send_send(std::string const& mime_type, mir::Fd fd) override
+    {
+        selection->send(mime_type, fd);
+    }
 
-    void send_send(std::string const& mime_type, mir::Fd fd);
+    std::shared_ptr<mf::Clipboard::Selection const> const selection;
 };
 
 struct DataDevice : mw::DataDevice, mf::WlSeat::ListenerTracker
@@ -115,15 +157,12 @@ struct DataDevice : mw::DataDevice, mf::WlSeat::ListenerTracker
         (void)source, (void)origin, (void)icon, (void)serial;
     }
 
-    void set_selection(std::experimental::optional<struct wl_resource*> const& source, uint32_t serial) override
-    {
-        (void)source, (void)serial;
-    }
+    void set_selection(std::experimental::optional<struct wl_resource*> const& source, uint32_t serial) override;
 
     void release() override;
 
-    void notify_new(DataSource* source);
-    void notify_destroyed(DataSource* source);
+    void notify_new(SelectionSource* source);
+    void notify_destroyed(SelectionSource* source);
 
 private:
     void focus_on(wl_client *client) override;
@@ -133,14 +172,17 @@ public:
     DataDeviceManager* const manager;
     mf::WlSeat* const seat;
     bool has_focus = false;
-    DataSource* current_source = nullptr;
+    SelectionSource* current_source = nullptr;
     DataOffer* current_offer = nullptr;
 };
 
 class DataDeviceManager : public mf::DataDeviceManager
 {
 public:
-    DataDeviceManager(struct wl_display* display);
+    DataDeviceManager(
+        struct wl_display* display,
+        std::shared_ptr<mir::Executor> const& executor,
+        std::shared_ptr<mf::Clipboard> const& clipboard);
     ~DataDeviceManager();
 
     void notify_destroyed(DataSource* source);
@@ -148,11 +190,26 @@ public:
     void add_listener(DataDevice* listener);
     void remove_listener(DataDevice* listener);
 
+    /// Shares source's selection with the clients of the other displays
+    void publish(DataSource* source);
+
 private:
     using ds_ptr = std::unique_ptr<DataSource, void(*)(DataSource*)>;
     ds_ptr current_data_source;
     std::vector<DataDevice*> listeners;
 
+    std::shared_ptr<mir::Executor> const executor;
+    std::shared_ptr<mf::Clipboard> const clipboard;
+    std::shared_ptr<bool> const destroyed;
+
+    /// What we last published for current_data_source, if anything
+    std::shared_ptr<mf::Clipboard::Selection const> published;
+    /// The selection of a client on another display, if that is the latest
+    std::unique_ptr<RemoteSelection> remote_selection;
+
+    void new_selection(SelectionSource* source);
+    void remote_selection_changed(std::shared_ptr<mf::Clipboard::Selection const> const& selection);
+
     void bind(wl_resource* new_resource) override;
 
     class Instance : mir::wayland::DataDeviceManager
@@ -169,9 +226,25 @@ private:
 };
 }
 
+SelectionSource::~SelectionSource()
+{
+    for (auto const& listener : listeners)
+        listener->source = nullptr;
+}
+
+void SelectionSource::add_listener(DataOffer* listener)
+{
+    listeners.push_back(listener);
+}
+
+void SelectionSource::remove_listener(DataOffer* listener)
+{
+    listeners.erase(remove(begin(listeners), end(listeners), listener), end(listeners));
+}
+
 void DataSource::offer(std::string const& mime_type)
 {
-    mime_types.push_back(mime_type);
+    offered_mime_types.push_back(mime_type);
     for (auto const& listener : listeners)
         listener->offer(mime_type);
 }
@@ -183,35 +256,96 @@ void DataSource::destroy()
     destroy_wayland_object();
 }
 
-void DataSource::add_listener(DataOffer* listener)
+void DataSource::send_send(std::string const& mime_type, mir::Fd fd)
 {
-    listeners.push_back(listener);
+    send_send_event(mime_type.c_str(), fd);
 }
 
-void DataSource::remove_listener(DataOffer* listener)
+DataSource::~DataSource()
 {
-    listeners.erase(remove(begin(listeners), end(listeners), listener), end(listeners));
+    if (!destroyed)
+        manager->notify_destroyed(this);
 }
 
-void DataSource::send_send(std::string const& mime_type, mir::Fd fd)
+void mf::Clipboard::add_manager(void const* manager, OnChange const& on_change)
 {
-    send_send_event(mime_type.c_str(), fd);
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    managers.push_back({manager, on_change});
 }
 
-DataSource::~DataSource()
+void mf::Clipboard::remove_manager(void const* manager)
 {
-    if (!destroyed)
-        manager->notify_destroyed(this);
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    managers.erase(
+        remove_if(begin(managers), end(managers), [manager](Manager const& m) { return m.manager == manager; }),
+        end(managers));
 }
 
-DataDeviceManager::DataDeviceManager(struct wl_display* display) :
-    mf::DataDeviceManager(display, Version<3>()),
-    current_data_source{nullptr, [](DataSource* ds) { if(ds) ds->send_cancelled(); }}
+void mf::Clipboard::publish(void const* manager, std::shared_ptr<Selection const> const& selection)
 {
+    std::vector<OnChange> others;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        current = selection;
+        others = others_locked(manager);
+    }
+
+    for (auto const& on_change : others)
+        on_change(selection);
+}
+
+void mf::Clipboard::withdraw(void const* manager, Selection const* selection)
+{
+    std::vector<OnChange> others;
+    {
+        // Check and clear together, so a selection published meanwhile is never cleared
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        if (current.get() != selection)
+            return;
+
+        current = nullptr;
+        others = others_locked(manager);
+    }
+
+    for (auto const& on_change : others)
+        on_change(nullptr);
+}
+
+auto mf::Clipboard::others_locked(void const* manager) const -> std::vector<OnChange>
+{
+    std::vector<OnChange> others;
+    for (auto const& m : managers)
+    {
+        if (m.manager != manager)
+            others.push_back(m.on_change);
+    }
+    return others;
+}
+
+DataDeviceManager::DataDeviceManager(
+    struct wl_display* display,
+    std::shared_ptr<mir::Executor> const& executor,
+    std::shared_ptr<mf::Clipboard> const& clipboard) :
+    mf::DataDeviceManager(display, Version<3>()),
+    current_data_source{nullptr, [](DataSource* ds) { if(ds) ds->send_cancelled(); }},
+    executor{executor},
+    clipboard{clipboard},
+    destroyed{std::make_shared<bool>(false)}
+{
+    clipboard->add_manager(this, [this, executor = executor, destroyed = destroyed]
+        (std::shared_ptr<mf::Clipboard::Selection const> const& selection)
+        {
+            executor->spawn(mf::run_unless(destroyed, [this, selection]
+                {
+                    remote_selection_changed(selection);
+                }));
+        });
 }
 
 DataDeviceManager::~DataDeviceManager()
 {
+    *destroyed = true;
+    clipboard->remove_manager(this);
     current_data_source.release();
 }
 
@@ -224,9 +358,7 @@ DataDeviceManager::Instance::Instance(wl_resource* new_resource, ::DataDeviceMan
 void DataDeviceManager::Instance::create_data_source(wl_resource* new_data_source)
 {
     manager->current_data_source.reset(new DataSource{new_data_source, manager});
-
-    for (auto const& listener : manager->listeners)
-        listener->notify_new(manager->current_data_source.get());
+    manager->new_selection(manager->current_data_source.get());
 }
 
 void DataDeviceManager::Instance::get_data_device(wl_resource* new_data_device, wl_resource* seat)
@@ -236,6 +368,64 @@ void DataDeviceManager::Instance::get_data_device(wl_resource* new_data_device,
 
     if (manager->current_data_source)
         result->notify_new(manager->current_data_source.get());
+    else if (manager->remote_selection)
+        result->notify_new(manager->remote_selection.get());
+}
+
+void DataDeviceManager::new_selection(SelectionSource* source)
+{
+    for (auto const& listener : listeners)
+        listener->notify_new(source);
+
+    // Any earlier selection from another display has been replaced
+    remote_selection.reset();
+}
+
+void DataDeviceManager::publish(DataSource* source)
+{
+    if (current_data_source.get() != source)
+        return;
+
+    // The source is only ever used on our thread, so other displays ask us to use it
+    std::weak_ptr<bool> const weak_destroyed{destroyed};
+    auto const source_destroyed = mf::deleted_flag_for_resource(source->resource);
+    published = std::make_shared<mf::Clipboard::Selection const>(mf::Clipboard::Selection{
+        source->mime_types(),
+        [executor = executor, weak_destroyed, source_destroyed, source](std::string const& mime_type, mir::Fd fd)
+        {
+            executor->spawn([weak_destroyed, source_destroyed, source, mime_type, fd]
+                {
+                    auto const destroyed = weak_destroyed.lock();
+                    if (destroyed && !*destroyed && !*source_destroyed)
+                        source->send_send(mime_type, fd);
+                });
+        }});
+
+    clipboard->publish(this, published);
+}
+
+void DataDeviceManager::remote_selection_changed(std::shared_ptr<mf::Clipboard::Selection const> const& selection)
+{
+    if (!selection)
+    {
+        // The client on another display that had the selection has dropped it
+        if (remote_selection)
+        {
+            for (auto const& listener : listeners)
+                listener->notify_destroyed(remote_selection.get());
+            remote_selection.reset();
+        }
+        return;
+    }
+
+    // A client on another display has taken the selection from ours
+    auto next = std::make_unique<RemoteSelection>(selection);
+    for (auto const& listener : listeners)
+        listener->notify_new(next.get());
+
+    current_data_source.reset();
+    published.reset();
+    remote_selection = std::move(next);
 }
 
 void DataDeviceManager::notify_destroyed(DataSource* source)
@@ -244,7 +434,15 @@ void DataDeviceManager::notify_destroyed(DataSource* source)
         listener->notify_destroyed(source);
 
     if (current_data_source.get() == source)
+    {
         current_data_source.reset();
+
+        if (published)
+        {
+            clipboard->withdraw(this, published.get());
+            published.reset();
+        }
+    }
 }
 
 void DataDeviceManager::add_listener(DataDevice* listener)
@@ -277,7 +475,16 @@ DataDevice::~DataDevice()
     seat->remove_focus_listener(this);
 }
 
-void DataDevice::notify_new(DataSource* source)
+void DataDevice::set_selection(std::experimental::optional<struct wl_resource*> const& source, uint32_t serial)
+{
+    (void)serial;
+
+    // By now the source has offered its mime types, so it can be shared with other displays
+    if (source)
+        manager->publish(static_cast<DataSource*>(mw::DataSource::from(source.value())));
+}
+
+void DataDevice::notify_new(SelectionSource* source)
 {
     if (current_source)
     {
@@ -292,7 +499,7 @@ void DataDevice::notify_new(DataSource* source)
     }
 }
 
-void DataDevice::notify_destroyed(DataSource* source)
+void DataDevice::notify_destroyed(SelectionSource* source)
 {
     if (source == current_source)
     {
@@ -319,13 +526,13 @@ void DataDevice::focus_on(wl_client* focus)
     }
 }
 
-DataOffer::DataOffer(DataSource* source, DataDevice* device) :
+DataOffer::DataOffer(SelectionSource* source, DataDevice* device) :
     mw::DataOffer(*device),
     source{source}
 {
     source->add_listener(this);
     device->send_data_offer_event(resource);
-    for (auto const& type : source->mime_types)
+    for (auto const& type : source->mime_types())
     {
         send_offer_event(type);
     }
@@ -339,17 +546,22 @@ void DataOffer::offer(std::string const& mime_type)
 
 void DataOffer::receive(std::string const& mime_type, mir::Fd fd)
 {
-    source->send_send(mime_type, fd);
+    if (source)
+        source->send_send(mime_type, fd);
 }
 
 void DataOffer::destroy()
 {
-    source->remove_listener(this);
+    if (source)
+        source->remove_listener(this);
     destroy_wayland_object();
 }
 
-auto mf::create_data_device_manager(struct wl_display* display)
+auto mf::create_data_device_manager(
+    struct wl_display* display,
+    std::shared_ptr<Executor> const& executor,
+    std::shared_ptr<Clipboard> const& clipboard)
 -> std::unique_ptr<DataDeviceManager>
 {
-    return std::unique_ptr<DataDeviceManager>{new ::DataDeviceManager(display)};
+    return std::unique_ptr<DataDeviceManager>{new ::DataDeviceManager(display, executor, clipboard)};
 }
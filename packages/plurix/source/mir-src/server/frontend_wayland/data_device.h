@@ -20,9 +20,18 @@
 #define MIR_FRONTEND_DATA_DEVICE_H_
 
 #include "wayland_wrapper.h"
+#include "mir/fd.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace mir
 {
+class Executor;
+
 namespace frontend
 {
 class DataDeviceManager : public wayland::DataDeviceManager::Global
@@ -31,7 +40,50 @@ public:
     using wayland::DataDeviceManager::Global::Global;
 };
 
-auto create_data_device_manager(struct wl_display* display) -> std::unique_ptr<DataDeviceManager>;
+/// The selection, shared between the data device managers of every Wayland display
+/// (when clients are spread over several displays, each dispatched by its own thread)
+class Clipboard
+{
+public:
+    struct Selection
+    {
+        std::vector<std::string> mime_types;
+
+        /// Asks the client that owns the selection to write it to fd. May be called from any thread.
+        std::function<void(std::string const& mime_type, Fd fd)> send;
+    };
+
+    using OnChange = std::function<void(std::shared_ptr<Selection const> const& selection)>;
+
+    /// \param on_change   called, on the thread of the manager publishing it, whenever another
+    ///                     manager's client sets (or clears) the selection
+    void add_manager(void const* manager, OnChange const& on_change);
+    void remove_manager(void const* manager);
+
+    void publish(void const* manager, std::shared_ptr<Selection const> const& selection);
+
+    /// Clears the selection, if it is still \p selection
+    void withdraw(void const* manager, Selection const* selection);
+
+private:
+    struct Manager
+    {
+        void const* manager;
+        OnChange on_change;
+    };
+
+    /// Must be called with mutex locked
+    auto others_locked(void const* manager) const -> std::vector<OnChange>;
+
+    std::mutex mutex;
+    std::vector<Manager> managers;
+    std::shared_ptr<Selection const> current;
+};
+
+auto create_data_device_manager(
+    struct wl_display* display,
+    std::shared_ptr<Executor> const& executor,
+    std::shared_ptr<Clipboard> const& clipboard) -> std::unique_ptr<DataDeviceManager>;
 }
 }
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame_aligned_input.h"
+
+#include "wl_surface.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <wayland-server-core.h>
+
+namespace mf = mir::frontend;
+
+namespace
+{
+auto now() -> std::chrono::nanoseconds
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+}
+}
+
+mf::FrameAlignedInput::FrameAlignedInput(
+    wl_client* client,
+    std::chrono::milliseconds max_delay,
+    Release const& release)
+    : max_delay{max_delay},
+      release{release},
+      deadline{wl_event_loop_add_timer(
+          wl_display_get_event_loop(wl_client_get_display(client)),
+          &FrameAlignedInput::on_deadline,
+          this)},
+      destroyed{std::make_shared<bool>(false)}
+{
+    if (!deadline)
+    {
+        BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to create Wayland input deadline timer"}));
+    }
+}
+
+mf::FrameAlignedInput::~FrameAlignedInput()
+{
+    *destroyed = true;
+    wl_event_source_remove(deadline);
+}
+
+void mf::FrameAlignedInput::hold_for(WlSurface* surface)
+{
+    awaited_surfaces.erase(
+        std::remove_if(
+            begin(awaited_surfaces),
+            end(awaited_surfaces),
+            [](AwaitedSurface const& awaited) { return *awaited.destroyed; }),
+        end(awaited_surfaces));
+
+    auto const already_awaited = std::any_of(
+        begin(awaited_surfaces),
+        end(awaited_surfaces),
+        [surface](AwaitedSurface const& awaited) { return awaited.surface == surface; });
+
+    if (!already_awaited)
+    {
+        awaited_surfaces.push_back({surface, surface->destroyed_flag()});
+        surface->on_next_frame([this, destroyed = destroyed, surface, generation = generation]
+            {
+                if (!*destroyed)
+                    frame(surface, generation);
+            });
+    }
+
+    // The deadline runs from the oldest input held
+    if (!deadline_armed)
+    {
+        wl_event_source_timer_update(deadline, max_delay.count());
+        deadline_armed = true;
+    }
+}
+
+void mf::FrameAlignedInput::reset()
+{
+    ++generation;
+    awaited_surfaces.clear();
+
+    if (deadline_armed)
+    {
+        wl_event_source_timer_update(deadline, 0);
+        deadline_armed = false;
+    }
+}
+
+void mf::FrameAlignedInput::frame(WlSurface* surface, uint64_t generation)
+{
+    if (generation != this->generation)
+        return;
+
+    awaited_surfaces.erase(
+        std::remove_if(
+            begin(awaited_surfaces),
+            end(awaited_surfaces),
+            [surface](AwaitedSurface const& awaited) { return awaited.surface == surface; }),
+        end(awaited_surfaces));
+
+    if (awaited_surfaces.empty())
+        reset();
+
+    // What the client draws for this frame should be presented about one frame from now
+    release(surface, now() + surface->frame_interval());
+}
+
+int mf::FrameAlignedInput::on_deadline(void* data)
+{
+    auto const self = static_cast<FrameAlignedInput*>(data);
+
+    self->deadline_armed = false;
+    self->reset();
+    self->release(nullptr, now());
+
+    return 0;
+}
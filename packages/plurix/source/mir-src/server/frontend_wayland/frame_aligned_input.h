@@ -0,0 +1,81 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_FRAME_ALIGNED_INPUT_H
+#define MIR_FRONTEND_FRAME_ALIGNED_INPUT_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct wl_client;
+struct wl_event_source;
+
+namespace mir
+{
+namespace frontend
+{
+class WlSurface;
+
+/// Schedules the release of input held back for surfaces that are drawing continuously.
+/// What is held for a surface is released just before that surface's next frame callbacks are
+/// sent. If a client takes too long to draw, everything held is released when the deadline
+/// passes: a timer on the Wayland event loop, so it doesn't depend on further input arriving.
+/// Should only be used from the Wayland thread.
+class FrameAlignedInput
+{
+public:
+    /// Releases what is held for a surface, or for every surface if it is null (the deadline
+    /// has passed). Also given the time the client's next frame is expected to be presented.
+    using Release = std::function<void(WlSurface* surface, std::chrono::nanoseconds presentation)>;
+
+    FrameAlignedInput(wl_client* client, std::chrono::milliseconds max_delay, Release const& release);
+    ~FrameAlignedInput();
+
+    /// Input is held for \p surface: release it before the surface's next frame
+    void hold_for(WlSurface* surface);
+
+    /// Nothing is held any more (it has been sent some other way)
+    void reset();
+
+private:
+    FrameAlignedInput(FrameAlignedInput const&) = delete;
+    FrameAlignedInput& operator=(FrameAlignedInput const&) = delete;
+
+    static int on_deadline(void* data);
+    void frame(WlSurface* surface, uint64_t generation);
+
+    std::chrono::milliseconds const max_delay;
+    Release const release;
+    wl_event_source* const deadline;
+    std::shared_ptr<bool> const destroyed;
+    bool deadline_armed{false};
+
+    /// Changes when everything held is released, so frames awaited before then are ignored
+    uint64_t generation{0};
+
+    struct AwaitedSurface
+    {
+        WlSurface* surface;
+        std::shared_ptr<bool> destroyed;
+    };
+    std::vector<AwaitedSurface> awaited_surfaces;
+};
+}
+}
+
+#endif // MIR_FRONTEND_FRAME_ALIGNED_INPUT_H
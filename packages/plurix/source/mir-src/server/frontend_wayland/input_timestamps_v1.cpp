@@ -0,0 +1,174 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_timestamps_v1.h"
+
+#include "input-timestamps-unstable-v1_wrapper.h"
+#include "wl_keyboard.h"
+#include "wl_pointer.h"
+#include "wl_touch.h"
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+namespace mw = mir::wayland;
+
+namespace mir
+{
+namespace frontend
+{
+
+class InputTimestampsManagerV1 : public wayland::InputTimestampsManagerV1::Global
+{
+public:
+    InputTimestampsManagerV1(struct wl_display* display);
+
+private:
+    class Instance : public wayland::InputTimestampsManagerV1
+    {
+    public:
+        Instance(wl_resource* new_resource);
+
+    private:
+        void destroy() override;
+        void get_keyboard_timestamps(wl_resource* id, wl_resource* keyboard) override;
+        void get_pointer_timestamps(wl_resource* id, wl_resource* pointer) override;
+        void get_touch_timestamps(wl_resource* id, wl_resource* touch) override;
+    };
+
+    void bind(wl_resource* new_resource) override;
+};
+
+class InputTimestampsV1 : public wayland::InputTimestampsV1
+{
+public:
+    InputTimestampsV1(wl_resource* new_resource, InputTimestampListeners& source);
+    ~InputTimestampsV1();
+
+    void send_timestamp(std::chrono::nanoseconds timestamp) const;
+
+    /// Called when the input device goes away, after which this object is inert
+    void detach();
+
+private:
+    void destroy() override;
+
+    InputTimestampListeners* source; ///< null once the input device has been destroyed
+};
+
+}
+}
+
+auto mf::create_input_timestamps_manager_v1(struct wl_display* display)
+    -> std::shared_ptr<InputTimestampsManagerV1>
+{
+    return std::make_shared<InputTimestampsManagerV1>(display);
+}
+
+// InputTimestampListeners
+
+mf::InputTimestampListeners::~InputTimestampListeners()
+{
+    for (auto const listener : listeners)
+        listener->detach();
+}
+
+void mf::InputTimestampListeners::add(InputTimestampsV1* listener)
+{
+    listeners.push_back(listener);
+}
+
+void mf::InputTimestampListeners::remove(InputTimestampsV1* listener)
+{
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void mf::InputTimestampListeners::send(std::chrono::nanoseconds timestamp) const
+{
+    for (auto const listener : listeners)
+        listener->send_timestamp(timestamp);
+}
+
+// InputTimestampsManagerV1
+
+mf::InputTimestampsManagerV1::InputTimestampsManagerV1(struct wl_display* display)
+    : Global(display, Version<1>())
+{
+}
+
+void mf::InputTimestampsManagerV1::bind(wl_resource* new_resource)
+{
+    new Instance{new_resource};
+}
+
+mf::InputTimestampsManagerV1::Instance::Instance(wl_resource* new_resource)
+    : InputTimestampsManagerV1(new_resource, Version<1>())
+{
+}
+
+void mf::InputTimestampsManagerV1::Instance::destroy()
+{
+    destroy_wayland_object();
+}
+
+void mf::InputTimestampsManagerV1::Instance::get_keyboard_timestamps(wl_resource* id, wl_resource* keyboard)
+{
+    new InputTimestampsV1{id, WlKeyboard::from(keyboard)->timestamp_listeners()};
+}
+
+void mf::InputTimestampsManagerV1::Instance::get_pointer_timestamps(wl_resource* id, wl_resource* pointer)
+{
+    new InputTimestampsV1{id, WlPointer::from(pointer)->timestamp_listeners()};
+}
+
+void mf::InputTimestampsManagerV1::Instance::get_touch_timestamps(wl_resource* id, wl_resource* touch)
+{
+    new InputTimestampsV1{id, WlTouch::from(touch)->timestamp_listeners()};
+}
+
+// InputTimestampsV1
+
+mf::InputTimestampsV1::InputTimestampsV1(wl_resource* new_resource, InputTimestampListeners& source)
+    : wayland::InputTimestampsV1(new_resource, Version<1>()),
+      source{&source}
+{
+    source.add(this);
+}
+
+mf::InputTimestampsV1::~InputTimestampsV1()
+{
+    if (source)
+        source->remove(this);
+}
+
+void mf::InputTimestampsV1::send_timestamp(std::chrono::nanoseconds timestamp) const
+{
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(timestamp);
+    auto const tv_sec = static_cast<uint64_t>(seconds.count());
+    auto const tv_nsec = static_cast<uint32_t>((timestamp - seconds).count());
+
+    send_timestamp_event(tv_sec >> 32, tv_sec & 0xffffffff, tv_nsec);
+}
+
+void mf::InputTimestampsV1::detach()
+{
+    source = nullptr;
+}
+
+void mf::InputTimestampsV1::destroy()
+{
+    destroy_wayland_object();
+}
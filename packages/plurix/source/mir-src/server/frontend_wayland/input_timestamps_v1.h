@@ -0,0 +1,62 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_INPUT_TIMESTAMPS_V1_H
+#define MIR_FRONTEND_INPUT_TIMESTAMPS_V1_H
+
+#include <memory>
+#include <vector>
+#include <chrono>
+
+struct wl_display;
+
+namespace mir
+{
+namespace frontend
+{
+class InputTimestampsManagerV1;
+class InputTimestampsV1;
+
+auto create_input_timestamps_manager_v1(struct wl_display* display)
+    -> std::shared_ptr<InputTimestampsManagerV1>;
+
+/// The zwp_input_timestamps_v1 objects subscribed to a single wl_keyboard, wl_pointer or wl_touch
+/// Should only be used from the Wayland thread
+class InputTimestampListeners
+{
+public:
+    InputTimestampListeners() = default;
+    ~InputTimestampListeners();
+
+    void add(InputTimestampsV1* listener);
+    void remove(InputTimestampsV1* listener);
+
+    auto empty() const -> bool { return listeners.empty(); }
+
+    /// Sends the full resolution timestamp to every listener
+    /// Must be called immediately before sending the input event it applies to
+    void send(std::chrono::nanoseconds timestamp) const;
+
+private:
+    InputTimestampListeners(InputTimestampListeners const&) = delete;
+    InputTimestampListeners& operator=(InputTimestampListeners const&) = delete;
+
+    std::vector<InputTimestampsV1*> listeners;
+};
+}
+}
+
+#endif // MIR_FRONTEND_INPUT_TIMESTAMPS_V1_H
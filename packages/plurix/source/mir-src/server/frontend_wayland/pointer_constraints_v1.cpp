@@ -0,0 +1,559 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pointer_constraints_v1.h"
+
+#include "pointer-constraints-unstable-v1_wrapper.h"
+#include "wl_region.h"
+#include "wl_seat.h"
+#include "wl_surface.h"
+#include "wayland_utils.h"
+
+#include "mir/geometry/rectangles.h"
+#include "mir/scene/null_surface_observer.h"
+#include "mir/scene/surface.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+namespace mw = mir::wayland;
+namespace ms = mir::scene;
+
+namespace mir
+{
+namespace frontend
+{
+class PointerConstraint;
+
+class PointerConstraintsV1 : public wayland::PointerConstraintsV1::Global, WlSeat::PointerMotionListener
+{
+public:
+    PointerConstraintsV1(struct wl_display* display, WlSeat* seat);
+    ~PointerConstraintsV1();
+
+private:
+    class Instance : public wayland::PointerConstraintsV1
+    {
+    public:
+        Instance(wl_resource* new_resource, mf::PointerConstraintsV1* manager);
+
+    private:
+        void destroy() override;
+        void lock_pointer(
+            wl_resource* id,
+            wl_resource* surface,
+            wl_resource* pointer,
+            std::experimental::optional<wl_resource*> const& region,
+            uint32_t lifetime) override;
+        void confine_pointer(
+            wl_resource* id,
+            wl_resource* surface,
+            wl_resource* pointer,
+            std::experimental::optional<wl_resource*> const& region,
+            uint32_t lifetime) override;
+
+        /// Posts already_constrained and returns false if the surface already has a constraint
+        auto check_unconstrained(WlSurface* surface) -> bool;
+
+        mf::PointerConstraintsV1* const manager;
+    };
+
+    void bind(wl_resource* new_resource) override;
+    void pointer_moved(WlSurface* window, geometry::Point const& position) override;
+
+    friend class PointerConstraint;
+    WlSeat* const seat;
+    /// There is only one seat, so at most one constraint may exist per surface
+    std::vector<PointerConstraint*> constraints;
+    /// There is only one cursor, so at most one constraint may be active at a time
+    PointerConstraint* active_constraint{nullptr};
+};
+
+/// Shared state machine of zwp_locked_pointer_v1 and zwp_confined_pointer_v1
+/// The constraint activates when the pointer is within its region while the client owning the
+/// surface has focus, and deactivates when the client loses focus
+class PointerConstraint : public WlSeat::ListenerTracker
+{
+public:
+    PointerConstraint(
+        PointerConstraintsV1* manager,
+        WlSurface* surface,
+        std::experimental::optional<wl_resource*> const& region,
+        uint32_t lifetime);
+    ~PointerConstraint();
+
+    auto constrains(WlSurface* surface) const -> bool { return this->surface == surface; }
+
+    /// Activates the constraint if \p window contains the constrained surface and the pointer is within its region
+    /// \returns if the constraint is now active
+    auto pointer_moved(WlSurface* window, geom::Point const& position) -> bool;
+
+protected:
+    WlSeat* const seat;
+
+    /// Must be called by the derived class once the Wayland object is fully constructed
+    void start();
+
+    /// Replaces the region and re-applies the constraint if it is active
+    void update_region(std::experimental::optional<wl_resource*> const& region);
+
+    /// Ends the constraint without notifying the client, for use when the object is being destroyed
+    void end();
+
+private:
+    class SurfaceObserver;
+
+    void focus_on(wl_client* client) override;
+
+    /// The area the constraint applies to, in global coordinates
+    /// Empty if the surface is not currently mapped
+    auto surface_region() const -> geom::Rectangles;
+
+    /// The confinement region to apply to the seat, empty if the constraint can not activate
+    virtual auto confinement_for(geom::Rectangles const& region, geom::Point const& cursor) const
+        -> geom::Rectangles = 0;
+    virtual void send_activated() = 0;
+    virtual void send_deactivated() = 0;
+
+    /// Activates the constraint if the cursor (in global coordinates) is within the region
+    void activate(geom::Point const& cursor);
+    void deactivate();
+    /// Re-applies an active constraint after the region or the surface's placement has changed
+    void refresh();
+    /// Releases the seat's confinement and stops following the surface
+    void release();
+
+    PointerConstraintsV1* const manager;
+    WlSurface* const surface;
+    std::shared_ptr<bool> const surface_destroyed;
+    wl_client* const client;
+    bool const oneshot;
+    std::experimental::optional<std::vector<geom::Rectangle>> region; ///< In surface coordinates, unset means the whole surface
+    bool active{false};
+    bool defunct{false};
+    /// Follows the scene surface while active, so the confinement tracks it being moved or resized
+    std::shared_ptr<SurfaceObserver> surface_observer;
+    std::weak_ptr<ms::Surface> observed_surface;
+    std::shared_ptr<bool> const destroyed{std::make_shared<bool>(false)};
+};
+
+class PointerConstraint::SurfaceObserver : public ms::NullSurfaceObserver
+{
+public:
+    SurfaceObserver(std::function<void()>&& on_change)
+        : on_change{std::move(on_change)}
+    {
+    }
+
+    void moved_to(ms::Surface const*, geom::Point const&) override { on_change(); }
+    void window_resized_to(ms::Surface const*, geom::Size const&) override { on_change(); }
+    void content_resized_to(ms::Surface const*, geom::Size const&) override { on_change(); }
+
+private:
+    std::function<void()> const on_change;
+};
+
+class LockedPointerV1 : public wayland::LockedPointerV1, PointerConstraint
+{
+public:
+    LockedPointerV1(
+        wl_resource* new_resource,
+        PointerConstraintsV1* manager,
+        WlSurface* surface,
+        std::experimental::optional<wl_resource*> const& region,
+        uint32_t lifetime);
+
+private:
+    void destroy() override;
+    void set_cursor_position_hint(double surface_x, double surface_y) override;
+    void set_region(std::experimental::optional<wl_resource*> const& region) override;
+
+    auto confinement_for(geom::Rectangles const& region, geom::Point const& cursor) const
+        -> geom::Rectangles override;
+    void send_activated() override { send_locked_event(); }
+    void send_deactivated() override { send_unlocked_event(); }
+};
+
+class ConfinedPointerV1 : public wayland::ConfinedPointerV1, PointerConstraint
+{
+public:
+    ConfinedPointerV1(
+        wl_resource* new_resource,
+        PointerConstraintsV1* manager,
+        WlSurface* surface,
+        std::experimental::optional<wl_resource*> const& region,
+        uint32_t lifetime);
+
+private:
+    void destroy() override;
+    void set_region(std::experimental::optional<wl_resource*> const& region) override;
+
+    auto confinement_for(geom::Rectangles const& region, geom::Point const& cursor) const
+        -> geom::Rectangles override;
+    void send_activated() override { send_confined_event(); }
+    void send_deactivated() override { send_unconfined_event(); }
+};
+}
+}
+
+namespace
+{
+auto region_rectangles(std::experimental::optional<wl_resource*> const& region)
+    -> std::experimental::optional<std::vector<geom::Rectangle>>
+{
+    if (region)
+        return mf::WlRegion::from(region.value())->rectangle_vector();
+    else
+        return std::experimental::nullopt;
+}
+}
+
+auto mf::create_pointer_constraints_v1(struct wl_display* display, WlSeat* seat)
+    -> std::shared_ptr<PointerConstraintsV1>
+{
+    return std::make_shared<PointerConstraintsV1>(display, seat);
+}
+
+// PointerConstraintsV1
+
+mf::PointerConstraintsV1::PointerConstraintsV1(struct wl_display* display, WlSeat* seat)
+    : Global(display, Version<1>()),
+      seat{seat}
+{
+    seat->add_pointer_motion_listener(this);
+}
+
+mf::PointerConstraintsV1::~PointerConstraintsV1()
+{
+    seat->remove_pointer_motion_listener(this);
+}
+
+void mf::PointerConstraintsV1::bind(wl_resource* new_resource)
+{
+    new Instance{new_resource, this};
+}
+
+void mf::PointerConstraintsV1::pointer_moved(WlSurface* window, geometry::Point const& position)
+{
+    if (active_constraint)
+        return;
+
+    for (auto const constraint : constraints)
+    {
+        if (constraint->pointer_moved(window, position))
+            break;
+    }
+}
+
+mf::PointerConstraintsV1::Instance::Instance(wl_resource* new_resource, mf::PointerConstraintsV1* manager)
+    : PointerConstraintsV1(new_resource, Version<1>()),
+      manager{manager}
+{
+}
+
+void mf::PointerConstraintsV1::Instance::destroy()
+{
+    destroy_wayland_object();
+}
+
+auto mf::PointerConstraintsV1::Instance::check_unconstrained(WlSurface* surface) -> bool
+{
+    auto const& constraints = manager->constraints;
+
+    if (std::any_of(
+        constraints.begin(),
+        constraints.end(),
+        [surface](PointerConstraint* constraint) { return constraint->constrains(surface); }))
+    {
+        wl_resource_post_error(
+            resource,
+            Error::already_constrained,
+            "Surface already has a pointer constraint");
+        return false;
+    }
+
+    return true;
+}
+
+void mf::PointerConstraintsV1::Instance::lock_pointer(
+    wl_resource* id,
+    wl_resource* surface,
+    wl_resource* /*pointer*/,
+    std::experimental::optional<wl_resource*> const& region,
+    uint32_t lifetime)
+{
+    auto const wl_surface = WlSurface::from(surface);
+    if (check_unconstrained(wl_surface))
+        new LockedPointerV1{id, manager, wl_surface, region, lifetime};
+}
+
+void mf::PointerConstraintsV1::Instance::confine_pointer(
+    wl_resource* id,
+    wl_resource* surface,
+    wl_resource* /*pointer*/,
+    std::experimental::optional<wl_resource*> const& region,
+    uint32_t lifetime)
+{
+    auto const wl_surface = WlSurface::from(surface);
+    if (check_unconstrained(wl_surface))
+        new ConfinedPointerV1{id, manager, wl_surface, region, lifetime};
+}
+
+// PointerConstraint
+
+mf::PointerConstraint::PointerConstraint(
+    PointerConstraintsV1* manager,
+    WlSurface* surface,
+    std::experimental::optional<wl_resource*> const& region,
+    uint32_t lifetime)
+    : seat{manager->seat},
+      manager{manager},
+      surface{surface},
+      surface_destroyed{surface->destroyed_flag()},
+      client{surface->client},
+      oneshot{lifetime != mw::PointerConstraintsV1::Lifetime::persistent},
+      region{region_rectangles(region)}
+{
+}
+
+mf::PointerConstraint::~PointerConstraint()
+{
+    *destroyed = true;
+    end();
+    if (!*surface_destroyed)
+        surface->remove_destroy_listener(this);
+    seat->remove_focus_listener(this);
+    auto& constraints = manager->constraints;
+    constraints.erase(std::remove(constraints.begin(), constraints.end(), this), constraints.end());
+}
+
+void mf::PointerConstraint::start()
+{
+    manager->constraints.push_back(this);
+    seat->add_focus_listener(this);
+    surface->add_destroy_listener(
+        this,
+        [this]()
+        {
+            deactivate();
+            defunct = true;
+        });
+    focus_on(seat->current_focus());
+}
+
+auto mf::PointerConstraint::pointer_moved(WlSurface* window, geom::Point const& position) -> bool
+{
+    if (active || defunct || *surface_destroyed || window->client != client)
+        return active;
+
+    auto const window_surface = window->scene_surface();
+    if (!window_surface || window_surface != surface->scene_surface())
+        return false;
+
+    activate(window_surface.value()->input_bounds().top_left + as_displacement(position));
+    return active;
+}
+
+void mf::PointerConstraint::update_region(std::experimental::optional<wl_resource*> const& region)
+{
+    this->region = region_rectangles(region);
+    refresh();
+}
+
+void mf::PointerConstraint::refresh()
+{
+    if (!active)
+        return;
+
+    auto const confinement = confinement_for(surface_region(), seat->cursor_position());
+    if (confinement.size() > 0)
+        seat->set_confinement_regions(confinement);
+    else
+        deactivate();
+}
+
+void mf::PointerConstraint::end()
+{
+    if (active)
+    {
+        release();
+        active = false;
+    }
+    defunct = true;
+}
+
+void mf::PointerConstraint::focus_on(wl_client* focus)
+{
+    if (focus == client)
+        activate(seat->cursor_position());
+    else
+        deactivate();
+}
+
+auto mf::PointerConstraint::surface_region() const -> geom::Rectangles
+{
+    if (*surface_destroyed)
+        return {};
+
+    auto const scene_surface = surface->scene_surface();
+    if (!scene_surface)
+        return {};
+
+    auto const input_bounds = scene_surface.value()->input_bounds();
+    auto const origin = input_bounds.top_left + surface->total_offset();
+    geom::Rectangle const surface_rect{origin, surface->buffer_size().value_or(geom::Size{})};
+
+    geom::Rectangles result;
+    for (auto rect : region.value_or(std::vector<geom::Rectangle>{{{}, surface_rect.size}}))
+    {
+        rect.top_left = rect.top_left + as_displacement(origin);
+        rect = rect.intersection_with(surface_rect).intersection_with(input_bounds);
+        if (rect.size != geom::Size{})
+            result.add(rect);
+    }
+    return result;
+}
+
+void mf::PointerConstraint::activate(geom::Point const& cursor)
+{
+    if (active || defunct || manager->active_constraint || seat->current_focus() != client)
+        return;
+
+    auto const region = surface_region();
+    if (std::none_of(region.begin(), region.end(), [&](geom::Rectangle const& rect) { return rect.contains(cursor); }))
+        return;
+
+    auto const confinement = confinement_for(region, cursor);
+    if (confinement.size() == 0)
+        return;
+
+    seat->set_confinement_regions(confinement);
+    manager->active_constraint = this;
+    active = true;
+
+    if (auto const scene_surface = surface->scene_surface())
+    {
+        surface_observer = std::make_shared<SurfaceObserver>(
+            [seat = seat, destroyed = destroyed, this]
+            {
+                // Scene observers are notified on whichever thread changed the surface
+                seat->spawn(run_unless(destroyed, [this] { refresh(); }));
+            });
+        observed_surface = scene_surface.value();
+        scene_surface.value()->add_observer(surface_observer);
+    }
+
+    send_activated();
+}
+
+void mf::PointerConstraint::deactivate()
+{
+    if (!active)
+        return;
+
+    release();
+    active = false;
+    defunct = oneshot;
+    send_deactivated();
+}
+
+void mf::PointerConstraint::release()
+{
+    seat->reset_confinement_regions();
+    if (manager->active_constraint == this)
+        manager->active_constraint = nullptr;
+
+    if (auto const scene_surface = observed_surface.lock())
+        scene_surface->remove_observer(surface_observer);
+    surface_observer.reset();
+    observed_surface.reset();
+}
+
+// LockedPointerV1
+
+mf::LockedPointerV1::LockedPointerV1(
+    wl_resource* new_resource,
+    PointerConstraintsV1* manager,
+    WlSurface* surface,
+    std::experimental::optional<wl_resource*> const& region,
+    uint32_t lifetime)
+    : wayland::LockedPointerV1(new_resource, Version<1>()),
+      PointerConstraint(manager, surface, region, lifetime)
+{
+    start();
+}
+
+void mf::LockedPointerV1::destroy()
+{
+    end();
+    destroy_wayland_object();
+}
+
+void mf::LockedPointerV1::set_cursor_position_hint(double /*surface_x*/, double /*surface_y*/)
+{
+    // The cursor is not moved while locked, so there is never anything to warp on unlock
+}
+
+void mf::LockedPointerV1::set_region(std::experimental::optional<wl_resource*> const& region)
+{
+    update_region(region);
+}
+
+auto mf::LockedPointerV1::confinement_for(geom::Rectangles const& region, geom::Point const& cursor) const
+    -> geom::Rectangles
+{
+    // Confining the cursor to a single pixel pins it in place: the seat still reports the device's
+    // relative motion, but the absolute position (and so hit-testing and cursor rendering) is unchanged.
+    // If the surface moves out from under the pinned cursor the lock is lost.
+    if (std::none_of(region.begin(), region.end(), [&](geom::Rectangle const& rect) { return rect.contains(cursor); }))
+        return {};
+
+    return geom::Rectangles{{cursor, geom::Size{1, 1}}};
+}
+
+// ConfinedPointerV1
+
+mf::ConfinedPointerV1::ConfinedPointerV1(
+    wl_resource* new_resource,
+    PointerConstraintsV1* manager,
+    WlSurface* surface,
+    std::experimental::optional<wl_resource*> const& region,
+    uint32_t lifetime)
+    : wayland::ConfinedPointerV1(new_resource, Version<1>()),
+      PointerConstraint(manager, surface, region, lifetime)
+{
+    start();
+}
+
+void mf::ConfinedPointerV1::destroy()
+{
+    end();
+    destroy_wayland_object();
+}
+
+void mf::ConfinedPointerV1::set_region(std::experimental::optional<wl_resource*> const& region)
+{
+    update_region(region);
+}
+
+auto mf::ConfinedPointerV1::confinement_for(geom::Rectangles const& region, geom::Point const& /*cursor*/) const
+    -> geom::Rectangles
+{
+    return region;
+}
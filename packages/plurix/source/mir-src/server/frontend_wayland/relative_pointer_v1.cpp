@@ -0,0 +1,167 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "relative_pointer_v1.h"
+
+#include "relative-pointer-unstable-v1_wrapper.h"
+#include "wl_pointer.h"
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+namespace mw = mir::wayland;
+
+namespace mir
+{
+namespace frontend
+{
+
+class RelativePointerManagerV1 : public wayland::RelativePointerManagerV1::Global
+{
+public:
+    RelativePointerManagerV1(struct wl_display* display);
+
+private:
+    class Instance : public wayland::RelativePointerManagerV1
+    {
+    public:
+        Instance(wl_resource* new_resource);
+
+    private:
+        void destroy() override;
+        void get_relative_pointer(wl_resource* id, wl_resource* pointer) override;
+    };
+
+    void bind(wl_resource* new_resource) override;
+};
+
+class RelativePointerV1 : public wayland::RelativePointerV1
+{
+public:
+    RelativePointerV1(wl_resource* new_resource, RelativePointerListeners& source);
+    ~RelativePointerV1();
+
+    void send_relative_motion(
+        std::chrono::nanoseconds timestamp,
+        double dx, double dy,
+        double dx_unaccel, double dy_unaccel) const;
+
+    /// Called when the wl_pointer goes away, after which this object is inert
+    void detach();
+
+private:
+    void destroy() override;
+
+    RelativePointerListeners* source; ///< null once the wl_pointer has been destroyed
+};
+
+}
+}
+
+auto mf::create_relative_pointer_manager_v1(struct wl_display* display)
+    -> std::shared_ptr<RelativePointerManagerV1>
+{
+    return std::make_shared<RelativePointerManagerV1>(display);
+}
+
+// RelativePointerListeners
+
+mf::RelativePointerListeners::~RelativePointerListeners()
+{
+    for (auto const listener : listeners)
+        listener->detach();
+}
+
+void mf::RelativePointerListeners::add(RelativePointerV1* listener)
+{
+    listeners.push_back(listener);
+}
+
+void mf::RelativePointerListeners::remove(RelativePointerV1* listener)
+{
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void mf::RelativePointerListeners::send(
+    std::chrono::nanoseconds timestamp,
+    double dx, double dy,
+    double dx_unaccel, double dy_unaccel) const
+{
+    for (auto const listener : listeners)
+        listener->send_relative_motion(timestamp, dx, dy, dx_unaccel, dy_unaccel);
+}
+
+// RelativePointerManagerV1
+
+mf::RelativePointerManagerV1::RelativePointerManagerV1(struct wl_display* display)
+    : Global(display, Version<1>())
+{
+}
+
+void mf::RelativePointerManagerV1::bind(wl_resource* new_resource)
+{
+    new Instance{new_resource};
+}
+
+mf::RelativePointerManagerV1::Instance::Instance(wl_resource* new_resource)
+    : RelativePointerManagerV1(new_resource, Version<1>())
+{
+}
+
+void mf::RelativePointerManagerV1::Instance::destroy()
+{
+    destroy_wayland_object();
+}
+
+void mf::RelativePointerManagerV1::Instance::get_relative_pointer(wl_resource* id, wl_resource* pointer)
+{
+    new RelativePointerV1{id, WlPointer::from(pointer)->relative_pointer_listeners()};
+}
+
+// RelativePointerV1
+
+mf::RelativePointerV1::RelativePointerV1(wl_resource* new_resource, RelativePointerListeners& source)
+    : wayland::RelativePointerV1(new_resource, Version<1>()),
+      source{&source}
+{
+    source.add(this);
+}
+
+mf::RelativePointerV1::~RelativePointerV1()
+{
+    if (source)
+        source->remove(this);
+}
+
+void mf::RelativePointerV1::send_relative_motion(
+    std::chrono::nanoseconds timestamp,
+    double dx, double dy,
+    double dx_unaccel, double dy_unaccel) const
+{
+    auto const utime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timestamp).count());
+
+    send_relative_motion_event(utime >> 32, utime & 0xffffffff, dx, dy, dx_unaccel, dy_unaccel);
+}
+
+void mf::RelativePointerV1::detach()
+{
+    source = nullptr;
+}
+
+void mf::RelativePointerV1::destroy()
+{
+    destroy_wayland_object();
+}
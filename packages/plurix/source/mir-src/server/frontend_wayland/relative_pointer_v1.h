@@ -0,0 +1,64 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_RELATIVE_POINTER_V1_H
+#define MIR_FRONTEND_RELATIVE_POINTER_V1_H
+
+#include <memory>
+#include <vector>
+#include <chrono>
+
+struct wl_display;
+
+namespace mir
+{
+namespace frontend
+{
+class RelativePointerManagerV1;
+class RelativePointerV1;
+
+auto create_relative_pointer_manager_v1(struct wl_display* display)
+    -> std::shared_ptr<RelativePointerManagerV1>;
+
+/// The zwp_relative_pointer_v1 objects created for a single wl_pointer
+/// Should only be used from the Wayland thread
+class RelativePointerListeners
+{
+public:
+    RelativePointerListeners() = default;
+    ~RelativePointerListeners();
+
+    void add(RelativePointerV1* listener);
+    void remove(RelativePointerV1* listener);
+
+    auto empty() const -> bool { return listeners.empty(); }
+
+    /// Sends the motion to every listener, it is up to the caller to follow it with a wl_pointer.frame
+    void send(
+        std::chrono::nanoseconds timestamp,
+        double dx, double dy,
+        double dx_unaccel, double dy_unaccel) const;
+
+private:
+    RelativePointerListeners(RelativePointerListeners const&) = delete;
+    RelativePointerListeners& operator=(RelativePointerListeners const&) = delete;
+
+    std::vector<RelativePointerV1*> listeners;
+};
+}
+}
+
+#endif // MIR_FRONTEND_RELATIVE_POINTER_V1_H
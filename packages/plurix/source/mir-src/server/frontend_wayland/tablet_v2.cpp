@@ -0,0 +1,348 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tablet_v2.h"
+
+#include "wl_seat.h"
+#include "wl_surface.h"
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Don't hold samples back for longer than this waiting for the client to draw
+auto const max_sample_delay = 50ms;
+}
+
+namespace mir
+{
+namespace frontend
+{
+
+class TabletManagerV2 : public wayland::TabletManagerV2::Global
+{
+public:
+    TabletManagerV2(struct wl_display* display);
+
+private:
+    class Instance : public wayland::TabletManagerV2
+    {
+    public:
+        Instance(wl_resource* new_resource);
+
+    private:
+        void get_tablet_seat(wl_resource* tablet_seat, wl_resource* seat) override;
+        void destroy() override;
+    };
+
+    void bind(wl_resource* new_resource) override;
+};
+
+/// Announces a single tablet and tool, which stand for every pen device on the seat, while the seat has any
+class TabletSeatV2 : public wayland::TabletSeatV2, WlSeat::TabletListener
+{
+public:
+    TabletSeatV2(wl_resource* new_resource, WlSeat& seat);
+    ~TabletSeatV2();
+
+private:
+    void destroy() override;
+    void pen_devices_changed(bool any) override;
+
+    WlSeat& seat;
+    std::function<void()> const remove_tablet_listener;
+
+    TabletV2* tablet{nullptr};
+    std::shared_ptr<bool> tablet_destroyed;
+    TabletToolV2* tool{nullptr};
+    std::shared_ptr<bool> tool_destroyed;
+};
+
+class TabletV2 : public wayland::TabletV2
+{
+public:
+    TabletV2(wayland::TabletSeatV2 const& parent);
+    ~TabletV2();
+
+    auto destroyed_flag() const -> std::shared_ptr<bool> { return destroyed; }
+
+private:
+    void destroy() override;
+
+    std::shared_ptr<bool> const destroyed;
+};
+
+}
+}
+
+auto mf::create_tablet_manager_v2(struct wl_display* display) -> std::shared_ptr<TabletManagerV2>
+{
+    return std::make_shared<TabletManagerV2>(display);
+}
+
+// TabletManagerV2
+
+mf::TabletManagerV2::TabletManagerV2(struct wl_display* display)
+    : Global(display, Version<1>())
+{
+}
+
+void mf::TabletManagerV2::bind(wl_resource* new_resource)
+{
+    new Instance{new_resource};
+}
+
+mf::TabletManagerV2::Instance::Instance(wl_resource* new_resource)
+    : TabletManagerV2(new_resource, Version<1>())
+{
+}
+
+void mf::TabletManagerV2::Instance::get_tablet_seat(wl_resource* tablet_seat, wl_resource* seat)
+{
+    new TabletSeatV2{tablet_seat, *WlSeat::from(seat)};
+}
+
+void mf::TabletManagerV2::Instance::destroy()
+{
+    destroy_wayland_object();
+}
+
+// TabletSeatV2
+
+mf::TabletSeatV2::TabletSeatV2(wl_resource* new_resource, WlSeat& seat)
+    : wayland::TabletSeatV2(new_resource, Version<1>()),
+      seat{seat},
+      remove_tablet_listener{seat.add_tablet_listener(this)}
+{
+    if (seat.has_pen_devices())
+        pen_devices_changed(true);
+}
+
+mf::TabletSeatV2::~TabletSeatV2()
+{
+    remove_tablet_listener();
+}
+
+void mf::TabletSeatV2::destroy()
+{
+    destroy_wayland_object();
+}
+
+void mf::TabletSeatV2::pen_devices_changed(bool any)
+{
+    if (any)
+    {
+        tablet = new TabletV2{*this};
+        tablet_destroyed = tablet->destroyed_flag();
+        send_tablet_added_event(tablet->resource);
+        tablet->send_name_event("Mir tablet");
+        tablet->send_done_event();
+
+        tool = new TabletToolV2{*this, tablet, seat};
+        tool_destroyed = tool->destroyed_flag();
+        send_tool_added_event(tool->resource);
+        tool->send_type_event(TabletToolV2::Type::pen);
+        tool->send_capability_event(TabletToolV2::Capability::pressure);
+        tool->send_done_event();
+    }
+    else
+    {
+        // The client destroys the objects once it has seen them removed
+        if (tool && !*tool_destroyed)
+            tool->removed(std::chrono::steady_clock::now().time_since_epoch());
+        if (tablet && !*tablet_destroyed)
+            tablet->send_removed_event();
+
+        tool = nullptr;
+        tool_destroyed.reset();
+        tablet = nullptr;
+        tablet_destroyed.reset();
+    }
+}
+
+// TabletV2
+
+mf::TabletV2::TabletV2(wayland::TabletSeatV2 const& parent)
+    : wayland::TabletV2(parent),
+      destroyed{std::make_shared<bool>(false)}
+{
+}
+
+mf::TabletV2::~TabletV2()
+{
+    *destroyed = true;
+}
+
+void mf::TabletV2::destroy()
+{
+    destroy_wayland_object();
+}
+
+// TabletToolV2
+
+mf::TabletToolV2::TabletToolV2(wayland::TabletSeatV2 const& parent, TabletV2* tablet, WlSeat& seat)
+    : wayland::TabletToolV2(parent),
+      remove_listener{seat.add_listener(client, this)},
+      destroyed{std::make_shared<bool>(false)},
+      tablet{tablet},
+      tablet_destroyed{tablet->destroyed_flag()},
+      held_samples{
+          client,
+          max_sample_delay,
+          [this](WlSurface*, std::chrono::nanoseconds) { send_unsent_samples(); }}
+{
+}
+
+mf::TabletToolV2::~TabletToolV2()
+{
+    *destroyed = true;
+    if (listening)
+        remove_listener();
+}
+
+void mf::TabletToolV2::down(
+    std::chrono::nanoseconds timestamp,
+    WlSurface* parent,
+    float x, float y,
+    float pressure)
+{
+    // proximity_in has to name the tablet, so there's nothing we can send once the client has destroyed it
+    if (*tablet_destroyed)
+        return;
+
+    auto const final = parent->transform_point(geometry::Point{x, y});
+    auto const serial = wl_display_next_serial(wl_client_get_display(client));
+
+    parent_surface = parent;
+    parent_surface_destroyed = parent->destroyed_flag();
+    focused_surface = final.surface;
+    focused_surface_destroyed = final.surface->destroyed_flag();
+    // A frame callback registered on a previous surface may never come
+    held_samples.reset();
+
+    send_proximity_in_event(serial, tablet->resource, final.surface->raw_resource());
+    send_down_event(serial);
+    send_sample(sample_at(timestamp, x, y, pressure));
+}
+
+void mf::TabletToolV2::motion(
+    std::chrono::nanoseconds timestamp,
+    float x, float y,
+    float pressure)
+{
+    if (!focused_surface || *focused_surface_destroyed || *parent_surface_destroyed)
+        return;
+
+    auto const sample = sample_at(timestamp, x, y, pressure);
+
+    if (!focused_surface->awaiting_frame())
+    {
+        // The client isn't drawing (or is hidden): there's no frame to batch for
+        held_samples.reset();
+        send_unsent_samples();
+        send_sample(sample);
+        return;
+    }
+
+    // Pen hardware samples far faster than clients draw: rather than waking the client for each
+    // sample, the whole stroke since the last frame reaches it together, just before the next one
+    // (or once the first of them has been held for max_sample_delay, if the client is slow)
+    unsent_samples.push_back(sample);
+    held_samples.hold_for(focused_surface);
+}
+
+void mf::TabletToolV2::up(std::chrono::nanoseconds timestamp)
+{
+    if (!focused_surface)
+        return;
+
+    // The client should see the whole stroke before it ends
+    held_samples.reset();
+    send_unsent_samples();
+
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+
+    send_up_event();
+    if (!*focused_surface_destroyed)
+        send_proximity_out_event();
+    send_frame_event(ms.count());
+
+    parent_surface = nullptr;
+    parent_surface_destroyed.reset();
+    focused_surface = nullptr;
+    focused_surface_destroyed.reset();
+}
+
+void mf::TabletToolV2::removed(std::chrono::nanoseconds timestamp)
+{
+    up(timestamp);
+    send_removed_event();
+
+    if (listening)
+    {
+        listening = false;
+        remove_listener();
+    }
+}
+
+auto mf::TabletToolV2::sample_at(std::chrono::nanoseconds timestamp, float x, float y, float pressure) const -> Sample
+{
+    // The same translation parent->transform_point() applies, but to the surface that has the stroke
+    // (which needn't be the topmost at this position), and without rounding
+    auto const offset =
+        focused_surface->total_offset() - parent_surface->total_offset() + parent_surface->offset();
+
+    return {timestamp, double(x) - offset.dx.as_int(), double(y) - offset.dy.as_int(), pressure};
+}
+
+void mf::TabletToolV2::send_sample(Sample const& sample)
+{
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(sample.time);
+
+    send_motion_event(sample.x, sample.y);
+    send_pressure_event(static_cast<uint32_t>(std::min(std::max(sample.pressure, 0.0f), 1.0f) * 65535));
+    send_frame_event(ms.count());
+}
+
+void mf::TabletToolV2::send_unsent_samples()
+{
+    std::vector<Sample> samples;
+    samples.swap(unsent_samples);
+
+    if (!focused_surface || *focused_surface_destroyed)
+        return;
+
+    for (auto const& sample : samples)
+        send_sample(sample);
+}
+
+void mf::TabletToolV2::set_cursor(
+    uint32_t /*serial*/,
+    std::experimental::optional<struct wl_resource*> const& /*surface*/,
+    int32_t /*hotspot_x*/,
+    int32_t /*hotspot_y*/)
+{
+    // The tool is only seen in contact, where no cursor is shown
+}
+
+void mf::TabletToolV2::destroy()
+{
+    destroy_wayland_object();
+}
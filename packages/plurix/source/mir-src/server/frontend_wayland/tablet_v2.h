@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_TABLET_V2_H
+#define MIR_FRONTEND_TABLET_V2_H
+
+#include "tablet-unstable-v2_wrapper.h"
+#include "frame_aligned_input.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mir
+{
+namespace frontend
+{
+class TabletManagerV2;
+class TabletV2;
+class WlSeat;
+class WlSurface;
+
+auto create_tablet_manager_v2(struct wl_display* display) -> std::shared_ptr<TabletManagerV2>;
+
+/// The pen of the seat's tablets, as seen by one client
+/// Mir delivers a tablet tool in contact as a stylus touch, so this only sees the tool while it is down.
+/// Positions are in the coordinates of the parent surface the stylus went down on, and keep the
+/// fractional part the device reported.
+class TabletToolV2 : public wayland::TabletToolV2
+{
+public:
+    TabletToolV2(
+        wayland::TabletSeatV2 const& parent,
+        TabletV2* tablet,
+        WlSeat& seat);
+    ~TabletToolV2();
+
+    auto destroyed_flag() const -> std::shared_ptr<bool> { return destroyed; }
+
+    void down(
+        std::chrono::nanoseconds timestamp,
+        WlSurface* parent,
+        float x, float y,
+        float pressure);
+    void motion(
+        std::chrono::nanoseconds timestamp,
+        float x, float y,
+        float pressure);
+    void up(std::chrono::nanoseconds timestamp);
+
+    /// The seat has no pen devices any more: ends any stroke, and stops listening to the seat
+    void removed(std::chrono::nanoseconds timestamp);
+
+private:
+    struct Sample
+    {
+        std::chrono::nanoseconds time;
+        double x, y;
+        float pressure;
+    };
+
+    std::function<void()> const remove_listener;
+    bool listening{true};
+    std::shared_ptr<bool> const destroyed;
+
+    TabletV2* const tablet;
+    std::shared_ptr<bool> const tablet_destroyed;
+
+    /// The surface the stroke's positions are relative to, and the one (it or a subsurface) it was delivered to
+    WlSurface* parent_surface{nullptr};
+    std::shared_ptr<bool> parent_surface_destroyed;
+    WlSurface* focused_surface{nullptr};
+    std::shared_ptr<bool> focused_surface_destroyed;
+
+    /// Samples held back while the focused surface is drawing, sent together just before its next frame
+    /// (or when held_samples' deadline passes)
+    std::vector<Sample> unsent_samples;
+    FrameAlignedInput held_samples;
+
+    auto sample_at(std::chrono::nanoseconds timestamp, float x, float y, float pressure) const -> Sample;
+    void send_sample(Sample const& sample);
+    void send_unsent_samples();
+
+    void set_cursor(
+        uint32_t serial,
+        std::experimental::optional<struct wl_resource*> const& surface,
+        int32_t hotspot_x,
+        int32_t hotspot_y) override;
+    void destroy() override;
+};
+}
+}
+
+#endif // MIR_FRONTEND_TABLET_V2_H
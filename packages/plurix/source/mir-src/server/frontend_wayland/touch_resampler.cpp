@@ -0,0 +1,60 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "touch_resampler.h"
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+
+using namespace std::chrono_literals;
+
+std::chrono::nanoseconds const mf::TouchResampler::max_extrapolation{8ms};
+
+void mf::TouchResampler::add(Sample const& sample)
+{
+    if (current && sample.time <= current->time)
+        return;
+
+    previous = current;
+    current = sample;
+}
+
+auto mf::TouchResampler::resample_at(std::chrono::nanoseconds time) const -> std::experimental::optional<Sample>
+{
+    if (!current)
+        return std::experimental::nullopt;
+
+    if (!previous)
+        return current;
+
+    if (time <= previous->time)
+        return previous;
+
+    auto const interval = current->time - previous->time;
+
+    // Don't extrapolate by more than half the sampling interval: beyond that
+    // the estimate is more likely to overshoot than to help
+    auto const limit = std::min(max_extrapolation, interval/2);
+    auto const target = std::min(time, current->time + limit);
+
+    float const alpha = std::chrono::duration<float>(target - previous->time) / std::chrono::duration<float>(interval);
+
+    return Sample{
+        target,
+        previous->x + alpha*(current->x - previous->x),
+        previous->y + alpha*(current->y - previous->y)};
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_TOUCH_RESAMPLER_H
+#define MIR_FRONTEND_TOUCH_RESAMPLER_H
+
+#include <chrono>
+#include <experimental/optional>
+
+namespace mir
+{
+namespace frontend
+{
+/// Estimates where a single touch contact is at a given time from its two most recent samples.
+/// Interpolates when the time falls between them, and extrapolates (a limited distance) beyond the latest.
+class TouchResampler
+{
+public:
+    struct Sample
+    {
+        std::chrono::nanoseconds time;
+        float x;
+        float y;
+    };
+
+    /// Samples older than the latest are ignored
+    void add(Sample const& sample);
+
+    auto latest() const -> std::experimental::optional<Sample> { return current; }
+
+    /// \returns the estimated sample at time, or nullopt if there haven't been any samples
+    auto resample_at(std::chrono::nanoseconds time) const -> std::experimental::optional<Sample>;
+
+    /// How far beyond the latest sample we're prepared to guess
+    static std::chrono::nanoseconds const max_extrapolation;
+
+private:
+    std::experimental::optional<Sample> previous;
+    std::experimental::optional<Sample> current;
+};
+}
+}
+
+#endif // MIR_FRONTEND_TOUCH_RESAMPLER_H
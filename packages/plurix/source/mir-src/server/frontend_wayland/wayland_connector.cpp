@@ -64,11 +64,18 @@
 
 #include <system_error>
 #include <sys/eventfd.h>
+#include <sys/file.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <wayland-server-core.h>
 #include <unordered_map>
 #include <boost/throw_exception.hpp>
+#include <climits>
 
+#include <fstream>
 #include <functional>
+#include <thread>
 #include <type_traits>
 
 #include <xkbcommon/xkbcommon.h>
@@ -617,6 +624,39 @@ std::shared_ptr<mg::WaylandAllocator> allocator_for_display(
      */
     return std::make_shared<ThrowingAllocator>();
 }
+
+/// The program process pid is running, or an empty string if that can't be found
+auto executable_of(pid_t pid) -> std::string
+{
+    char path[PATH_MAX];
+    auto const length = readlink(("/proc/" + std::to_string(pid) + "/exe").c_str(), path, sizeof path);
+    if (length <= 0 || length == sizeof path)
+        return {};
+
+    return {path, static_cast<size_t>(length)};
+}
+
+/// Whether process pid has loaded a library that renders with the GPU
+bool may_use_gpu(pid_t pid)
+{
+    static char const* const gpu_libraries[] = {
+        "/libEGL", "/libGL.", "/libGLX", "/libGLES", "/libvulkan", "/libwayland-egl", "/libgbm"};
+
+    std::ifstream maps{"/proc/" + std::to_string(pid) + "/maps"};
+    if (!maps)
+        return true;    // If we can't tell, it's safest to assume it will
+
+    for (std::string line; std::getline(maps, line);)
+    {
+        for (auto const library : gpu_libraries)
+        {
+            if (line.find(library) != std::string::npos)
+                return true;
+        }
+    }
+
+    return false;
+}
 }
 
 auto mf::create_wl_shell(wl_display* display, std::shared_ptr<msh::Shell> const& shell, WlSeat* seat, OutputManager* const output_manager)
@@ -625,24 +665,43 @@ auto mf::create_wl_shell(wl_display* display, std::shared_ptr<msh::Shell> const&
     return std::make_shared<mf::WlShell>(display, shell, *seat, output_manager);
 }
 
-void mf::WaylandExtensions::init(wl_display* display, std::shared_ptr<msh::Shell> const& shell, WlSeat* seat, OutputManager* const output_manager)
+void mf::WaylandExtensions::build(
+    wl_display* display,
+    std::function<void(std::function<void()>&& work)> const& run_on_wayland_mainloop)
+{
+    current_display = display;
+    run_builders(display, run_on_wayland_mainloop);
+    current_display = nullptr;
+}
+
+void mf::WaylandExtensions::init(
+    wl_display* display,
+    std::shared_ptr<msh::Shell> const& shell,
+    WlSeat* seat,
+    OutputManager* const output_manager)
 {
+    current_display = display;
     custom_extensions(display, shell, seat, output_manager);
+    current_display = nullptr;
 }
 
 void mf::WaylandExtensions::add_extension(std::string const name, std::shared_ptr<void> implementation)
 {
-    extension_protocols[std::move(name)] = std::move(implementation);
+    extension_protocols[current_display][std::move(name)] = std::move(implementation);
 }
 
 void mf::WaylandExtensions::custom_extensions(wl_display*, std::shared_ptr<msh::Shell> const&, WlSeat*, OutputManager* const)
 {
 }
 
-auto mir::frontend::WaylandExtensions::get_extension(std::string const& name) const -> std::shared_ptr<void>
+auto mir::frontend::WaylandExtensions::get_extension(wl_display* display, std::string const& name) const -> std::shared_ptr<void>
 {
-    auto const result = extension_protocols.find(name);
-    if (result != end(extension_protocols))
+    auto const extensions = extension_protocols.find(display);
+    if (extensions == end(extension_protocols))
+        return {};
+
+    auto const result = extensions->second.find(name);
+    if (result != end(extensions->second))
         return result->second;
 
     return {};
@@ -652,6 +711,400 @@ void mf::WaylandExtensions::run_builders(wl_display*, std::function<void(std::fu
 {
 }
 
+/**
+ * Learns which programs attach GPU buffers, so the clients of those that never do can join any display.
+ *
+ * A client has to be given to a display before it has sent anything. Clients of programs not yet
+ * seen join the primary if the process has mapped a GPU client library (as most toolkits have,
+ * whether or not they go on to use it). Once a client on the primary has attached shm buffers and
+ * disconnected without attaching a GPU buffer, later clients of that program may join any display;
+ * once one has attached a GPU buffer, they always join the primary.
+ *
+ * Only accessed on the primary's event loop.
+ */
+class mf::WaylandConnector::GpuClients
+{
+public:
+    bool need_primary(pid_t pid, std::string const& executable) const
+    {
+        auto const known = uses_gpu.find(executable);
+        if (known != uses_gpu.end())
+            return known->second;
+
+        return may_use_gpu(pid);
+    }
+
+    /// Watches the buffers client attaches, to learn about executable
+    void track(wl_client* client, std::string const& executable)
+    {
+        if (executable.empty())
+            return;
+
+        auto const tracked = new Tracked{{}, this, executable, false, false};
+        tracked->destroy_listener.notify = &client_destroyed;
+        wl_client_add_destroy_listener(client, &tracked->destroy_listener);
+    }
+
+    /// Wraps the primary's allocator, to see the buffers tracked clients attach
+    auto track_buffers(std::shared_ptr<mg::WaylandAllocator> const& allocator) -> std::shared_ptr<mg::WaylandAllocator>
+    {
+        return std::make_shared<TrackingAllocator>(allocator, this);
+    }
+
+private:
+    struct Tracked
+    {
+        wl_listener destroy_listener;
+        GpuClients* const self;
+        std::string const executable;
+        bool attached_shm;
+        bool attached_gpu;
+    };
+
+    static_assert(
+        std::is_standard_layout<Tracked>::value,
+        "Tracked must be standard layout for wl_container_of to be defined behaviour");
+
+    class TrackingAllocator : public mg::WaylandAllocator
+    {
+    public:
+        TrackingAllocator(std::shared_ptr<mg::WaylandAllocator> const& allocator, GpuClients* self)
+            : allocator{allocator},
+              self{self}
+        {
+        }
+
+        void bind_display(wl_display* display, std::shared_ptr<mir::Executor> executor) override
+        {
+            allocator->bind_display(display, std::move(executor));
+        }
+
+        std::shared_ptr<mir::graphics::Buffer> buffer_from_resource(
+            wl_resource* buffer,
+            std::function<void()>&& on_consumed,
+            std::function<void()>&& on_release) override
+        {
+            if (auto const tracked = tracked_for(wl_resource_get_client(buffer)))
+            {
+                if (!tracked->attached_gpu)
+                {
+                    tracked->attached_gpu = true;
+                    self->uses_gpu[tracked->executable] = true;
+                }
+            }
+            return allocator->buffer_from_resource(buffer, std::move(on_consumed), std::move(on_release));
+        }
+
+        auto buffer_from_shm(
+            wl_resource* buffer,
+            std::shared_ptr<mir::Executor> wayland_executor,
+            std::function<void()>&& on_consumed)
+            -> std::shared_ptr<mir::graphics::Buffer> override
+        {
+            if (auto const tracked = tracked_for(wl_resource_get_client(buffer)))
+                tracked->attached_shm = true;
+
+            return allocator->buffer_from_shm(buffer, std::move(wayland_executor), std::move(on_consumed));
+        }
+
+    private:
+        std::shared_ptr<mg::WaylandAllocator> const allocator;
+        GpuClients* const self;
+    };
+
+    static auto tracked_for(wl_client* client) -> Tracked*
+    {
+        auto const listener = wl_client_get_destroy_listener(client, &client_destroyed);
+        if (!listener)
+            return nullptr;
+
+        Tracked* tracked;
+        return wl_container_of(listener, tracked, destroy_listener);
+    }
+
+    static void client_destroyed(wl_listener* listener, void* /*data*/)
+    {
+        Tracked* tracked;
+        tracked = wl_container_of(listener, tracked, destroy_listener);
+
+        // A client that attached nothing (or was disconnected early) teaches us nothing
+        if (tracked->attached_shm && !tracked->attached_gpu)
+            tracked->self->uses_gpu.emplace(tracked->executable, false);
+
+        wl_list_remove(&tracked->destroy_listener.link);
+        delete tracked;
+    }
+
+    std::unordered_map<std::string, bool> uses_gpu;
+};
+
+class mf::WaylandConnector::Shard : WlSeat::ListenerTracker
+{
+public:
+    Shard(
+        WaylandConnector* connector,
+        std::string const& thread_name,
+        bool primary,
+        std::shared_ptr<MirDisplay> const& display_config,
+        std::shared_ptr<mi::InputDeviceHub> const& input_hub,
+        std::shared_ptr<mi::Seat> const& seat,
+        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<mf::SessionAuthorizer> const& session_authorizer,
+        bool touch_resampling)
+        : connector{connector},
+          thread_name{thread_name},
+          primary{primary},
+          display{wl_display_create(), &cleanup_display},
+          pause_signal{eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)},
+          executor{std::make_shared<WaylandExecutor>(wl_display_get_event_loop(display.get()))},
+          allocator{primary ?
+              connector->gpu_clients->track_buffers(allocator_for_display(allocator, display.get(), executor)) :
+              std::shared_ptr<mg::WaylandAllocator>{std::make_shared<ThrowingAllocator>()}}
+    {
+        if (pause_signal == mir::Fd::invalid)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{
+                errno,
+                std::system_category(),
+                "Failed to create IPC pause notification eventfd"}));
+        }
+
+        if (!display)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to create wl_display"});
+        }
+
+#ifndef MIR_NO_WAYLAND_FILTER
+        wl_display_set_global_filter(display.get(), &wl_display_global_filter_func_thunk, connector);
+#else
+        log_warning("Cannot set Wayland protocol filter: "
+            "wl_display_set_global_filter() is unavailable in libwayland-dev "
+            WAYLAND_VERSION);
+#endif
+
+        // Run the builders before creating the seat (because that's what GTK3 expects)
+        connector->extensions->build(
+            display.get(),
+            [executor=executor](std::function<void()>&& work) { executor->spawn(std::move(work)); });
+
+        /*
+         * Here be Dragons!
+         *
+         * Some clients expect a certain order in the publication of globals, and will
+         * crash with a different order. Yay!
+         *
+         * So far I've only found ones which expect wl_compositor before anything else,
+         * so stick that first.
+         */
+        compositor_global = std::make_unique<mf::WlCompositor>(
+            display.get(),
+            executor,
+            this->allocator);
+        subcompositor_global = std::make_unique<mf::WlSubcompositor>(display.get());
+        seat_global = std::make_unique<mf::WlSeat>(display.get(), input_hub, seat, executor, touch_resampling);
+        output_manager = std::make_unique<mf::OutputManager>(
+            display.get(),
+            display_config,
+            executor);
+
+        data_device_manager_global = mf::create_data_device_manager(display.get(), executor, connector->clipboard);
+
+        connector->extensions->init(display.get(), connector->shell, seat_global.get(), output_manager.get());
+
+        wl_display_init_shm(display.get());
+
+        setup_new_client_handler(display.get(), connector->shell, session_authorizer, &connect_handlers);
+
+        auto wayland_loop = wl_display_get_event_loop(display.get());
+
+        pause_source = wl_event_loop_add_fd(wayland_loop, pause_signal, WL_EVENT_READABLE, &halt_eventloop, display.get());
+    }
+
+    ~Shard()
+    {
+        if (dispatch_thread.joinable())
+        {
+            stop();
+        }
+        wl_event_source_remove(pause_source);
+    }
+
+    void start()
+    {
+        dispatch_thread = std::thread{
+            [](wl_display* d, std::string const& name)
+            {
+                mir::set_thread_name(name);
+                wl_display_run(d);
+            },
+            display.get(),
+            thread_name};
+
+        executor->spawn([this]{ seat_global->server_restart(); });
+    }
+
+    void stop()
+    {
+        if (eventfd_write(pause_signal, 1) < 0)
+        {
+            BOOST_THROW_EXCEPTION((std::system_error{
+                errno,
+                std::system_category(),
+                "Failed to send IPC eventloop pause signal"}));
+        }
+        if (dispatch_thread.joinable())
+        {
+            dispatch_thread.join();
+            dispatch_thread = std::thread{};
+        }
+        else
+        {
+            mir::log_warning("WaylandConnector::stop() called on not-running connector?");
+        }
+    }
+
+    void create_client(int socket, std::function<void(wl_client*)> const& on_created = [](wl_client*){})
+    {
+        executor->spawn(
+            [socket, display = display.get(), on_created]()
+            {
+                if (auto const client = wl_client_create(display, socket))
+                {
+                    on_created(client);
+                }
+                else
+                {
+                    mir::log_error(
+                        "Failed to create Wayland client object: %s (errno %i)",
+                        strerror(errno),
+                        errno);
+                    close(socket);
+                }
+            });
+    }
+
+    /// Keep the other shards' seats from believing they still have focus
+    void track_focus()
+    {
+        seat_global->add_focus_listener(this);
+    }
+
+    /// Called on our event loop when another shard has taken focus
+    void lose_focus(uint64_t serial)
+    {
+        if (serial > focus_serial)
+        {
+            focus_serial = serial;
+            seat_global->notify_focus(nullptr);
+        }
+    }
+
+    void focus_on(wl_client* client) override
+    {
+        if (client)
+            connector->focus_moved_to(*this);
+    }
+
+    WaylandConnector* const connector;
+    std::string const thread_name;
+    bool const primary;
+
+    std::unique_ptr<wl_display, void(*)(wl_display*)> const display;
+    mir::Fd const pause_signal;
+    std::shared_ptr<Executor> const executor;
+    std::shared_ptr<mg::WaylandAllocator> const allocator;
+    std::unique_ptr<WlCompositor> compositor_global;
+    std::unique_ptr<WlSubcompositor> subcompositor_global;
+    std::unique_ptr<WlSeat> seat_global;
+    std::unique_ptr<OutputManager> output_manager;
+    std::unique_ptr<DataDeviceManager> data_device_manager_global;
+    std::thread dispatch_thread;
+    wl_event_source* pause_source;
+
+    // Only accessed on event loop
+    std::unordered_map<int, std::function<void(std::shared_ptr<scene::Session> const& session)>> connect_handlers;
+    uint64_t focus_serial{0};
+};
+
+/// Listens where libwayland would, so we can choose which shard each new client joins
+class mf::WaylandConnector::ListeningSocket
+{
+public:
+    ListeningSocket()
+    {
+        auto const runtime_dir = getenv("XDG_RUNTIME_DIR");
+        if (!runtime_dir)
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error{"XDG_RUNTIME_DIR is not set: cannot create Wayland socket"});
+        }
+
+        if (auto const display_name = getenv("WAYLAND_DISPLAY"))
+        {
+            if (!try_listen(runtime_dir, display_name))
+            {
+                BOOST_THROW_EXCEPTION(
+                    std::system_error(errno, std::system_category(), "Failed to add Wayland socket"));
+            }
+        }
+        else
+        {
+            // The same range wl_display_add_socket_auto() tries
+            for (auto i = 0; i != 33 && !try_listen(runtime_dir, "wayland-" + std::to_string(i)); ++i)
+                ;
+        }
+    }
+
+    ~ListeningSocket()
+    {
+        if (fd != mir::Fd::invalid)
+        {
+            unlink(path.c_str());
+            unlink((path + ".lock").c_str());
+        }
+    }
+
+    std::string name;
+    std::string path;
+    mir::Fd lock;
+    mir::Fd fd;
+
+private:
+    bool try_listen(std::string const& runtime_dir, std::string const& name)
+    {
+        auto const path = runtime_dir + "/" + name;
+
+        sockaddr_un address{};
+        address.sun_family = AF_LOCAL;
+        if (path.size() >= sizeof address.sun_path)
+        {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+        strncpy(address.sun_path, path.c_str(), sizeof address.sun_path - 1);
+
+        mir::Fd lock{open((path + ".lock").c_str(), O_CREAT | O_CLOEXEC | O_RDWR, S_IRUSR|S_IWUSR | S_IRGRP|S_IWGRP)};
+        if (lock == mir::Fd::invalid || flock(lock, LOCK_EX | LOCK_NB) < 0)
+            return false;
+
+        // We hold the lock, so any socket left at path is stale
+        unlink(path.c_str());
+
+        mir::Fd fd{socket(AF_LOCAL, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+        if (fd == mir::Fd::invalid ||
+            bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) < 0 ||
+            listen(fd, 128) < 0)
+        {
+            return false;
+        }
+
+        this->name = name;
+        this->path = path;
+        this->lock = lock;
+        this->fd = fd;
+        return true;
+    }
+};
+
 mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<msh::Shell> const& shell,
     std::shared_ptr<MirDisplay> const& display_config,
@@ -660,73 +1113,54 @@ mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
     std::shared_ptr<mf::SessionAuthorizer> const& session_authorizer,
     bool arw_socket,
+    bool touch_resampling,
+    int dispatch_threads,
     std::unique_ptr<WaylandExtensions> extensions_,
     WaylandProtocolExtensionFilter const& extension_filter)
-    : display{wl_display_create(), &cleanup_display},
-      pause_signal{eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)},
-      executor{std::make_shared<WaylandExecutor>(wl_display_get_event_loop(display.get()))},
-      allocator{allocator_for_display(allocator, display.get(), executor)},
+    : gpu_clients{std::make_unique<GpuClients>()},
+      clipboard{std::make_shared<Clipboard>()},
       shell{shell},
       extensions{std::move(extensions_)},
       extension_filter{extension_filter}
 {
-    if (pause_signal == mir::Fd::invalid)
-    {
-        BOOST_THROW_EXCEPTION((std::system_error{
-            errno,
-            std::system_category(),
-            "Failed to create IPC pause notification eventfd"}));
-    }
-
-    if (!display)
-    {
-        BOOST_THROW_EXCEPTION(std::runtime_error{"Failed to create wl_display"});
-    }
-
-#ifndef MIR_NO_WAYLAND_FILTER
-    wl_display_set_global_filter(display.get(), &wl_display_global_filter_func_thunk, this);
-#else
-    log_warning("Cannot set Wayland protocol filter: "
-        "wl_display_set_global_filter() is unavailable in libwayland-dev "
-        WAYLAND_VERSION);
-#endif
-
-    // Run the builders before creating the seat (because that's what GTK3 expects)
-    extensions->run_builders(
-        display.get(),
-        [executor=executor](std::function<void()>&& work) { executor->spawn(std::move(work)); });
-
     /*
-     * Here be Dragons!
-     *
-     * Some clients expect a certain order in the publication of globals, and will
-     * crash with a different order. Yay!
-     *
-     * So far I've only found ones which expect wl_compositor before anything else,
-     * so stick that first.
+     * Only the primary display is bound to the graphics platform: EGL can only be bound
+     * to one wl_display. Clients that might use it are always given to the primary.
      */
-    compositor_global = std::make_unique<mf::WlCompositor>(
-        display.get(),
-        executor,
-        this->allocator);
-    subcompositor_global = std::make_unique<mf::WlSubcompositor>(display.get());
-    seat_global = std::make_unique<mf::WlSeat>(display.get(), input_hub, seat, executor);
-    output_manager = std::make_unique<mf::OutputManager>(
-        display.get(),
-        display_config,
-        executor);
-
-    data_device_manager_global = mf::create_data_device_manager(display.get());
-
-    extensions->init(display.get(), shell, seat_global.get(), output_manager.get());
+    shards.push_back(std::make_unique<Shard>(
+        this, "Mir/Wayland", true,
+        display_config, input_hub, seat, allocator, session_authorizer, touch_resampling));
 
-    wl_display_init_shm(display.get());
+    for (auto i = 1; i < dispatch_threads; ++i)
+    {
+        shards.push_back(std::make_unique<Shard>(
+            this, "Mir/Wayland-" + std::to_string(i), false,
+            display_config, input_hub, seat, nullptr, session_authorizer, touch_resampling));
+    }
 
     char const* wayland_display = nullptr;
 
-    if (auto const display_name = getenv("WAYLAND_DISPLAY"))
+    if (shards.size() > 1)
     {
-        if (wl_display_add_socket(display.get(), display_name) != 0)
+        for (auto const& shard : shards)
+            shard->track_focus();
+
+        listening_socket = std::make_unique<ListeningSocket>();
+        if (listening_socket->fd != mir::Fd::invalid)
+        {
+            listening_source = wl_event_loop_add_fd(
+                wl_display_get_event_loop(primary().display.get()),
+                listening_socket->fd,
+                WL_EVENT_READABLE,
+                &dispatch_new_client,
+                this);
+
+            wayland_display = listening_socket->name.c_str();
+        }
+    }
+    else if (auto const display_name = getenv("WAYLAND_DISPLAY"))
+    {
+        if (wl_display_add_socket(primary().display.get(), display_name) != 0)
         {
             BOOST_THROW_EXCEPTION(
                 std::system_error(errno, std::system_category(), "Failed to add Wayland socket"));
@@ -736,7 +1170,7 @@ mf::WaylandConnector::WaylandConnector(
     }
     else
     {
-        wayland_display = wl_display_add_socket_auto(display.get());
+        wayland_display = wl_display_add_socket_auto(primary().display.get());
     }
 
     if (wayland_display)
@@ -749,54 +1183,30 @@ mf::WaylandConnector::WaylandConnector(
 
         this->wayland_display = wayland_display;
     }
-
-    auto wayland_loop = wl_display_get_event_loop(display.get());
-
-    setup_new_client_handler(display.get(), shell, session_authorizer, &connect_handlers);
-
-    pause_source = wl_event_loop_add_fd(wayland_loop, pause_signal, WL_EVENT_READABLE, &halt_eventloop, display.get());
 }
 
 mf::WaylandConnector::~WaylandConnector()
 {
-    if (dispatch_thread.joinable())
+    for (auto const& shard : shards)
     {
-        stop();
+        if (shard->dispatch_thread.joinable())
+            shard->stop();
     }
-    wl_event_source_remove(pause_source);
+
+    if (listening_source)
+        wl_event_source_remove(listening_source);
 }
 
 void mf::WaylandConnector::start()
 {
-    dispatch_thread = std::thread{
-        [](wl_display* d)
-        {
-            mir::set_thread_name("Mir/Wayland");
-            wl_display_run(d);
-        },
-        display.get()};
-
-    executor->spawn([this]{ seat_global->server_restart(); });
+    for (auto const& shard : shards)
+        shard->start();
 }
 
 void mf::WaylandConnector::stop()
 {
-    if (eventfd_write(pause_signal, 1) < 0)
-    {
-        BOOST_THROW_EXCEPTION((std::system_error{
-            errno,
-            std::system_category(),
-            "Failed to send IPC eventloop pause signal"}));
-    }
-    if (dispatch_thread.joinable())
-    {
-        dispatch_thread.join();
-        dispatch_thread = std::thread{};
-    }
-    else
-    {
-        mir::log_warning("WaylandConnector::stop() called on not-running connector?");
-    }
+    for (auto const& shard : shards)
+        shard->stop();
 }
 
 int mf::WaylandConnector::client_socket_fd() const
@@ -813,17 +1223,7 @@ int mf::WaylandConnector::client_socket_fd() const
     else
     {
         // TODO: Wait on the result of wl_client_create so we can throw an exception on failure.
-        executor->spawn(
-                [socket = socket_fd[server], display = display.get()]()
-                {
-                    if (!wl_client_create(display, socket))
-                    {
-                        mir::log_error(
-                            "Failed to create Wayland client object: %s (errno %i)",
-                            strerror(errno),
-                            errno);
-                    }
-                });
+        primary().create_client(socket_fd[server]);
     }
 
     if (error)
@@ -846,11 +1246,11 @@ int mf::WaylandConnector::client_socket_fd(
     }
     else
     {
-        executor->spawn(
-                [socket = socket_fd[server], display = display.get(), this, connect_handler]()
+        primary().executor->spawn(
+                [socket = socket_fd[server], shard = &primary(), connect_handler]()
                     {
-                        connect_handlers[socket] = std::move(connect_handler);
-                        if (!wl_client_create(display, socket))
+                        shard->connect_handlers[socket] = std::move(connect_handler);
+                        if (!wl_client_create(shard->display.get(), socket))
                         {
                             mir::log_error(
                                 "Failed to create Wayland client object: %s (errno %i)",
@@ -869,7 +1269,7 @@ int mf::WaylandConnector::client_socket_fd(
 
 void mf::WaylandConnector::run_on_wayland_display(std::function<void(wl_display*)> const& functor)
 {
-    executor->spawn([display_ref = display.get(), functor]() { functor(display_ref); });
+    primary().executor->spawn([display_ref = primary().display.get(), functor]() { functor(display_ref); });
 }
 
 void mf::WaylandConnector::on_surface_created(
@@ -877,7 +1277,71 @@ void mf::WaylandConnector::on_surface_created(
     uint32_t id,
     std::function<void(WlSurface*)> const& callback)
 {
-    compositor_global->on_surface_created(client, id, callback);
+    primary().compositor_global->on_surface_created(client, id, callback);
+}
+
+auto mf::WaylandConnector::primary() const -> Shard&
+{
+    return *shards.front();
+}
+
+int mf::WaylandConnector::dispatch_new_client(int fd, uint32_t /*mask*/, void* data)
+{
+    auto const self = static_cast<WaylandConnector*>(data);
+
+    auto const client_fd = accept4(fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client_fd < 0)
+    {
+        mir::log_warning("Failed to accept Wayland client: %s (errno %i)", strerror(errno), errno);
+        return 0;
+    }
+
+    ucred credentials;
+    socklen_t length = sizeof credentials;
+    if (getsockopt(client_fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0)
+    {
+        self->primary().create_client(client_fd);
+        return 0;
+    }
+
+    auto const executable = executable_of(credentials.pid);
+    auto& shard = self->shard_for(credentials.pid, executable);
+
+    if (&shard == &self->primary())
+    {
+        // Only clients on the primary can teach us whether their program attaches GPU buffers
+        shard.create_client(
+            client_fd,
+            [gpu_clients = self->gpu_clients.get(), executable](wl_client* client)
+            {
+                gpu_clients->track(client, executable);
+            });
+    }
+    else
+    {
+        shard.create_client(client_fd);
+    }
+    return 0;
+}
+
+auto mf::WaylandConnector::shard_for(pid_t pid, std::string const& executable) -> Shard&
+{
+    if (gpu_clients->need_primary(pid, executable))
+        return primary();
+
+    return *shards[next_shard++ % shards.size()];
+}
+
+void mf::WaylandConnector::focus_moved_to(Shard& focused)
+{
+    auto const serial = ++focus_serial;
+    focused.focus_serial = serial;
+
+    for (auto const& shard : shards)
+    {
+        if (shard.get() != &focused)
+            shard->executor->spawn([shard = shard.get(), serial] { shard->lose_focus(serial); });
+    }
 }
 
 auto mf::WaylandConnector::socket_name() const -> optional_value<std::string>
@@ -887,7 +1351,7 @@ auto mf::WaylandConnector::socket_name() const -> optional_value<std::string>
 
 auto mf::WaylandConnector::get_extension(std::string const& name) const -> std::shared_ptr<void>
 {
-    return extensions->get_extension(name);
+    return extensions->get_extension(primary().display.get(), name);
 }
 
 bool mf::WaylandConnector::wl_display_global_filter_func_thunk(wl_client const* client, wl_global const* global, void *data)
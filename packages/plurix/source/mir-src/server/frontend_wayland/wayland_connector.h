@@ -24,8 +24,9 @@
 #include "mir/optional_value.h"
 
 #include <wayland-server-core.h>
+#include <sys/types.h>
+#include <atomic>
 #include <unordered_map>
-#include <thread>
 #include <vector>
 #include <mir/server_configuration.h>
 
@@ -65,6 +66,7 @@ class OutputManager;
 class MirDisplay;
 class SessionAuthorizer;
 class DataDeviceManager;
+class Clipboard;
 class WlSurface;
 
 class WaylandExtensions
@@ -75,19 +77,28 @@ public:
     WaylandExtensions(WaylandExtensions const&) = delete;
     WaylandExtensions& operator=(WaylandExtensions const&) = delete;
 
-    virtual void run_builders(wl_display* display, std::function<void(std::function<void()>&& work)> const& run_on_wayland_mainloop);
+    /// Runs the builders of the extensions added by the shell (see run_builders()) for display
+    void build(wl_display* display, std::function<void(std::function<void()>&& work)> const& run_on_wayland_mainloop);
 
-    void init(wl_display* display, std::shared_ptr<shell::Shell> const& shell, WlSeat* seat, OutputManager* const output_manager);
+    /// Adds the extensions to display. With several displays, each has its own instances.
+    void init(
+        wl_display* display,
+        std::shared_ptr<shell::Shell> const& shell,
+        WlSeat* seat,
+        OutputManager* const output_manager);
 
-    auto get_extension(std::string const& name) const -> std::shared_ptr<void>;
+    auto get_extension(wl_display* display, std::string const& name) const -> std::shared_ptr<void>;
 
 protected:
 
+    /// Adds to the extensions of the display being built or initialised
     void add_extension(std::string const name, std::shared_ptr<void> implementation);
+    virtual void run_builders(wl_display* display, std::function<void(std::function<void()>&& work)> const& run_on_wayland_mainloop);
     virtual void custom_extensions(wl_display* display, std::shared_ptr<shell::Shell> const& shell, WlSeat* seat, OutputManager* const output_manager);
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<void>> extension_protocols;
+    wl_display* current_display{nullptr};
+    std::unordered_map<wl_display*, std::unordered_map<std::string, std::shared_ptr<void>>> extension_protocols;
 };
 
 class WaylandConnector : public Connector
@@ -103,6 +114,8 @@ public:
         std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
         std::shared_ptr<SessionAuthorizer> const& session_authorizer,
         bool arw_socket,
+        bool touch_resampling,
+        int dispatch_threads,
         std::unique_ptr<WaylandExtensions> extensions,
         WaylandProtocolExtensionFilter const& extension_filter);
 
@@ -116,6 +129,7 @@ public:
     int client_socket_fd(
         std::function<void(std::shared_ptr<scene::Session> const& session)> const& connect_handler) const override;
 
+    /// Runs functor on the primary display (the one clients connected through client_socket_fd() use)
     void run_on_wayland_display(std::function<void(wl_display*)> const& functor);
 
     /// Runs callback the first time a wl_surface with the given id is created, or immediately if one currently exists
@@ -127,28 +141,44 @@ public:
     auto get_extension(std::string const& name) const -> std::shared_ptr<void>;
 
 private:
+    /**
+     * A wl_display, with its own copy of every global, dispatched by its own thread.
+     *
+     * libwayland requires all the clients of a display to be dispatched by one thread. To
+     * spread many clients over several threads each thread gets its own display, and new
+     * connections to the socket are handed out to them in turn. Every display has all the
+     * extensions, but only the primary can be bound to EGL, so clients of programs that may
+     * attach GPU buffers always join it (see GpuClients).
+     */
+    class Shard;
+    class ListeningSocket;
+    class GpuClients;
+
     bool wl_display_global_filter_func(wl_client const* client, wl_global const* global) const;
     static bool wl_display_global_filter_func_thunk(wl_client const* client, wl_global const* global, void* data);
+    static int dispatch_new_client(int fd, uint32_t mask, void* data);
+    auto shard_for(pid_t pid, std::string const& executable) -> Shard&;
+
+    auto primary() const -> Shard&;
+    void focus_moved_to(Shard& focused);
 
-    std::unique_ptr<wl_display, void(*)(wl_display*)> const display;
-    mir::Fd const pause_signal;
-    std::unique_ptr<WlCompositor> compositor_global;
-    std::unique_ptr<WlSubcompositor> subcompositor_global;
-    std::unique_ptr<WlSeat> seat_global;
-    std::unique_ptr<OutputManager> output_manager;
-    std::unique_ptr<DataDeviceManager> data_device_manager_global;
-    std::shared_ptr<Executor> const executor;
-    std::shared_ptr<graphics::WaylandAllocator> const allocator;
+    /// Outlives the shards, as it listens for the destruction of the primary's clients
+    std::unique_ptr<GpuClients> const gpu_clients;
+    /// shards.front() is the primary, which XWayland and clients from client_socket_fd() use
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::shared_ptr<Clipboard> const clipboard;
     std::shared_ptr<shell::Shell> const shell;
     std::unique_ptr<WaylandExtensions> const extensions;
-    std::thread dispatch_thread;
-    wl_event_source* pause_source;
+    std::unique_ptr<ListeningSocket> listening_socket;  ///< Only when there are several shards
+    wl_event_source* listening_source{nullptr};
     std::string wayland_display;
 
     WaylandProtocolExtensionFilter const extension_filter;
 
-    // Only accessed on event loop
-    std::unordered_map<int, std::function<void(std::shared_ptr<scene::Session> const& session)>> mutable connect_handlers;
+    std::atomic<uint64_t> focus_serial{0};
+
+    // Only accessed on the primary event loop
+    size_t next_shard{0};
 };
 
 auto create_wl_shell(
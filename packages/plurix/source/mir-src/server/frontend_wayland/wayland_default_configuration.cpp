@@ -24,10 +24,18 @@
 #include "xdg_shell_stable.h"
 #include "xdg_output_v1.h"
 #include "layer_shell_v1.h"
+#include "input_timestamps_v1.h"
+#include "relative_pointer_v1.h"
+#include "pointer_constraints_v1.h"
+#include "tablet_v2.h"
 #include "xwayland_wm_shell.h"
 #include "mir_display.h"
 #include "wl_seat.h"
 #include "xdg-output-unstable-v1_wrapper.h"
+#include "input-timestamps-unstable-v1_wrapper.h"
+#include "relative-pointer-unstable-v1_wrapper.h"
+#include "pointer-constraints-unstable-v1_wrapper.h"
+#include "tablet-unstable-v2_wrapper.h"
 
 #include "mir/graphics/platform.h"
 #include "mir/options/default_configuration.h"
@@ -58,7 +66,11 @@ auto mf::get_supported_extensions() -> std::vector<std::string>
         mw::XdgWmBase::interface_name,
         mw::XdgShellV6::interface_name,
         mw::LayerShellV1::interface_name,
-        mw::XdgOutputManagerV1::interface_name};
+        mw::XdgOutputManagerV1::interface_name,
+        mw::InputTimestampsManagerV1::interface_name,
+        mw::RelativePointerManagerV1::interface_name,
+        mw::PointerConstraintsV1::interface_name,
+        mw::TabletManagerV2::interface_name};
 }
 
 namespace
@@ -110,6 +122,26 @@ auto configure_wayland_extensions(
                     mw::XdgOutputManagerV1::interface_name,
                     create_xdg_output_manager_v1(display, output_manager));
 
+            if (extension.find(mw::InputTimestampsManagerV1::interface_name) != extension.end())
+                add_extension(
+                    mw::InputTimestampsManagerV1::interface_name,
+                    mf::create_input_timestamps_manager_v1(display));
+
+            if (extension.find(mw::RelativePointerManagerV1::interface_name) != extension.end())
+                add_extension(
+                    mw::RelativePointerManagerV1::interface_name,
+                    mf::create_relative_pointer_manager_v1(display));
+
+            if (extension.find(mw::PointerConstraintsV1::interface_name) != extension.end())
+                add_extension(
+                    mw::PointerConstraintsV1::interface_name,
+                    mf::create_pointer_constraints_v1(display, seat));
+
+            if (extension.find(mw::TabletManagerV2::interface_name) != extension.end())
+                add_extension(
+                    mw::TabletManagerV2::interface_name,
+                    mf::create_tablet_manager_v2(display));
+
             if (x11_enabled)
                 add_extension("x11-support", std::make_shared<mf::XWaylandWMShell>(shell, *seat, output_manager));
         }
@@ -159,6 +191,8 @@ std::shared_ptr<mf::Connector>
                 the_buffer_allocator(),
                 the_session_authorizer(),
                 arw_socket,
+                options->get<bool>(mo::touch_resampling_opt),
+                options->get<int>(mo::wayland_dispatch_threads_opt),
                 configure_wayland_extensions(wayland_extensions, options->is_set(mo::x11_display_opt), wayland_extension_hooks),
                 wayland_extension_filter);
         });
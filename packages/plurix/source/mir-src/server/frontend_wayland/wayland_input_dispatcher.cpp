@@ -22,6 +22,9 @@
 #include "wl_pointer.h"
 #include "wl_keyboard.h"
 #include "wl_touch.h"
+#include "tablet_v2.h"
+
+#include <mir/events/pointer_event.h>
 
 #include <mir/input/xkb_mapper.h>
 #include <mir/input/keymap.h>
@@ -90,7 +93,6 @@ void mf::WaylandInputDispatcher::handle_event(MirEvent const* event)
 void mf::WaylandInputDispatcher::handle_input_event(MirInputEvent const* event)
 {
     auto const ns = std::chrono::nanoseconds{mir_input_event_get_event_time(event)};
-    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(ns);
 
     // Remember the timestamp of any events "signed" with a cookie
     if (mir_input_event_has_cookie(event))
@@ -99,40 +101,40 @@ void mf::WaylandInputDispatcher::handle_input_event(MirInputEvent const* event)
     switch (mir_input_event_get_type(event))
     {
     case mir_input_event_type_key:
-        handle_keyboard_event(ms, mir_input_event_get_keyboard_event(event));
+        handle_keyboard_event(ns, mir_input_event_get_keyboard_event(event));
         break;
     case mir_input_event_type_pointer:
-        handle_pointer_event(ms, mir_input_event_get_pointer_event(event));
+        handle_pointer_event(ns, mir_input_event_get_pointer_event(event));
         break;
     case mir_input_event_type_touch:
-        handle_touch_event(ms, mir_input_event_get_touch_event(event));
+        handle_touch_event(ns, mir_input_event_get_touch_event(event));
         break;
     default:
         break;
     }
 }
 
-void mf::WaylandInputDispatcher::handle_keyboard_event(std::chrono::milliseconds const& ms, MirKeyboardEvent const* event)
+void mf::WaylandInputDispatcher::handle_keyboard_event(std::chrono::nanoseconds const& ns, MirKeyboardEvent const* event)
 {
     MirKeyboardAction const action = mir_keyboard_event_action(event);
     if (action == mir_keyboard_action_down || action == mir_keyboard_action_up)
     {
         int const scancode = mir_keyboard_event_scan_code(event);
         bool const down = action == mir_keyboard_action_down;
-        seat->for_each_listener(client, [&ms, wl_surface = wl_surface, scancode, down](WlKeyboard* keyboard)
+        seat->for_each_listener(client, [&ns, wl_surface = wl_surface, scancode, down](WlKeyboard* keyboard)
             {
-                keyboard->key(ms, wl_surface, scancode, down);
+                keyboard->key(ns, wl_surface, scancode, down);
             });
     }
 }
 
-void mf::WaylandInputDispatcher::handle_pointer_event(std::chrono::milliseconds const& ms, MirPointerEvent const* event)
+void mf::WaylandInputDispatcher::handle_pointer_event(std::chrono::nanoseconds const& ns, MirPointerEvent const* event)
 {
     switch(mir_pointer_event_action(event))
     {
         case mir_pointer_action_button_down:
         case mir_pointer_action_button_up:
-            handle_pointer_button_event(ms, event);
+            handle_pointer_button_event(ns, event);
             break;
         case mir_pointer_action_enter:
         {
@@ -144,6 +146,7 @@ void mf::WaylandInputDispatcher::handle_pointer_event(std::chrono::milliseconds
                     pointer->enter(wl_surface, position);
                     pointer->frame();
                 });
+            seat->notify_pointer_motion(wl_surface, position);
             break;
         }
         case mir_pointer_action_leave:
@@ -154,7 +157,7 @@ void mf::WaylandInputDispatcher::handle_pointer_event(std::chrono::milliseconds
                 });
             break;
         case mir_pointer_action_motion:
-            handle_pointer_motion_event(ms, event);
+            handle_pointer_motion_event(ns, event);
             break;
         case mir_pointer_actions:
             break;
@@ -162,7 +165,7 @@ void mf::WaylandInputDispatcher::handle_pointer_event(std::chrono::milliseconds
 }
 
 void mf::WaylandInputDispatcher::handle_pointer_button_event(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& ns,
     MirPointerEvent const* event)
 {
     MirPointerButtons const event_buttons = mir_pointer_event_buttons(event);
@@ -189,11 +192,11 @@ void mf::WaylandInputDispatcher::handle_pointer_button_event(
 
     if (!buttons.empty())
     {
-        seat->for_each_listener(client, [&ms, &buttons](WlPointer* pointer)
+        seat->for_each_listener(client, [&ns, &buttons](WlPointer* pointer)
             {
                 for (auto& button : buttons)
                 {
-                    pointer->button(ms, button.first, button.second);
+                    pointer->button(ns, button.first, button.second);
                 }
                 pointer->frame();
             });
@@ -203,7 +206,7 @@ void mf::WaylandInputDispatcher::handle_pointer_button_event(
 }
 
 void mf::WaylandInputDispatcher::handle_pointer_motion_event(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& ns,
     MirPointerEvent const* event)
 {
     // TODO: send axis_source, axis_stop and axis_discrete events where appropriate
@@ -215,28 +218,41 @@ void mf::WaylandInputDispatcher::handle_pointer_motion_event(
     geom::Displacement const axis_motion{
         mir_pointer_event_axis_value(event, mir_pointer_axis_hscroll) * 10,
         mir_pointer_event_axis_value(event, mir_pointer_axis_vscroll) * 10};
+    // Relative motion is not clamped by the output layout or pointer confinement, so it is sent
+    // even when the cursor itself hasn't moved (such as when the pointer is locked)
+    double const relative_x = mir_pointer_event_axis_value(event, mir_pointer_axis_relative_x);
+    double const relative_y = mir_pointer_event_axis_value(event, mir_pointer_axis_relative_y);
+    // relative_pointer_v1 also wants the motion before pointer acceleration was applied
+    double const unaccelerated_x = event->unaccelerated_dx();
+    double const unaccelerated_y = event->unaccelerated_dy();
     bool const send_motion = (!last_pointer_position || position != last_pointer_position.value());
     bool const send_axis = (axis_motion != geom::Displacement{});
+    bool const send_relative = (relative_x != 0 || relative_y != 0);
 
     last_pointer_position = position;
 
-    if (send_motion || send_axis)
+    if (send_motion || send_axis || send_relative)
     {
         seat->for_each_listener(
             client,
-            [&ms, wl_surface = wl_surface, &send_motion, &position, &send_axis, &axis_motion](WlPointer* pointer)
+            [&, wl_surface = wl_surface](WlPointer* pointer)
             {
                 if (send_motion)
-                    pointer->motion(ms, wl_surface, position);
+                    pointer->motion(ns, wl_surface, position);
                 if (send_axis)
-                    pointer->axis(ms, axis_motion);
+                    pointer->axis(ns, axis_motion);
+                if (send_relative)
+                    pointer->relative_motion(ns, relative_x, relative_y, unaccelerated_x, unaccelerated_y);
                 pointer->frame();
             });
     }
+
+    if (send_motion)
+        seat->notify_pointer_motion(wl_surface, position);
 }
 
 void mf::WaylandInputDispatcher::handle_touch_event(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& ns,
     MirTouchEvent const* event)
 {
     for (auto i = 0u; i < mir_touch_event_point_count(event); ++i)
@@ -247,24 +263,27 @@ void mf::WaylandInputDispatcher::handle_touch_event(
         int const touch_id = mir_touch_event_id(event, i);
         MirTouchAction const action = mir_touch_event_action(event, i);
 
+        if (mir_touch_event_tooltype(event, i) == mir_touch_tooltype_stylus && handle_stylus(ns, event, i))
+            continue;
+
         switch (action)
         {
         case mir_touch_action_down:
-            seat->for_each_listener(client, [&ms, touch_id, wl_surface = wl_surface, &position](WlTouch* touch)
+            seat->for_each_listener(client, [&ns, touch_id, wl_surface = wl_surface, &position](WlTouch* touch)
                 {
-                    touch->down(ms, touch_id, wl_surface, position);
+                    touch->down(ns, touch_id, wl_surface, position);
                 });
             break;
         case mir_touch_action_up:
-            seat->for_each_listener(client, [&ms, touch_id](WlTouch* touch)
+            seat->for_each_listener(client, [&ns, touch_id](WlTouch* touch)
                 {
-                    touch->up(ms, touch_id);
+                    touch->up(ns, touch_id);
                 });
             break;
         case mir_touch_action_change:
-            seat->for_each_listener(client, [&ms, touch_id, wl_surface = wl_surface, &position](WlTouch* touch)
+            seat->for_each_listener(client, [&ns, touch_id, wl_surface = wl_surface, &position](WlTouch* touch)
                 {
-                    touch->motion(ms, touch_id, wl_surface, position);
+                    touch->motion(ns, touch_id, wl_surface, position);
                 });
             break;
         case mir_touch_actions:;
@@ -276,3 +295,38 @@ void mf::WaylandInputDispatcher::handle_touch_event(
             touch->frame();
         });
 }
+
+bool mf::WaylandInputDispatcher::handle_stylus(
+    std::chrono::nanoseconds const& ns,
+    MirTouchEvent const* event,
+    size_t index)
+{
+    float const x = mir_touch_event_axis_value(event, index, mir_touch_axis_x);
+    float const y = mir_touch_event_axis_value(event, index, mir_touch_axis_y);
+    float const pressure = mir_touch_event_axis_value(event, index, mir_touch_axis_pressure);
+    MirTouchAction const action = mir_touch_event_action(event, index);
+    bool handled = false;
+
+    // Clients only see a tablet once the seat knows of a pen device
+    seat->notify_pen_device(mir_input_event_get_device_id(mir_touch_event_input_event(event)));
+
+    seat->for_each_listener(client, [&, wl_surface = wl_surface](TabletToolV2* tool)
+        {
+            handled = true;
+            switch (action)
+            {
+            case mir_touch_action_down:
+                tool->down(ns, wl_surface, x, y, pressure);
+                break;
+            case mir_touch_action_up:
+                tool->up(ns);
+                break;
+            case mir_touch_action_change:
+                tool->motion(ns, x, y, pressure);
+                break;
+            case mir_touch_actions:;
+            }
+        });
+
+    return handled;
+}
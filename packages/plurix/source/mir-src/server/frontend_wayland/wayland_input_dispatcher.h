@@ -72,11 +72,13 @@ private:
     /// Handle user input events
     ///@{
     void handle_input_event(MirInputEvent const* event);
-    void handle_keyboard_event(std::chrono::milliseconds const& ms, MirKeyboardEvent const* event);
-    void handle_pointer_event(std::chrono::milliseconds const& ms, MirPointerEvent const* event);
-    void handle_pointer_button_event(std::chrono::milliseconds const& ms, MirPointerEvent const* event);
-    void handle_pointer_motion_event(std::chrono::milliseconds const& ms, MirPointerEvent const* event);
-    void handle_touch_event(std::chrono::milliseconds const& ms, MirTouchEvent const* event);
+    void handle_keyboard_event(std::chrono::nanoseconds const& ns, MirKeyboardEvent const* event);
+    void handle_pointer_event(std::chrono::nanoseconds const& ns, MirPointerEvent const* event);
+    void handle_pointer_button_event(std::chrono::nanoseconds const& ns, MirPointerEvent const* event);
+    void handle_pointer_motion_event(std::chrono::nanoseconds const& ns, MirPointerEvent const* event);
+    void handle_touch_event(std::chrono::nanoseconds const& ns, MirTouchEvent const* event);
+    /// \returns false if the client has no tablet tools, and the stylus should be sent as a touch
+    bool handle_stylus(std::chrono::nanoseconds const& ns, MirTouchEvent const* event, size_t index);
     ///@}
 };
 }
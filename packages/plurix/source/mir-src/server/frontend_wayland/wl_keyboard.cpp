@@ -69,7 +69,12 @@ mf::WlKeyboard::~WlKeyboard()
     on_destroy(this);
 }
 
-void mf::WlKeyboard::key(std::chrono::milliseconds const& ms, WlSurface* surface, int scancode, bool down)
+auto mf::WlKeyboard::from(wl_resource* resource) -> WlKeyboard*
+{
+    return static_cast<WlKeyboard*>(wayland::Keyboard::from(resource));
+}
+
+void mf::WlKeyboard::key(std::chrono::nanoseconds const& timestamp, WlSurface* surface, int scancode, bool down)
 {
     if (*focused_surface_destroyed || focused_surface != surface)
     {
@@ -86,8 +91,10 @@ void mf::WlKeyboard::key(std::chrono::milliseconds const& ms, WlSurface* surface
      */
     xkb_key_direction const xkb_state = down ? XKB_KEY_DOWN : XKB_KEY_UP;
     auto const wayland_state = down ? KeyState::pressed : KeyState::released;
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
 
     xkb_state_update_key(state.get(), scancode + 8, xkb_state);
+    timestamps.send(timestamp);
     send_key_event(serial, ms.count(), scancode, wayland_state);
     update_modifier_state();
 }
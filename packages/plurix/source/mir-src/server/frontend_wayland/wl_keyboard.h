@@ -20,6 +20,7 @@
 #define MIR_FRONTEND_WL_KEYBOARD_H
 
 #include "wayland_wrapper.h"
+#include "input_timestamps_v1.h"
 
 #include <vector>
 #include <functional>
@@ -55,11 +56,15 @@ public:
 
     ~WlKeyboard();
 
-    void key(std::chrono::milliseconds const& ms, WlSurface* surface, int scancode, bool down);
+    static auto from(wl_resource* resource) -> WlKeyboard*;
+
+    void key(std::chrono::nanoseconds const& timestamp, WlSurface* surface, int scancode, bool down);
     void focussed(WlSurface* surface, bool should_be_focused);
     void set_keymap(mir::input::Keymap const& new_keymap);
     void resync_keyboard();
 
+    auto timestamp_listeners() -> InputTimestampListeners& { return timestamps; }
+
 private:
     void update_modifier_state();
     void update_keyboard_state(std::vector<uint32_t> const& keyboard_state);
@@ -79,6 +84,8 @@ private:
     uint32_t mods_locked{0};
     uint32_t group{0};
 
+    InputTimestampListeners timestamps;
+
     void release() override;
 };
 }
@@ -117,6 +117,11 @@ mf::WlPointer::~WlPointer()
     on_destroy(this);
 }
 
+auto mf::WlPointer::from(wl_resource* resource) -> WlPointer*
+{
+    return static_cast<WlPointer*>(wayland::Pointer::from(resource));
+}
+
 void mf::WlPointer::enter(WlSurface* parent_surface, geom::Point const& position_on_parent)
 {
     auto const serial = wl_display_next_serial(display);
@@ -151,17 +156,19 @@ void mf::WlPointer::leave()
     surface_under_cursor = std::experimental::nullopt;
 }
 
-void mf::WlPointer::button(std::chrono::milliseconds const& ms, uint32_t button, bool pressed)
+void mf::WlPointer::button(std::chrono::nanoseconds const& timestamp, uint32_t button, bool pressed)
 {
     auto const serial = wl_display_next_serial(display);
     auto const state = pressed ? ButtonState::pressed : ButtonState::released;
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
 
+    timestamps.send(timestamp);
     send_button_event(serial, ms.count(), button, state);
     can_send_frame = true;
 }
 
 void mf::WlPointer::motion(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& timestamp,
     WlSurface* parent_surface,
     geometry::Point const& position_on_parent)
 {
@@ -169,6 +176,8 @@ void mf::WlPointer::motion(
 
     if (surface_under_cursor && final.surface == surface_under_cursor.value())
     {
+        auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+        timestamps.send(timestamp);
         send_motion_event(
             ms.count(),
             final.position.x.as_int(),
@@ -182,10 +191,13 @@ void mf::WlPointer::motion(
     }
 }
 
-void mf::WlPointer::axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll)
+void mf::WlPointer::axis(std::chrono::nanoseconds const& timestamp, geometry::Displacement const& scroll)
 {
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+
     if (scroll.dx != geom::DeltaX{})
     {
+        timestamps.send(timestamp);
         send_axis_event(
             ms.count(),
             Axis::horizontal_scroll,
@@ -195,6 +207,7 @@ void mf::WlPointer::axis(std::chrono::milliseconds const& ms, geometry::Displace
 
     if (scroll.dy != geom::DeltaY{})
     {
+        timestamps.send(timestamp);
         send_axis_event(
             ms.count(),
             Axis::vertical_scroll,
@@ -203,6 +216,18 @@ void mf::WlPointer::axis(std::chrono::milliseconds const& ms, geometry::Displace
     }
 }
 
+void mf::WlPointer::relative_motion(
+    std::chrono::nanoseconds const& timestamp,
+    double dx, double dy,
+    double dx_unaccel, double dy_unaccel)
+{
+    if (relative_pointers.empty())
+        return;
+
+    relative_pointers.send(timestamp, dx, dy, dx_unaccel, dy_unaccel);
+    can_send_frame = true;
+}
+
 void mf::WlPointer::frame()
 {
     if (can_send_frame && version_supports_frame())
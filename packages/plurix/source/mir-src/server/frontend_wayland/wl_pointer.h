@@ -21,6 +21,8 @@
 
 
 #include "wayland_wrapper.h"
+#include "input_timestamps_v1.h"
+#include "relative_pointer_v1.h"
 
 #include "mir/geometry/point.h"
 #include "mir/geometry/displacement.h"
@@ -52,20 +54,30 @@ public:
 
     ~WlPointer();
 
+    static auto from(wl_resource* resource) -> WlPointer*;
+
     void handle_event(MirPointerEvent const* event, WlSurface* surface);
 
     /// Handles finding the correct subsurface and position on that subsurface if needed
     /// Giving it an already transformed surface and position is also fine
     void enter(WlSurface* parent_surface, geometry::Point const& position_on_parent);
     void leave();
-    void button(std::chrono::milliseconds const& ms, uint32_t button, bool pressed);
+    void button(std::chrono::nanoseconds const& timestamp, uint32_t button, bool pressed);
     void motion(
-        std::chrono::milliseconds const& ms,
+        std::chrono::nanoseconds const& timestamp,
         WlSurface* parent_surface,
         geometry::Point const& position_on_parent);
-    void axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll);
+    void axis(std::chrono::nanoseconds const& timestamp, geometry::Displacement const& scroll);
+    /// Sends unclamped motion to any zwp_relative_pointer_v1 objects, even if the cursor did not move
+    void relative_motion(
+        std::chrono::nanoseconds const& timestamp,
+        double dx, double dy,
+        double dx_unaccel, double dy_unaccel);
     void frame();
 
+    auto timestamp_listeners() -> InputTimestampListeners& { return timestamps; }
+    auto relative_pointer_listeners() -> RelativePointerListeners& { return relative_pointers; }
+
     struct Cursor;
 
 private:
@@ -74,6 +86,8 @@ private:
 
     bool can_send_frame{false};
     std::experimental::optional<WlSurface*> surface_under_cursor;
+    InputTimestampListeners timestamps;
+    RelativePointerListeners relative_pointers;
 
     /// Wayland request handlers
     ///@{
@@ -35,6 +35,7 @@
 #include "mir/input/device.h"
 #include "mir/input/keymap.h"
 #include "mir/input/mir_keyboard_config.h"
+#include "mir/geometry/rectangles.h"
 
 #include <mutex>
 #include <unordered_set>
@@ -42,6 +43,7 @@
 
 namespace mf = mir::frontend;
 namespace mi = mir::input;
+namespace geom = mir::geometry;
 namespace mw = mir::wayland;
 
 namespace mir
@@ -87,14 +89,41 @@ private:
     std::unordered_map<wl_client*, std::vector<T*>> listeners;
 };
 
+struct mf::WlSeat::PenDevices
+{
+    std::unordered_set<MirInputDeviceId> ids;
+    std::vector<TabletListener*> listeners;
+
+    void add(MirInputDeviceId id)
+    {
+        if (ids.insert(id).second && ids.size() == 1)
+            notify(true);
+    }
+
+    void remove(MirInputDeviceId id)
+    {
+        if (ids.erase(id) && ids.empty())
+            notify(false);
+    }
+
+    void notify(bool any)
+    {
+        auto const current = listeners;
+        for (auto const listener : current)
+            listener->pen_devices_changed(any);
+    }
+};
+
 class mf::WlSeat::ConfigObserver : public mi::InputDeviceObserver
 {
 public:
     ConfigObserver(
         mi::Keymap const& keymap,
-        std::function<void(mi::Keymap const&)> const& on_keymap_commit)
+        std::function<void(mi::Keymap const&)> const& on_keymap_commit,
+        std::function<void(MirInputDeviceId)> const& on_device_removed)
         : current_keymap{keymap},
-            on_keymap_commit{on_keymap_commit}
+            on_keymap_commit{on_keymap_commit},
+            on_device_removed{on_device_removed}
     {
     }
 
@@ -107,6 +136,7 @@ private:
     mi::Keymap const& current_keymap;
     mi::Keymap pending_keymap;
     std::function<void(mi::Keymap const&)> const on_keymap_commit;
+    std::function<void(MirInputDeviceId)> const on_device_removed;
 };
 
 void mf::WlSeat::ConfigObserver::device_added(std::shared_ptr<input::Device> const& device)
@@ -131,8 +161,9 @@ void mf::WlSeat::ConfigObserver::device_changed(std::shared_ptr<input::Device> c
     }
 }
 
-void mf::WlSeat::ConfigObserver::device_removed(std::shared_ptr<input::Device> const& /*device*/)
+void mf::WlSeat::ConfigObserver::device_removed(std::shared_ptr<input::Device> const& device)
 {
+    on_device_removed(device->id());
 }
 
 void mf::WlSeat::ConfigObserver::changes_complete()
@@ -158,22 +189,35 @@ mf::WlSeat::WlSeat(
     wl_display* display,
     std::shared_ptr<mi::InputDeviceHub> const& input_hub,
     std::shared_ptr<mi::Seat> const& seat,
-    std::shared_ptr<mir::Executor> const& executor)
+    std::shared_ptr<mir::Executor> const& executor,
+    bool touch_resampling)
     :   Global(display, Version<6>()),
         keymap{std::make_unique<input::Keymap>()},
+        pen_devices{std::make_shared<PenDevices>()},
         config_observer{
             std::make_shared<ConfigObserver>(
                 *keymap,
                 [this](mi::Keymap const& new_keymap)
                 {
                     *keymap = new_keymap;
+                },
+                [executor, pen_devices = std::weak_ptr<PenDevices>{pen_devices}](MirInputDeviceId id)
+                {
+                    executor->spawn(
+                        [pen_devices, id]
+                        {
+                            if (auto const pens = pen_devices.lock())
+                                pens->remove(id);
+                        });
                 })},
         pointer_listeners{std::make_shared<ListenerList<WlPointer>>()},
         keyboard_listeners{std::make_shared<ListenerList<WlKeyboard>>()},
         touch_listeners{std::make_shared<ListenerList<WlTouch>>()},
+        tablet_tool_listeners{std::make_shared<ListenerList<TabletToolV2>>()},
         input_hub{input_hub},
         seat{seat},
-        executor{executor}
+        executor{executor},
+        touch_resampling{touch_resampling}
 {
     input_hub->add_observer(config_observer);
     add_focus_listener(&focus);
@@ -204,6 +248,40 @@ void mf::WlSeat::for_each_listener(wl_client* client, std::function<void(WlTouch
     touch_listeners->for_each(client, func);
 }
 
+void mf::WlSeat::for_each_listener(wl_client* client, std::function<void(TabletToolV2*)> func)
+{
+    tablet_tool_listeners->for_each(client, func);
+}
+
+auto mf::WlSeat::add_listener(wl_client* client, TabletToolV2* tool) -> std::function<void()>
+{
+    tablet_tool_listeners->register_listener(client, tool);
+    return [listeners = tablet_tool_listeners, client, tool]
+        {
+            listeners->unregister_listener(client, tool);
+        };
+}
+
+auto mf::WlSeat::add_tablet_listener(TabletListener* listener) -> std::function<void()>
+{
+    pen_devices->listeners.push_back(listener);
+    return [pen_devices = pen_devices, listener]
+        {
+            auto& listeners = pen_devices->listeners;
+            listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+        };
+}
+
+auto mf::WlSeat::has_pen_devices() const -> bool
+{
+    return !pen_devices->ids.empty();
+}
+
+void mf::WlSeat::notify_pen_device(MirInputDeviceId id)
+{
+    pen_devices->add(id);
+}
+
 void mf::WlSeat::notify_focus(wl_client *focus)
 {
     if (focus != focused_client)
@@ -214,6 +292,25 @@ void mf::WlSeat::notify_focus(wl_client *focus)
     }
 }
 
+auto mf::WlSeat::cursor_position() const -> geom::Point
+{
+    auto const ev = seat->create_device_state();
+    auto const state_event = mir_event_get_input_device_state_event(ev.get());
+    return {
+        mir_input_device_state_event_pointer_axis(state_event, mir_pointer_axis_x),
+        mir_input_device_state_event_pointer_axis(state_event, mir_pointer_axis_y)};
+}
+
+void mf::WlSeat::set_confinement_regions(geom::Rectangles const& regions)
+{
+    seat->set_confinement_regions(regions);
+}
+
+void mf::WlSeat::reset_confinement_regions()
+{
+    seat->reset_confinement_regions();
+}
+
 void mf::WlSeat::spawn(std::function<void()>&& work)
 {
     executor->spawn(std::move(work));
@@ -291,6 +388,7 @@ void mf::WlSeat::Instance::get_touch(wl_resource* new_touch)
         client,
         new WlTouch{
             new_touch,
+            seat->touch_resampling,
             [listeners = seat->touch_listeners, client = client](WlTouch* listener)
             {
                 listeners->unregister_listener(client, listener);
@@ -312,6 +410,24 @@ void mf::WlSeat::remove_focus_listener(ListenerTracker* listener)
     focus_listeners.erase(remove(begin(focus_listeners), end(focus_listeners), listener), end(focus_listeners));
 }
 
+void mf::WlSeat::add_pointer_motion_listener(PointerMotionListener* listener)
+{
+    pointer_motion_listeners.push_back(listener);
+}
+
+void mf::WlSeat::remove_pointer_motion_listener(PointerMotionListener* listener)
+{
+    pointer_motion_listeners.erase(
+        remove(begin(pointer_motion_listeners), end(pointer_motion_listeners), listener),
+        end(pointer_motion_listeners));
+}
+
+void mf::WlSeat::notify_pointer_motion(WlSurface* window, geom::Point const& position)
+{
+    for (auto const listener : pointer_motion_listeners)
+        listener->pointer_moved(window, position);
+}
+
 void mf::WlSeat::server_restart()
 {
     if (focus.client)
@@ -21,20 +21,21 @@
 
 #include "wayland_wrapper.h"
 
+#include "mir/geometry/point.h"
+#include "mir_toolkit/events/event.h"
+
 #include <unordered_map>
 #include <vector>
 #include <functional>
 
-// from "mir_toolkit/events/event.h"
-struct MirInputEvent;
-struct MirSurfaceEvent;
-typedef struct MirSurfaceEvent MirWindowEvent;
-struct MirKeymapEvent;
-
 namespace mir
 {
 class Executor;
 
+namespace geometry
+{
+class Rectangles;
+}
 namespace input
 {
 class InputDeviceHub;
@@ -46,6 +47,8 @@ namespace frontend
 class WlPointer;
 class WlKeyboard;
 class WlTouch;
+class TabletToolV2;
+class WlSurface;
 
 class WlSeat : public wayland::Seat::Global
 {
@@ -54,7 +57,8 @@ public:
         wl_display* display,
         std::shared_ptr<mir::input::InputDeviceHub> const& input_hub,
         std::shared_ptr<mir::input::Seat> const& seat,
-        std::shared_ptr<mir::Executor> const& executor);
+        std::shared_ptr<mir::Executor> const& executor,
+        bool touch_resampling);
 
     ~WlSeat();
 
@@ -63,6 +67,30 @@ public:
     void for_each_listener(wl_client* client, std::function<void(WlPointer*)> func);
     void for_each_listener(wl_client* client, std::function<void(WlKeyboard*)> func);
     void for_each_listener(wl_client* client, std::function<void(WlTouch*)> func);
+    void for_each_listener(wl_client* client, std::function<void(TabletToolV2*)> func);
+
+    /// Tablet tools are created through the tablet protocol rather than the seat, so they register here
+    /// \returns the function the tool must call when it is destroyed (which is safe after the seat is gone)
+    auto add_listener(wl_client* client, TabletToolV2* tool) -> std::function<void()>;
+
+    /// Mir reports a tablet as a touchscreen, so a pen device is only known to the seat once it has
+    /// delivered stylus input. It is forgotten when the device is removed.
+    class TabletListener
+    {
+    public:
+        /// Called when the seat gains its first pen device, or loses its last
+        virtual void pen_devices_changed(bool any) = 0;
+
+        TabletListener() = default;
+        virtual ~TabletListener() = default;
+        TabletListener(TabletListener const&) = delete;
+        TabletListener& operator=(TabletListener const&) = delete;
+    };
+
+    /// \returns the function the listener must call when it is destroyed (which is safe after the seat is gone)
+    auto add_tablet_listener(TabletListener* listener) -> std::function<void()>;
+    auto has_pen_devices() const -> bool;
+    void notify_pen_device(MirInputDeviceId id);
 
     void spawn(std::function<void()>&& work);
 
@@ -80,12 +108,37 @@ public:
     void add_focus_listener(ListenerTracker* listener);
     void remove_focus_listener(ListenerTracker* listener);
     void notify_focus(wl_client* focus);
+    auto current_focus() const -> wl_client* { return focused_client; } ///< Can be null
+
+    class PointerMotionListener
+    {
+    public:
+        /// The pointer has entered or moved over \p window, to \p position (relative to \p window)
+        virtual void pointer_moved(WlSurface* window, geometry::Point const& position) = 0;
+
+        PointerMotionListener() = default;
+        virtual ~PointerMotionListener() = default;
+        PointerMotionListener(PointerMotionListener const&) = delete;
+        PointerMotionListener& operator=(PointerMotionListener const&) = delete;
+    };
+
+    void add_pointer_motion_listener(PointerMotionListener* listener);
+    void remove_pointer_motion_listener(PointerMotionListener* listener);
+    void notify_pointer_motion(WlSurface* window, geometry::Point const& position);
+
+    /// Pointer constraints, in global coordinates
+    ///@{
+    auto cursor_position() const -> geometry::Point;
+    void set_confinement_regions(geometry::Rectangles const& regions);
+    void reset_confinement_regions();
+    ///@}
 
     void server_restart();
 
 private:
     wl_client* focused_client{nullptr}; ///< Can be null
     std::vector<ListenerTracker*> focus_listeners;
+    std::vector<PointerMotionListener*> pointer_motion_listeners;
 
     struct FocusClient : ListenerTracker
     {
@@ -102,19 +155,24 @@ private:
 
     class ConfigObserver;
     class Instance;
+    struct PenDevices;
 
     std::unique_ptr<mir::input::Keymap> const keymap;
+    // Shared so device removal (reported on the input thread) can safely be handed to our event loop
+    std::shared_ptr<PenDevices> const pen_devices;
     std::shared_ptr<ConfigObserver> const config_observer;
 
     // listener list are shared pointers so devices can keep them around long enough to remove themselves
     std::shared_ptr<ListenerList<WlPointer>> const pointer_listeners;
     std::shared_ptr<ListenerList<WlKeyboard>> const keyboard_listeners;
     std::shared_ptr<ListenerList<WlTouch>> const touch_listeners;
+    std::shared_ptr<ListenerList<TabletToolV2>> const tablet_tool_listeners;
 
     std::shared_ptr<input::InputDeviceHub> const input_hub;
     std::shared_ptr<input::Seat> const seat;
 
     std::shared_ptr<mir::Executor> const executor;
+    bool const touch_resampling;
 
     void bind(wl_resource* new_wl_seat) override;
 
@@ -46,6 +46,17 @@ namespace geom = mir::geometry;
 namespace mw = mir::wayland;
 namespace msh = mir::shell;
 
+using namespace std::chrono_literals;
+
+namespace
+{
+// Until a client has drawn a couple of frames, assume it draws at 60Hz
+auto const default_frame_interval = std::chrono::nanoseconds{1s}/60;
+
+// Frames further apart than this mean the client paused drawing, not that it draws this slowly
+auto const max_frame_interval = 100ms;
+}
+
 mf::WlSurfaceState::Callback::Callback(wl_resource* new_resource)
     : mw::Callback{new_resource, Version<1>()},
       destroyed{deleted_flag_for_resource(resource)}
@@ -89,6 +100,7 @@ mf::WlSurface::WlSurface(
         executor{executor},
         null_role{this},
         role{&null_role},
+        frame_interval_{default_frame_interval},
         destroyed{std::make_shared<bool>(false)}
 {
     // wl_surface is specified to act in mailbox mode
@@ -224,8 +236,28 @@ mf::WlSurface* mf::WlSurface::from(wl_resource* resource)
     return static_cast<WlSurface*>(static_cast<wayland::Surface*>(raw_surface));
 }
 
+void mf::WlSurface::on_next_frame(std::function<void()> const& callback)
+{
+    next_frame_callbacks.push_back(callback);
+}
+
 void mf::WlSurface::send_frame_callbacks()
 {
+    if (!frame_callbacks.empty())
+    {
+        auto const now = std::chrono::steady_clock::now();
+        auto const interval = now - last_frame;
+        if (interval < max_frame_interval)
+            frame_interval_ = (3*frame_interval_ + interval)/4;
+        last_frame = now;
+
+        // Anything sent by these (e.g. resampled input) reaches the client ahead of the frame callbacks
+        std::vector<std::function<void()>> callbacks;
+        callbacks.swap(next_frame_callbacks);
+        for (auto const& callback : callbacks)
+            callback();
+    }
+
     for (auto const& frame : frame_callbacks)
     {
         if (!*frame->destroyed)
@@ -27,6 +27,7 @@
 #include "mir/geometry/size.h"
 #include "mir/geometry/point.h"
 
+#include <chrono>
 #include <vector>
 #include <map>
 
@@ -143,6 +144,12 @@ public:
     void commit(WlSurfaceState const& state);
     void add_destroy_listener(void const* key, std::function<void()> listener);
     void remove_destroy_listener(void const* key);
+    /// If the client is waiting on a frame callback (i.e. rendering continuously)
+    bool awaiting_frame() const { return !frame_callbacks.empty(); }
+    /// Called once, just before the next frame callbacks are sent
+    void on_next_frame(std::function<void()> const& callback);
+    /// How often the client has been drawing, while it draws continuously
+    auto frame_interval() const -> std::chrono::nanoseconds { return frame_interval_; }
 
     std::shared_ptr<scene::Session> const session;
     std::shared_ptr<compositor::BufferStream> const stream;
@@ -161,6 +168,9 @@ private:
     geometry::Displacement offset_;
     std::experimental::optional<geometry::Size> buffer_size_;
     std::vector<std::shared_ptr<WlSurfaceState::Callback>> frame_callbacks;
+    std::vector<std::function<void()>> next_frame_callbacks;
+    std::chrono::steady_clock::time_point last_frame;
+    std::chrono::nanoseconds frame_interval_;
     std::experimental::optional<std::vector<mir::geometry::Rectangle>> input_shape;
     std::map<void const*, std::function<void()>> destroy_listeners;
     std::shared_ptr<bool> const destroyed;
@@ -29,11 +29,28 @@ namespace mf = mir::frontend;
 namespace mw = mir::wayland;
 namespace geom = mir::geometry;
 
+using namespace std::chrono_literals;
+
+namespace
+{
+// Don't hold motion back for longer than this waiting for the client to draw
+auto const max_motion_delay = 50ms;
+}
+
 mf::WlTouch::WlTouch(
     wl_resource* new_resource,
+    bool resample,
     std::function<void(WlTouch*)> const& on_destroy)
     : Touch(new_resource, Version<6>()),
-      on_destroy{on_destroy}
+      on_destroy{on_destroy},
+      resample{resample},
+      held_motion{
+          client,
+          max_motion_delay,
+          [this](WlSurface* surface, std::chrono::nanoseconds presentation)
+          {
+              send_resampled_motion(surface, presentation);
+          }}
 {
 }
 
@@ -42,13 +59,18 @@ mf::WlTouch::~WlTouch()
     on_destroy(this);
 }
 
+auto mf::WlTouch::from(wl_resource* resource) -> WlTouch*
+{
+    return static_cast<WlTouch*>(wayland::Touch::from(resource));
+}
+
 void mf::WlTouch::release()
 {
     destroy_wayland_object();
 }
 
 void mf::WlTouch::down(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& timestamp,
     int32_t touch_id,
     WlSurface* parent,
     geometry::Point const& position_on_parent)
@@ -56,8 +78,11 @@ void mf::WlTouch::down(
     auto const final = parent->transform_point(position_on_parent);
     auto const serial = wl_display_next_serial(wl_client_get_display(client));
 
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+
     focused_surface_for_ids[touch_id] = final.surface;
 
+    timestamps.send(timestamp);
     send_down_event(
         serial,
         ms.count(),
@@ -69,7 +94,7 @@ void mf::WlTouch::down(
 }
 
 void mf::WlTouch::motion(
-    std::chrono::milliseconds const& ms,
+    std::chrono::nanoseconds const& timestamp,
     int32_t touch_id,
     WlSurface* /* parent */,
     geometry::Point const& position_on_parent)
@@ -84,21 +109,47 @@ void mf::WlTouch::motion(
 
     // TODO: do this better, using parent
     auto const position_on_final = position_on_parent - final_surface->second->total_offset();
+    float const x = position_on_final.x.as_int();
+    float const y = position_on_final.y.as_int();
 
-    send_motion_event(
-        ms.count(),
-        touch_id,
-        position_on_final.x.as_int(),
-        position_on_final.y.as_int());
-    can_send_frame = true;
+    // A client asking for the exact time of each sample wants the samples themselves
+    if (!resample || !timestamps.empty())
+    {
+        send_motion(timestamp, touch_id, x, y);
+        return;
+    }
+
+    resamplers[touch_id].add({timestamp, x, y});
+
+    auto const surface = final_surface->second;
+
+    if (!surface->awaiting_frame())
+    {
+        // The client isn't drawing (or is hidden): there's no frame to align with
+        unsent_motion.erase(touch_id);
+        send_motion(timestamp, touch_id, x, y);
+        return;
+    }
+
+    unsent_motion.insert(touch_id);
+    held_motion.hold_for(surface);
 }
 
-void mf::WlTouch::up(std::chrono::milliseconds const& ms, int32_t touch_id)
+void mf::WlTouch::up(std::chrono::nanoseconds const& timestamp, int32_t touch_id)
 {
+    // The client should see where the touch ended before it ends
+    send_unsent_motion(touch_id);
+    resamplers.erase(touch_id);
+    if (unsent_motion.empty())
+        held_motion.reset();
+
     auto const serial = wl_display_next_serial(wl_client_get_display(client));
 
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+
     focused_surface_for_ids.erase(touch_id);
 
+    timestamps.send(timestamp);
     send_up_event(
         serial,
         ms.count(),
@@ -106,6 +157,59 @@ void mf::WlTouch::up(std::chrono::milliseconds const& ms, int32_t touch_id)
     can_send_frame = true;
 }
 
+void mf::WlTouch::send_motion(std::chrono::nanoseconds const& timestamp, int32_t touch_id, float x, float y)
+{
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp);
+
+    timestamps.send(timestamp);
+    send_motion_event(
+        ms.count(),
+        touch_id,
+        x,
+        y);
+    can_send_frame = true;
+}
+
+void mf::WlTouch::send_unsent_motion(int32_t touch_id)
+{
+    if (!unsent_motion.erase(touch_id))
+        return;
+
+    if (auto const sample = resamplers[touch_id].latest())
+        send_motion(sample->time, touch_id, sample->x, sample->y);
+}
+
+void mf::WlTouch::send_resampled_motion(WlSurface* surface, std::chrono::nanoseconds presentation)
+{
+    for (auto i = unsent_motion.begin(); i != unsent_motion.end();)
+    {
+        auto const touch_id = *i;
+
+        if (surface)
+        {
+            // Only the contacts on the surface that is about to draw
+            auto const focus = focused_surface_for_ids.find(touch_id);
+            if (focus == focused_surface_for_ids.end() || focus->second != surface)
+            {
+                ++i;
+                continue;
+            }
+
+            if (auto const sample = resamplers[touch_id].resample_at(presentation))
+                send_motion(sample->time, touch_id, sample->x, sample->y);
+        }
+        else if (auto const sample = resamplers[touch_id].latest())
+        {
+            // The client is too slow to draw for there to be a frame to resample to
+            send_motion(sample->time, touch_id, sample->x, sample->y);
+        }
+
+        i = unsent_motion.erase(i);
+    }
+
+    frame();
+}
+
 void mf::WlTouch::frame()
 {
     if (can_send_frame)
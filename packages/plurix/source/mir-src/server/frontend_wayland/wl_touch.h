@@ -20,12 +20,17 @@
 #define MIR_FRONTEND_WL_TOUCH_H
 
 #include "wayland_wrapper.h"
+#include "input_timestamps_v1.h"
+#include "frame_aligned_input.h"
+#include "touch_resampler.h"
 
 #include "mir/geometry/point.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <chrono>
+#include <memory>
 
 namespace mir
 {
@@ -38,29 +43,46 @@ class WlSurface;
 class WlTouch : public wayland::Touch
 {
 public:
+    /// \param resample  Coalesce motion to one (resampled) update per frame for continuously rendering clients.
+    ///                  Clients that subscribe to high resolution input timestamps get the original samples.
     WlTouch(
         wl_resource* new_resource,
+        bool resample,
         std::function<void(WlTouch*)> const& on_destroy);
 
     ~WlTouch();
 
+    static auto from(wl_resource* resource) -> WlTouch*;
+
     void down(
-        std::chrono::milliseconds const& ms,
+        std::chrono::nanoseconds const& timestamp,
         int32_t touch_id,
         WlSurface* parent,
         geometry::Point const& position_on_parent);
     void motion(
-        std::chrono::milliseconds const& ms,
+        std::chrono::nanoseconds const& timestamp,
         int32_t touch_id,
         WlSurface* parent,
         geometry::Point const& position_on_parent);
-    void up(std::chrono::milliseconds const& ms, int32_t touch_id);
+    void up(std::chrono::nanoseconds const& timestamp, int32_t touch_id);
     void frame();
 
+    auto timestamp_listeners() -> InputTimestampListeners& { return timestamps; }
+
 private:
     std::function<void(WlTouch*)> on_destroy;
     std::unordered_map<int32_t, WlSurface*> focused_surface_for_ids;
     bool can_send_frame{false};
+    InputTimestampListeners timestamps;
+
+    bool const resample;
+    std::unordered_map<int32_t, TouchResampler> resamplers;
+    std::unordered_set<int32_t> unsent_motion;
+    FrameAlignedInput held_motion;
+
+    void send_motion(std::chrono::nanoseconds const& timestamp, int32_t touch_id, float x, float y);
+    void send_unsent_motion(int32_t touch_id);
+    void send_resampled_motion(WlSurface* surface, std::chrono::nanoseconds presentation);
 
     void release() override;
 };
@@ -27,6 +27,7 @@
 #include "mir/log.h"
 
 #include <boost/throw_exception.hpp>
+#include <functional>
 
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
@@ -58,6 +59,12 @@ public:
 
     void send_configure();
 
+    /// True from sending a configure until the client acknowledges it
+    auto configure_in_flight() const -> bool { return static_cast<bool>(unacked_configure); }
+    /// Sends a configure sequence once the one in flight is acknowledged, replacing any already deferred
+    /// Callers are expected to build the configure from their state at that time, so changes coalesce
+    void defer_configure(std::function<void()> const& send);
+
     std::experimental::optional<WindowWlSurfaceRole*> const& window_role();
 
     using wayland::XdgSurface::client;
@@ -70,6 +77,9 @@ private:
     std::shared_ptr<bool> window_role_destroyed;
     WlSurface* const surface;
 
+    std::experimental::optional<uint32_t> unacked_configure;
+    std::function<void()> deferred_configure; ///< Only valid while the window role is alive
+
 public:
     XdgShellStable const& xdg_shell;
 };
@@ -248,14 +258,32 @@ void mf::XdgSurfaceStable::set_window_geometry(int32_t x, int32_t y, int32_t wid
 
 void mf::XdgSurfaceStable::ack_configure(uint32_t serial)
 {
-    (void)serial;
-    // TODO
+    // Serials increase monotonically (with wraparound), a client may ack a later configure than we expect
+    // but must not ack one we have not sent
+    if (!unacked_configure || static_cast<int32_t>(serial - unacked_configure.value()) < 0)
+        return;
+
+    unacked_configure = std::experimental::nullopt;
+
+    if (deferred_configure)
+    {
+        auto const send = std::move(deferred_configure);
+        deferred_configure = nullptr;
+        if (window_role_ && !*window_role_destroyed)
+            send();
+    }
 }
 
 void mf::XdgSurfaceStable::send_configure()
 {
     auto const serial = wl_display_next_serial(wl_client_get_display(wayland::XdgSurface::client));
     send_configure_event(serial);
+    unacked_configure = serial;
+}
+
+void mf::XdgSurfaceStable::defer_configure(std::function<void()> const& send)
+{
+    deferred_configure = send;
 }
 
 std::experimental::optional<mf::WindowWlSurfaceRole*> const& mf::XdgSurfaceStable::window_role()
@@ -521,6 +549,15 @@ void mf::XdgToplevelStable::handle_close_request()
 
 void mf::XdgToplevelStable::send_toplevel_configure()
 {
+    // During an interactive resize the size changes on (almost) every pointer motion. Rather than queue up
+    // configures for sizes that are stale before a slow client gets to them, send at most one at a time and
+    // send the latest state when it is acknowledged.
+    if (xdg_surface->configure_in_flight())
+    {
+        xdg_surface->defer_configure([this]() { send_toplevel_configure(); });
+        return;
+    }
+
     wl_array states;
     wl_array_init(&states);
 
@@ -322,7 +322,7 @@ void mf::XWaylandSurface::take_focus()
         window,
         XCB_CURRENT_TIME);
 
-    connection->flush();
+    xwm->flush_soon();
 }
 
 void mf::XWaylandSurface::configure_request(xcb_configure_request_event_t* event)
@@ -636,6 +636,24 @@ void mf::XWaylandSurface::move_resize(uint32_t detail)
     }
 }
 
+void mf::XWaylandSurface::send_pending_configuration()
+{
+    std::experimental::optional<geom::Point> top_left;
+    std::experimental::optional<geom::Size> size;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        std::swap(top_left, pending_configuration.top_left);
+        std::swap(size, pending_configuration.size);
+    }
+
+    connection->configure_window(
+        window,
+        top_left,
+        size,
+        std::experimental::nullopt,
+        std::experimental::nullopt);
+}
+
 auto mf::XWaylandSurface::WindowState::operator==(WindowState const& that) const -> bool
 {
     return
@@ -736,13 +754,7 @@ void mf::XWaylandSurface::scene_surface_state_set(MirWindowState new_state)
 
 void mf::XWaylandSurface::scene_surface_resized(geometry::Size const& new_size)
 {
-    connection->configure_window(
-        window,
-        std::experimental::nullopt,
-        new_size,
-        std::experimental::nullopt,
-        std::experimental::nullopt);
-    connection->flush();
+    configure_soon(std::experimental::nullopt, new_size);
 }
 
 void mf::XWaylandSurface::scene_surface_moved_to(geometry::Point const& new_top_left)
@@ -753,13 +765,7 @@ void mf::XWaylandSurface::scene_surface_moved_to(geometry::Point const& new_top_
         scene_surface = weak_scene_surface.lock();
     }
     auto const content_offset = scene_surface ? scene_surface->content_offset() : geom::Displacement{};
-    connection->configure_window(
-        window,
-        new_top_left + content_offset,
-        std::experimental::nullopt,
-        std::experimental::nullopt,
-        std::experimental::nullopt);
-    connection->flush();
+    configure_soon(new_top_left + content_offset, std::experimental::nullopt);
 }
 
 void mf::XWaylandSurface::scene_surface_close_requested()
@@ -997,7 +1003,7 @@ void mf::XWaylandSurface::inform_client_of_window_state(WindowState const& new_w
         connection->set_property<XCBType::ATOM>(window, connection->net_wm_state, net_wm_states);
     }
 
-    connection->flush();
+    xwm->flush_soon();
 }
 
 void mf::XWaylandSurface::request_scene_surface_state(MirWindowState new_state)
@@ -1029,3 +1035,18 @@ auto mf::XWaylandSurface::latest_input_timestamp(std::lock_guard<std::mutex> con
         return {};
     }
 }
+
+void mf::XWaylandSurface::configure_soon(
+    std::experimental::optional<geom::Point> const& top_left,
+    std::experimental::optional<geom::Size> const& size)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (top_left)
+            pending_configuration.top_left = top_left;
+        if (size)
+            pending_configuration.size = size;
+    }
+
+    xwm->configure_soon(window);
+}
@@ -66,6 +66,9 @@ public:
     void property_notify(xcb_atom_t property);
     void attach_wl_surface(WlSurface* wl_surface); ///< Should only be called on the Wayland thread
     void move_resize(uint32_t detail);
+    /// Sends the geometry accumulated by scene_surface_moved_to() and scene_surface_resized()
+    /// Should only be called by the XWaylandWM, which flushes afterwards
+    void send_pending_configuration();
 
 private:
     /// contains more information than just a MirWindowState
@@ -123,6 +126,11 @@ private:
 
     auto latest_input_timestamp(std::lock_guard<std::mutex> const&) -> std::chrono::nanoseconds;
 
+    /// Updates the pending configuration, and has the XWaylandWM send it soon
+    void configure_soon(
+        std::experimental::optional<geometry::Point> const& top_left,
+        std::experimental::optional<geometry::Size> const& size);
+
     XWaylandWM* const xwm;
     std::shared_ptr<XCBConnection> const connection;
     WlSeat& seat;
@@ -153,6 +161,13 @@ private:
     std::weak_ptr<scene::Session> weak_session;
     std::unique_ptr<shell::SurfaceSpecification> nullable_pending_spec;
     std::weak_ptr<scene::Surface> weak_scene_surface;
+
+    /// Geometry yet to be sent to the client: only the latest matters
+    struct
+    {
+        std::experimental::optional<geometry::Point> top_left;
+        std::experimental::optional<geometry::Size> size;
+    } pending_configuration;
 };
 } /* frontend */
 } /* mir */
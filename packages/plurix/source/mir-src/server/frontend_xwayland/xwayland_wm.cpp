@@ -81,7 +81,8 @@ mf::XWaylandWM::XWaylandWM(std::shared_ptr<WaylandConnector> wayland_connector,
       wayland_connector(wayland_connector),
       dispatcher{std::make_shared<mir::dispatch::MultiplexingDispatchable>()},
       wayland_client{wayland_client},
-      wm_shell{std::static_pointer_cast<XWaylandWMShell>(wayland_connector->get_extension("x11-support"))}
+      wm_shell{std::static_pointer_cast<XWaylandWMShell>(wayland_connector->get_extension("x11-support"))},
+      deferred{std::make_shared<DeferredFlush>(this)}
 {
     if (xcb_connection_has_error(*connection))
     {
@@ -134,6 +135,12 @@ mf::XWaylandWM::XWaylandWM(std::shared_ptr<WaylandConnector> wayland_connector,
 
 mf::XWaylandWM::~XWaylandWM()
 {
+    // A flush may already be waiting on the Wayland loop
+    {
+        std::lock_guard<std::mutex> lock{deferred->mutex};
+        deferred->wm = nullptr;
+    }
+
     // clear the surfaces map and then destroy all surfaces
     std::map<xcb_window_t, std::shared_ptr<XWaylandSurface>> local_surfaces;
 
@@ -343,6 +350,62 @@ void mf::XWaylandWM::run_on_wayland_thread(std::function<void()>&& work)
     wayland_connector->run_on_wayland_display([work = move(work)](auto){ work(); });
 }
 
+void mf::XWaylandWM::configure_soon(xcb_window_t xcb_window)
+{
+    {
+        std::lock_guard<std::mutex> lock{deferred_mutex};
+        configure_pending.insert(xcb_window);
+    }
+    flush_soon();
+}
+
+void mf::XWaylandWM::flush_soon()
+{
+    {
+        std::lock_guard<std::mutex> lock{deferred_mutex};
+        if (flush_scheduled)
+            return;
+        flush_scheduled = true;
+    }
+
+    // Scene changes are mostly made while the Wayland thread dispatches client requests, so wait
+    // until it has dispatched everything that's ready before sending anything
+    wayland_connector->run_on_wayland_display([deferred = deferred](wl_display* display)
+        {
+            wl_event_loop_add_idle(
+                wl_display_get_event_loop(display),
+                &XWaylandWM::flush_deferred_when_idle,
+                new std::shared_ptr<DeferredFlush>{deferred});
+        });
+}
+
+void mf::XWaylandWM::flush_deferred_when_idle(void* data)
+{
+    std::unique_ptr<std::shared_ptr<DeferredFlush>> const deferred{static_cast<std::shared_ptr<DeferredFlush>*>(data)};
+
+    std::lock_guard<std::mutex> lock{(*deferred)->mutex};
+    if ((*deferred)->wm)
+        (*deferred)->wm->flush_deferred();
+}
+
+void mf::XWaylandWM::flush_deferred()
+{
+    std::set<xcb_window_t> windows;
+    {
+        std::lock_guard<std::mutex> lock{deferred_mutex};
+        windows.swap(configure_pending);
+        flush_scheduled = false;
+    }
+
+    for (auto const window : windows)
+    {
+        if (auto const surface = get_wm_surface(window))
+            surface.value()->send_pending_configuration();
+    }
+
+    connection->flush();
+}
+
 /* Events */
 void mf::XWaylandWM::handle_events()
 {
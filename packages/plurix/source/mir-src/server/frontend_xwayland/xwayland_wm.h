@@ -24,6 +24,7 @@
 #include "xcb_connection.h"
 
 #include <map>
+#include <set>
 #include <thread>
 #include <experimental/optional>
 #include <mutex>
@@ -69,6 +70,13 @@ public:
     void set_focus(xcb_window_t xcb_window, bool should_be_focused);
     void run_on_wayland_thread(std::function<void()>&& work);
 
+    /// Send the window's pending configuration, and flush the connection, once the Wayland thread has
+    /// dispatched everything that's ready. Any number of calls before then result in a single
+    /// configure and flush.
+    void configure_soon(xcb_window_t xcb_window);
+    /// Flush the connection once the Wayland thread has dispatched everything that's ready
+    void flush_soon();
+
 private:
     enum CursorType
     {
@@ -111,6 +119,9 @@ private:
     void handle_destroy_notify(xcb_destroy_notify_event_t *event);
     void handle_focus_in(xcb_focus_in_event_t* event);
 
+    static void flush_deferred_when_idle(void* data);
+    void flush_deferred();
+
     std::mutex mutex;
 
     // Cursor
@@ -127,6 +138,20 @@ private:
     std::map<xcb_window_t, std::shared_ptr<XWaylandSurface>> surfaces;
     std::experimental::optional<xcb_window_t> focused_window;
     std::shared_ptr<dispatch::ReadableFd> wm_dispatcher;
+
+    /// Shared with flushes waiting on the Wayland loop, so they can tell if the WM has gone
+    struct DeferredFlush
+    {
+        DeferredFlush(XWaylandWM* wm) : wm{wm} {}
+
+        std::mutex mutex;
+        XWaylandWM* wm;
+    };
+    std::shared_ptr<DeferredFlush> const deferred;
+
+    std::mutex deferred_mutex;
+    bool flush_scheduled{false};
+    std::set<xcb_window_t> configure_pending;
     int xcb_cursor;
     std::vector<xcb_cursor_t> xcb_cursors;
     xcb_window_t xcb_selection_window;
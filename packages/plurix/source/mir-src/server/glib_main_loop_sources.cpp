@@ -23,8 +23,11 @@
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
+#include <mutex>
 #include <system_error>
 #include <sstream>
+#include <vector>
 
 #include <csignal>
 #include <unistd.h>
@@ -179,78 +182,226 @@ void md::add_idle_gsource(
     g_source_attach(gsource, main_context);
 }
 
-void md::add_server_action_gsource(
-    GMainContext* main_context,
-    void const* owner,
-    std::function<void()> const& action,
-    std::function<bool(void const*)> const& should_dispatch)
+namespace
 {
-    struct ServerActionContext
+/*
+ * A single, persistent source per GMainContext holding all the server actions
+ * queued on it. Each iteration dispatches every action whose owner isn't paused,
+ * so bursts of actions cost a queue push each rather than a GSource each.
+ */
+struct ServerActionQueueGSource
+{
+    struct Action
     {
-        void const* const owner;
-        std::function<void(void)> const action;
-        std::function<bool(void const*)> const should_dispatch;
+        void const* owner;
+        std::function<void()> action;
+        std::function<bool(void const*)> should_dispatch;
 
-        // If we come to finalize() before dispatch() we have already
-        // torn down most of Mir and even unloaded some shared libraries.
-        // That means the action could refer to  stuff that is no longer
-        // in the address space.
-        // We will just leak any resources instead of crashing.
-        bool mutable dispatched{false};
+        bool ready() const { return should_dispatch(owner); }
     };
 
-    struct ServerActionGSource
+    struct Queue
     {
-        GSource gsource;
-        ServerActionContext ctx;
-        bool ctx_constructed;
-
-        static gboolean prepare(GSource* source, gint *timeout)
+        std::mutex mutex;
+        std::deque<Action> actions;
+        // Set when actions are queued, until they are next dispatched
+        bool dispatch_pending{false};
+        // Owners of the actions left queued because they were paused (one entry per owner)
+        std::vector<Action> paused_owners;
+        // Set once the loop has been woken for queued actions, until it next prepares the source
+        bool wakeup_pending{false};
+
+        /// Whether dispatching would run anything; needs the mutex held
+        bool any_ready() const
         {
-            *timeout = -1;
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            return ctx.should_dispatch(ctx.owner);
+            return dispatch_pending ||
+                std::any_of(begin(paused_owners), end(paused_owners), [](Action const& a) { return a.ready(); });
         }
+    };
 
-        static gboolean check(GSource* source)
+    GSource gsource;
+    Queue queue;
+    bool queue_constructed;
+
+    static auto queue_for(GSource* source) -> Queue&
+    {
+        return reinterpret_cast<ServerActionQueueGSource*>(source)->queue;
+    }
+
+    static gboolean prepare(GSource* source, gint *timeout)
+    {
+        *timeout = -1;
+
+        auto& queue = queue_for(source);
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.wakeup_pending = false;
+        return queue.any_ready();
+    }
+
+    static gboolean check(GSource* source)
+    {
+        auto& queue = queue_for(source);
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        return queue.any_ready();
+    }
+
+    static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+    {
+        auto& queue = queue_for(source);
+
+        // Only drain what is queued now: actions queued by these actions wait for the next iteration
+        std::deque<Action> pending;
         {
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            return ctx.should_dispatch(ctx.owner);
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            pending.swap(queue.actions);
+            queue.dispatch_pending = false;
+            queue.paused_owners.clear();
         }
 
-        static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+        std::deque<Action> deferred;
+        while (!pending.empty())
         {
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            ctx.action();
-            ctx.dispatched = true;
-            return FALSE;
+            auto next = std::move(pending.front());
+            pending.pop_front();
+
+            // Owners may be paused by an earlier action in this batch; keep their actions for later
+            if (next.ready())
+                next.action();
+            else
+                deferred.push_back(std::move(next));
         }
 
-        static void finalize(GSource* source)
+        if (!deferred.empty())
         {
-            auto const sa_gsource = reinterpret_cast<ServerActionGSource*>(source);
-            if (sa_gsource->ctx_constructed && sa_gsource->ctx.dispatched)
-                sa_gsource->ctx.~ServerActionContext();
+            std::lock_guard<std::mutex> lock{queue.mutex};
+
+            // Resuming an owner only wakes the loop, so prepare() asks each paused owner again
+            for (auto const& action : deferred)
+            {
+                auto const& owners = queue.paused_owners;
+                if (std::none_of(begin(owners), end(owners), [&](Action const& a) { return a.owner == action.owner; }))
+                    queue.paused_owners.push_back({action.owner, {}, action.should_dispatch});
+            }
+
+            queue.actions.insert(begin(queue.actions),
+                std::make_move_iterator(begin(deferred)), std::make_move_iterator(end(deferred)));
         }
-    };
 
-    static GSourceFuncs gsource_funcs{
-        ServerActionGSource::prepare,
-        ServerActionGSource::check,
-        ServerActionGSource::dispatch,
-        ServerActionGSource::finalize,
-        nullptr,
-        nullptr
-    };
+        return G_SOURCE_CONTINUE;
+    }
 
-    GSourceRef gsource{g_source_new(&gsource_funcs, sizeof(ServerActionGSource))};
-    auto const sa_gsource = reinterpret_cast<ServerActionGSource*>(static_cast<GSource*>(gsource));
+    static void finalize(GSource* source)
+    {
+        forget(source);
+
+        auto const sa_gsource = reinterpret_cast<ServerActionQueueGSource*>(source);
+
+        // If we come to finalize() with actions still queued we have already
+        // torn down most of Mir and even unloaded some shared libraries.
+        // That means the actions could refer to stuff that is no longer
+        // in the address space.
+        // We will just leak any resources instead of crashing.
+        if (sa_gsource->queue_constructed && sa_gsource->queue.actions.empty())
+            sa_gsource->queue.~Queue();
+    }
+
+    static GSourceFuncs gsource_funcs;
+
+    // Identifies our source to g_main_context_find_source_by_funcs_user_data()
+    static int tag;
+
+    /*
+     * The source last looked up. Actions are (nearly always) all queued on the
+     * server's one main loop, so this saves each of them a search of the
+     * context's sources. No reference is held: the source belongs to the loop's
+     * context, and forgets itself here when that finalizes it.
+     */
+    static std::mutex lookup_mutex;
+    static GSource* last_looked_up;
+
+    static void forget(GSource* source)
+    {
+        std::lock_guard<std::mutex> lock{lookup_mutex};
+        if (last_looked_up == source)
+            last_looked_up = nullptr;
+    }
+};
+
+GSourceFuncs ServerActionQueueGSource::gsource_funcs{
+    ServerActionQueueGSource::prepare,
+    ServerActionQueueGSource::check,
+    ServerActionQueueGSource::dispatch,
+    ServerActionQueueGSource::finalize,
+    nullptr,
+    nullptr
+};
+
+int ServerActionQueueGSource::tag;
+std::mutex ServerActionQueueGSource::lookup_mutex;
+GSource* ServerActionQueueGSource::last_looked_up{nullptr};
+
+gboolean unused_callback(gpointer)
+{
+    return G_SOURCE_CONTINUE;
+}
+
+// Needs ServerActionQueueGSource::lookup_mutex held, so only one source is created per context
+auto create_server_action_queue(GMainContext* main_context) -> GSource*
+{
+    if (auto const existing = g_main_context_find_source_by_funcs_user_data(
+            main_context, &ServerActionQueueGSource::gsource_funcs, &ServerActionQueueGSource::tag))
+    {
+        return existing;
+    }
+
+    GSourceRef gsource{g_source_new(&ServerActionQueueGSource::gsource_funcs, sizeof(ServerActionQueueGSource))};
+    auto const sa_gsource = reinterpret_cast<ServerActionQueueGSource*>(static_cast<GSource*>(gsource));
+
+    sa_gsource->queue_constructed = false;
+    new (&sa_gsource->queue) ServerActionQueueGSource::Queue{};
+    sa_gsource->queue_constructed = true;
 
-    sa_gsource->ctx_constructed = false;
-    new (&sa_gsource->ctx) decltype(sa_gsource->ctx){owner, action, should_dispatch};
-    sa_gsource->ctx_constructed = true;
+    g_source_set_callback(gsource, &unused_callback, &ServerActionQueueGSource::tag, nullptr);
 
+    // The context keeps the source alive until the context itself is destroyed
     g_source_attach(gsource, main_context);
+
+    return gsource;
+}
+
+auto server_action_queue_for(GMainContext* main_context) -> ServerActionQueueGSource::Queue&
+{
+    std::lock_guard<std::mutex> lock{ServerActionQueueGSource::lookup_mutex};
+
+    auto& last = ServerActionQueueGSource::last_looked_up;
+    if (!last || g_source_is_destroyed(last) || g_source_get_context(last) != main_context)
+        last = create_server_action_queue(main_context);
+
+    return ServerActionQueueGSource::queue_for(last);
+}
+}
+
+void md::add_server_action_gsource(
+    GMainContext* main_context,
+    void const* owner,
+    std::function<void()> const& action,
+    std::function<bool(void const*)> const& should_dispatch)
+{
+    auto& queue = server_action_queue_for(main_context);
+
+    bool wakeup_needed;
+    {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.actions.push_back({owner, action, should_dispatch});
+        queue.dispatch_pending = true;
+        wakeup_needed = !queue.wakeup_pending;
+        queue.wakeup_pending = true;
+    }
+
+    // The source is persistent, so the loop has to be woken to prepare() it again.
+    // Once is enough for everything queued before it does.
+    if (wakeup_needed)
+        g_main_context_wakeup(main_context);
 }
 
 md::GSourceHandle md::add_timer_gsource(
@@ -268,6 +268,11 @@ void mi::CursorController::cursor_moved_to(float abs_x, float abs_y)
     {
         std::unique_lock<std::mutex> lock(cursor_state_guard);
 
+        // Relative motion against a locked (or fully confined) pointer doesn't move the cursor,
+        // and scene changes are handled by UpdateCursorOnSceneChanges, so there is nothing to do
+        if (new_location == cursor_location)
+            return;
+
         cursor_location = new_location;
 
         update_cursor_image_locked(lock);
@@ -32,6 +32,7 @@
 #include "surface_input_dispatcher.h"
 #include "basic_seat.h"
 #include "seat_observer_multiplexer.h"
+#include "event_type_filter.h"
 
 #include "mir/input/touch_visualizer.h"
 #include "mir/input/input_probe.h"
@@ -83,8 +84,10 @@ mir::DefaultServerConfiguration::the_event_filter_chain_dispatcher()
                 {
                     try
                     {
-                        default_filter = std::make_shared<mi::VTFilter>(
-                            the_console_services()->create_vt_switcher());
+                        // VT switching only looks at key events, so is never offered pointer motion
+                        default_filter = std::make_shared<mi::TypedEventFilter>(
+                            std::make_shared<mi::VTFilter>(the_console_services()->create_vt_switcher()),
+                            std::vector<MirInputEventType>{mir_input_event_type_key});
                     }
                     catch (std::exception const& err)
                     {
@@ -141,7 +144,7 @@ mir::DefaultServerConfiguration::the_input_dispatcher()
             auto enable_repeat = options->get<bool>(options::enable_key_repeat_opt);
 
             return std::make_shared<mi::KeyRepeatDispatcher>(
-                the_event_filter_chain_dispatcher(), the_main_loop(), the_cookie_authority(),
+                the_event_filter_chain_dispatcher(), the_main_loop(),
                 enable_repeat, key_repeat_timeout, key_repeat_delay, false);
         });
 }
@@ -307,7 +310,6 @@ std::shared_ptr<mi::DefaultInputDeviceHub> mir::DefaultServerConfiguration::the_
            auto hub = std::make_shared<mi::DefaultInputDeviceHub>(
                the_seat(),
                the_input_reading_multiplexer(),
-               the_cookie_authority(),
                the_key_mapper(),
                the_server_status_listener());
 
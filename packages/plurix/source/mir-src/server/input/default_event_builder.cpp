@@ -20,7 +20,6 @@
 #include "default_event_builder.h"
 #include "mir/input/seat.h"
 #include "mir/events/event_builders.h"
-#include "mir/cookie/authority.h"
 
 #include <algorithm>
 
@@ -28,10 +27,8 @@ namespace me = mir::events;
 namespace mi = mir::input;
 
 mi::DefaultEventBuilder::DefaultEventBuilder(MirInputDeviceId device_id,
-                                             std::shared_ptr<mir::cookie::Authority> const& cookie_authority,
                                              std::shared_ptr<mi::Seat> const& seat)
     : device_id(device_id),
-      cookie_authority(cookie_authority),
       seat(seat)
 {
 }
@@ -39,8 +36,7 @@ mi::DefaultEventBuilder::DefaultEventBuilder(MirInputDeviceId device_id,
 mir::EventUPtr mi::DefaultEventBuilder::key_event(Timestamp timestamp, MirKeyboardAction action, xkb_keysym_t key_code,
                                                   int scan_code)
 {
-    auto const cookie = cookie_authority->make_cookie(timestamp.count());
-    return me::make_event(device_id, timestamp, cookie->serialize(), action, key_code, scan_code, mir_input_event_modifier_none);
+    return me::make_event(device_id, timestamp, std::vector<uint8_t>{}, action, key_code, scan_code, mir_input_event_modifier_none);
 }
 
 mir::EventUPtr mi::DefaultEventBuilder::pointer_event(Timestamp timestamp, MirPointerAction action,
@@ -49,13 +45,7 @@ mir::EventUPtr mi::DefaultEventBuilder::pointer_event(Timestamp timestamp, MirPo
 {
     const float x_axis_value = 0;
     const float y_axis_value = 0;
-    std::vector<uint8_t> vec_cookie{};
-    if (action == mir_pointer_action_button_up || action == mir_pointer_action_button_down)
-    {
-        auto const cookie = cookie_authority->make_cookie(timestamp.count());
-        vec_cookie = cookie->serialize();
-    }
-    return me::make_event(device_id, timestamp, vec_cookie, mir_input_event_modifier_none, action, buttons_pressed, x_axis_value, y_axis_value,
+    return me::make_event(device_id, timestamp, std::vector<uint8_t>{}, mir_input_event_modifier_none, action, buttons_pressed, x_axis_value, y_axis_value,
                           hscroll_value, vscroll_value, relative_x_value, relative_y_value);
 }
 
@@ -75,27 +65,11 @@ mir::EventUPtr mi::DefaultEventBuilder::pointer_event(Timestamp timestamp,
                                                       float relative_x_value,
                                                       float relative_y_value)
 {
-    std::vector<uint8_t> vec_cookie{};
-    if (action == mir_pointer_action_button_up || action == mir_pointer_action_button_down)
-    {
-        auto const cookie = cookie_authority->make_cookie(timestamp.count());
-        vec_cookie = cookie->serialize();
-    }
-    return me::make_event(device_id, timestamp, vec_cookie, mir_input_event_modifier_none, action, buttons_pressed, x_axis, y_axis,
+    return me::make_event(device_id, timestamp, std::vector<uint8_t>{}, mir_input_event_modifier_none, action, buttons_pressed, x_axis, y_axis,
                           hscroll_value, vscroll_value, relative_x_value, relative_y_value);
 }
 
 mir::EventUPtr mi::DefaultEventBuilder::touch_event(Timestamp timestamp, std::vector<events::ContactState> const& contacts)
 {
-    std::vector<uint8_t> vec_cookie{};
-    for (auto const& contact : contacts)
-    {
-        if (contact.action == mir_touch_action_up || contact.action == mir_touch_action_down)
-        {
-            auto const cookie = cookie_authority->make_cookie(timestamp.count());
-            vec_cookie = cookie->serialize();
-            break;
-        }
-    }
-    return me::make_event(device_id, timestamp, vec_cookie, mir_input_event_modifier_none, contacts);
+    return me::make_event(device_id, timestamp, std::vector<uint8_t>{}, mir_input_event_modifier_none, contacts);
 }
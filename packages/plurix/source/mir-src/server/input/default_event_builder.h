@@ -25,10 +25,6 @@
 
 namespace mir
 {
-namespace cookie
-{
-class Authority;
-}
 namespace input
 {
 class Seat;
@@ -36,8 +32,8 @@ class Seat;
 class DefaultEventBuilder : public EventBuilder
 {
 public:
+    /// Events are built unsigned: cookies are minted (from the event time) only for those sent to mirclient clients
     explicit DefaultEventBuilder(MirInputDeviceId device_id,
-                                 std::shared_ptr<cookie::Authority> const& cookie_authority,
                                  std::shared_ptr<Seat> const& seat);
 
     EventUPtr key_event(Timestamp timestamp, MirKeyboardAction action, xkb_keysym_t key_code, int scan_code) override;
@@ -57,7 +53,6 @@ public:
 
 private:
     MirInputDeviceId const device_id;
-    std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<Seat> const seat;
 };
 }
@@ -42,10 +42,6 @@ namespace mir
 {
 class ServerActionQueue;
 class ServerStatusListener;
-namespace cookie
-{
-class Authority;
-}
 namespace dispatch
 {
 class Dispatchable;
@@ -85,7 +81,6 @@ class DefaultInputDeviceHub :
 public:
     DefaultInputDeviceHub(std::shared_ptr<Seat> const& seat,
                           std::shared_ptr<dispatch::MultiplexingDispatchable> const& input_multiplexer,
-                          std::shared_ptr<cookie::Authority> const& cookie_authority,
                           std::shared_ptr<KeyMapper> const& key_mapper,
                           std::shared_ptr<ServerStatusListener> const& server_status_listener);
 
@@ -113,7 +108,6 @@ private:
     std::shared_ptr<dispatch::MultiplexingDispatchable> const input_dispatchable;
     std::mutex mutable handles_guard;
     std::shared_ptr<dispatch::ActionQueue> const device_queue;
-    std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<KeyMapper> const key_mapper;
     std::shared_ptr<ServerStatusListener> const server_status_listener;
 
@@ -123,7 +117,6 @@ private:
         RegisteredDevice(std::shared_ptr<InputDevice> const& dev,
                          MirInputDeviceId dev_id,
                          std::shared_ptr<dispatch::ActionQueue> const& multiplexer,
-                         std::shared_ptr<cookie::Authority> const& cookie_authority,
                          std::shared_ptr<DefaultDevice> const& handle);
         void handle_input(std::shared_ptr<MirEvent> const& event) override;
         geometry::Rectangle bounding_rectangle() const override;
@@ -140,7 +133,6 @@ private:
     private:
         MirInputDeviceId device_id;
         std::unique_ptr<DefaultEventBuilder> builder;
-        std::shared_ptr<cookie::Authority> cookie_authority;
         std::shared_ptr<InputDevice> const device;
         std::shared_ptr<dispatch::ActionQueue> queue;
     };
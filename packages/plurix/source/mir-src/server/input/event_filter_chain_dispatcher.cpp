@@ -17,49 +17,185 @@
  */
 
 #include "event_filter_chain_dispatcher.h"
+#include "event_type_filter.h"
+#include "mir/raii.h"
+
+#include <algorithm>
 
 namespace mi = mir::input;
 
+namespace
+{
+auto bucket_for(MirEvent const& event) -> std::size_t
+{
+    if (mir_event_get_type(&event) != mir_event_type_input)
+        return mir_input_event_types;
+
+    return mir_input_event_get_type(mir_event_get_input_event(&event));
+}
+}
+
 mi::EventFilterChainDispatcher::EventFilterChainDispatcher(
     std::vector<std::weak_ptr<mi::EventFilter>> initial_filters,
     std::shared_ptr<mi::InputDispatcher> const& next_dispatcher)
-    : filters(std::move(initial_filters)),
-      next_dispatcher(next_dispatcher)
+    : next_dispatcher(next_dispatcher)
 {
+    for (auto const& filter : initial_filters)
+        filters.push_back(entry_for(filter));
+
+    std::lock_guard<std::mutex> lg(filter_guard);
+    publish_locked();
 }
 
 // TODO: It probably makes sense to provide keymapped events.
 bool mi::EventFilterChainDispatcher::handle(MirEvent const& event)
 {
-    std::lock_guard<std::mutex> lg(filter_guard);
-    
-    auto it = filters.begin();
-    while (it != filters.end())
+    bool found_expired = false;
+    bool handled = false;
+
     {
-        auto filter = (*it).lock();
-        if (!filter)
+        // No lock here: the chain is immutable, and isn't freed while we're counted as reading it
+        auto const reading = raii::paired_calls([this] { ++readers; }, [this] { --readers; });
+
+        for (auto const entry : chain.load()->buckets[bucket_for(event)])
         {
-            it = filters.erase(it);
-            continue;
+            auto const filter = entry->lock();
+            if (!filter)
+            {
+                found_expired = true;
+                continue;
+            }
+
+            if (filter->handle(event))
+            {
+                handled = true;
+                break;
+            }
         }
-        if (filter->handle(event)) return true;
-        ++it;
     }
-    return false;
+
+    if (found_expired || chains_retired)
+        prune_expired();
+
+    return handled;
 }
 
 void mi::EventFilterChainDispatcher::append(std::weak_ptr<EventFilter> const& filter)
 {
-    std::lock_guard<std::mutex> lg(filter_guard);
+    auto entry = entry_for(filter);
+    Chains reclaimed;
 
-    filters.push_back(filter);
+    {
+        std::lock_guard<std::mutex> lg(filter_guard);
+
+        filters.push_back(std::move(entry));
+        publish_locked();
+        reclaimed = reclaim_locked();
+    }
 }
 
 void mi::EventFilterChainDispatcher::prepend(std::weak_ptr<EventFilter> const& filter)
 {
+    auto entry = entry_for(filter);
+    Chains reclaimed;
+
+    {
+        std::lock_guard<std::mutex> lg(filter_guard);
+
+        filters.insert(filters.begin(), std::move(entry));
+        publish_locked();
+        reclaimed = reclaim_locked();
+    }
+}
+
+auto mi::EventFilterChainDispatcher::entry_for(std::weak_ptr<EventFilter> const& filter) -> Entry
+{
+    Entry entry{filter, {}};
+
+    auto const type_filter = std::dynamic_pointer_cast<EventTypeFilter>(filter.lock());
+    if (!type_filter)
+    {
+        // Filters that don't say otherwise are offered everything
+        entry.buckets.set();
+        return entry;
+    }
+
+    for (auto const type : type_filter->handled_input_event_types())
+    {
+        if (type >= 0 && type < mir_input_event_types)
+            entry.buckets.set(type);
+    }
+
+    return entry;
+}
+
+void mi::EventFilterChainDispatcher::prune_expired()
+{
+    // Replaced chains are freed once unlocked
+    Chains reclaimed;
+    Chains pruned;
+
     std::lock_guard<std::mutex> lg(filter_guard);
-        
-    filters.insert(filters.begin(), filter);
+
+    reclaimed = reclaim_locked();
+
+    auto const new_end = std::remove_if(begin(filters), end(filters),
+        [](Entry const& entry) { return entry.filter.expired(); });
+
+    if (new_end == end(filters))
+        return;
+
+    filters.erase(new_end, end(filters));
+    publish_locked();
+    pruned = reclaim_locked();
+}
+
+void mi::EventFilterChainDispatcher::publish_locked()
+{
+    auto new_chain = std::make_unique<Chain>();
+    std::vector<std::bitset<bucket_count>> buckets;
+
+    for (auto const& entry : filters)
+    {
+        if (!entry.filter.expired())
+        {
+            new_chain->filters.push_back(entry.filter);
+            buckets.push_back(entry.buckets);
+        }
+    }
+
+    // Now that filters won't be reallocated the buckets can point into it
+    for (std::size_t i = 0; i != new_chain->filters.size(); ++i)
+    {
+        for (std::size_t bucket = 0; bucket != bucket_count; ++bucket)
+        {
+            if (buckets[i].test(bucket))
+                new_chain->buckets[bucket].push_back(&new_chain->filters[i]);
+        }
+    }
+
+    chain = new_chain.get();
+
+    if (current_chain)
+    {
+        retired_chains.push_back(std::move(current_chain));
+        chains_retired = true;
+    }
+    current_chain = std::move(new_chain);
+}
+
+auto mi::EventFilterChainDispatcher::reclaim_locked() -> Chains
+{
+    Chains reclaimed;
+
+    // A handle() that starts after this sees the current chain, so nothing can reach the others
+    if (readers == 0)
+    {
+        reclaimed.swap(retired_chains);
+        chains_retired = false;
+    }
+
+    return reclaimed;
 }
 
 bool mi::EventFilterChainDispatcher::dispatch(std::shared_ptr<MirEvent const> const& event)
@@ -22,6 +22,12 @@
 #include "mir/input/composite_event_filter.h"
 #include "mir/input/input_dispatcher.h"
 
+#include "mir_toolkit/event.h"
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <memory>
 #include <vector>
 #include <mutex>
 
@@ -48,9 +54,43 @@ public:
     void stop() override;
     
 private:
+    /// One bucket per MirInputEventType, plus a final one for non-input events
+    static std::size_t const bucket_count = mir_input_event_types + 1;
+
+    struct Entry
+    {
+        std::weak_ptr<EventFilter> filter;
+        std::bitset<bucket_count> buckets;
+    };
+
+    /// An immutable snapshot of the filters, in order, and of those offered each type of event.
+    /// Like filters, it doesn't own them: a filter goes as soon as its owner releases it, and is
+    /// then pruned from the chain.
+    struct Chain
+    {
+        std::vector<std::weak_ptr<EventFilter>> filters;
+        std::array<std::vector<std::weak_ptr<EventFilter> const*>, bucket_count> buckets;
+    };
+
+    using Chains = std::vector<std::unique_ptr<Chain const>>;
+
+    static auto entry_for(std::weak_ptr<EventFilter> const& filter) -> Entry;
+    void prune_expired();
+    void publish_locked();
+    /// \returns the replaced chains no handle() can still be reading, to be freed once unlocked
+    auto reclaim_locked() -> Chains;
+
     std::mutex filter_guard;
-    
-    std::vector<std::weak_ptr<EventFilter>> filters;
+    std::vector<Entry> filters;
+    std::unique_ptr<Chain const> current_chain;
+    Chains retired_chains;
+
+    /// handle() reads the current chain without locking. It counts itself in readers while it
+    /// does, and replaced chains are only freed once there are none.
+    std::atomic<Chain const*> chain{nullptr};
+    std::atomic<int> readers{0};
+    std::atomic<bool> chains_retired{false};
+
     std::shared_ptr<InputDispatcher> const next_dispatcher;
 };
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_EVENT_TYPE_FILTER_H_
+#define MIR_INPUT_EVENT_TYPE_FILTER_H_
+
+#include "mir/input/event_filter.h"
+#include "mir_toolkit/event.h"
+
+#include <memory>
+#include <vector>
+
+namespace mir
+{
+namespace input
+{
+
+/// An EventFilter may also implement this to declare that it only handles some types of input event.
+/// EventFilterChainDispatcher then never offers it any other event (including non-input events),
+/// so it costs nothing to dispatch those.
+class EventTypeFilter
+{
+public:
+    /// Queried once, when the filter is added to the chain
+    virtual auto handled_input_event_types() const -> std::vector<MirInputEventType> = 0;
+
+protected:
+    EventTypeFilter() = default;
+    virtual ~EventTypeFilter() = default;
+    EventTypeFilter(EventTypeFilter const&) = delete;
+    EventTypeFilter& operator=(EventTypeFilter const&) = delete;
+};
+
+/// Offers a filter that can't declare its interests itself only the types of input event given
+class TypedEventFilter : public EventFilter, public EventTypeFilter
+{
+public:
+    TypedEventFilter(std::shared_ptr<EventFilter> const& filter, std::vector<MirInputEventType> const& types)
+        : filter{filter},
+          types{types}
+    {
+    }
+
+    bool handle(MirEvent const& event) override
+    {
+        return filter->handle(event);
+    }
+
+    auto handled_input_event_types() const -> std::vector<MirInputEventType> override
+    {
+        return types;
+    }
+
+private:
+    std::shared_ptr<EventFilter> const filter;
+    std::vector<MirInputEventType> const types;
+};
+
+}
+}
+
+#endif // MIR_INPUT_EVENT_TYPE_FILTER_H_
@@ -74,12 +74,15 @@ mir::UniqueModulePtr<mi::Platform> mi::probe_input_platforms(
                 auto const probe = module->load_function<mi::ProbePlatform>(
                     "probe_input_platform", MIR_SERVER_INPUT_PLATFORM_VERSION);
 
+                // Keep looking for a module that is best (e.g. one the options ask for)
                 auto const priority = probe(options, *console);
                 if (priority > reject_platform_priority)
                 {
                     platform_module = module;
+                    reject_platform_priority = priority;
 
-                    return Selection::quit;
+                    if (priority >= PlatformPriority::best)
+                        return Selection::quit;
                 }
             }
             catch (std::runtime_error const&)
@@ -23,7 +23,6 @@
 #include "mir/time/alarm_factory.h"
 #include "mir/time/alarm.h"
 #include "mir/events/event_builders.h"
-#include "mir/cookie/authority.h"
 
 #include <boost/throw_exception.hpp>
 
@@ -70,14 +69,12 @@ struct DeviceRemovalFilter : mi::InputDeviceObserver
 mi::KeyRepeatDispatcher::KeyRepeatDispatcher(
     std::shared_ptr<mi::InputDispatcher> const& next_dispatcher,
     std::shared_ptr<mir::time::AlarmFactory> const& factory,
-    std::shared_ptr<mir::cookie::Authority> const& cookie_authority,
     bool repeat_enabled,
     std::chrono::milliseconds repeat_timeout,
     std::chrono::milliseconds repeat_delay,
     bool disable_repeat_on_touchscreen)
     : next_dispatcher(next_dispatcher),
       alarm_factory(factory),
-      cookie_authority(cookie_authority),
       repeat_enabled(repeat_enabled),
       repeat_timeout(repeat_timeout),
       repeat_delay(repeat_delay),
@@ -161,11 +158,10 @@ bool mi::KeyRepeatDispatcher::handle_key_input(MirInputDeviceId id, MirKeyboardE
              modifiers = mir_keyboard_event_modifiers(kev)]()
              {
                  auto const now = std::chrono::steady_clock::now().time_since_epoch();
-                 auto const cookie = cookie_authority->make_cookie(now.count());
                  auto new_event = mev::make_event(
                      id,
                      now,
-                     cookie->serialize(),
+                     std::vector<uint8_t>{},
                      mir_keyboard_action_repeat,
                      key_code,
                      scan_code,
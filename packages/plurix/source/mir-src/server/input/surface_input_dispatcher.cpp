@@ -47,16 +47,24 @@ struct InputDispatcherSceneObserver :
     InputDispatcherSceneObserver(
         std::function<void(std::shared_ptr<ms::Surface>)> const& on_removed,
         std::function<void(ms::Surface const*)> const& on_surface_moved,
-        std::function<void()> const& on_surface_resized)
+        std::function<void()> const& on_surface_resized,
+        std::function<void()> const& on_scene_changed)
         : on_removed(on_removed),
           on_surface_moved{on_surface_moved},
-          on_surface_resized{on_surface_resized}
+          on_surface_resized{on_surface_resized},
+          on_scene_changed{on_scene_changed}
     {
     }
 
     void surface_added(std::shared_ptr<ms::Surface> const& surface) override
     {
         surface->add_observer(shared_from_this());
+        on_scene_changed();
+    }
+
+    void surfaces_reordered() override
+    {
+        on_scene_changed();
     }
 
     void surface_removed(std::shared_ptr<ms::Surface> const& surface) override
@@ -69,9 +77,11 @@ struct InputDispatcherSceneObserver :
         surface->add_observer(shared_from_this());
     }
 
-    void attrib_changed(ms::Surface const*, MirWindowAttrib /*attrib*/, int /*value*/) override
+    void attrib_changed(ms::Surface const*, MirWindowAttrib attrib, int /*value*/) override
     {
         // TODO: Do we need to listen to visibility events?
+        if (attrib == mir_window_attrib_visibility)
+            on_scene_changed();
     }
 
     void content_resized_to(ms::Surface const*, mir::geometry::Size const& /*size*/) override
@@ -87,11 +97,34 @@ struct InputDispatcherSceneObserver :
     void hidden_set_to(ms::Surface const*, bool /*hide*/) override
     {
         // TODO: Do we need to listen to this?
+        on_scene_changed();
+    }
+
+    void window_resized_to(ms::Surface const*, mir::geometry::Size const& /*size*/) override
+    {
+        on_scene_changed();
+    }
+
+    void transformation_set_to(ms::Surface const*, glm::mat4 const& /*t*/) override
+    {
+        on_scene_changed();
+    }
+
+    // Also notified when a surface's input region or clip area changes
+    void reception_mode_set_to(ms::Surface const*, mi::InputReceptionMode /*mode*/) override
+    {
+        on_scene_changed();
+    }
+
+    void depth_layer_set_to(ms::Surface const*, MirDepthLayer /*depth_layer*/) override
+    {
+        on_scene_changed();
     }
 
     std::function<void(std::shared_ptr<ms::Surface>)> const on_removed;
     std::function<void(ms::Surface const*)> const on_surface_moved;
     std::function<void()> const on_surface_resized;
+    std::function<void()> const on_scene_changed;
 };
 
 void deliver_without_relative_motion(
@@ -154,7 +187,8 @@ mi::SurfaceInputDispatcher::SurfaceInputDispatcher(std::shared_ptr<mi::Scene> co
     scene_observer = std::make_shared<InputDispatcherSceneObserver>(
         [this](std::shared_ptr<ms::Surface> const& s) { surface_removed(s); },
         [this](scene::Surface const* s) { surface_moved(s); },
-        [this] { surface_resized(); });
+        [this] { surface_resized(); },
+        [this] { scene_changed(); });
     scene->add_observer(scene_observer);
 }
 
@@ -185,6 +219,7 @@ bool compare_surfaces(std::shared_ptr<mi::Surface> const& input_surface, ms::Sur
 void mi::SurfaceInputDispatcher::surface_removed(std::shared_ptr<ms::Surface> surface)
 {
     std::lock_guard<std::mutex> lg(dispatcher_mutex);
+    forget_hit_tests_locked();
 
     auto strong_focus = focus_surface.lock();
     if (strong_focus && compare_surfaces(strong_focus, surface.get()))
@@ -335,6 +370,7 @@ void send_motion_event_to_moved_surface(
 void mi::SurfaceInputDispatcher::surface_moved(ms::Surface const* moved_surface)
 {
     std::lock_guard<std::mutex> lock{dispatcher_mutex};
+    forget_hit_tests_locked();
 
     if (!last_pointer_event)
         return;
@@ -366,6 +402,7 @@ void mi::SurfaceInputDispatcher::surface_moved(ms::Surface const* moved_surface)
 void mi::SurfaceInputDispatcher::surface_resized()
 {
     std::lock_guard<std::mutex> lock{dispatcher_mutex};
+    forget_hit_tests_locked();
 
     if (!last_pointer_event)
         return;
@@ -385,6 +422,18 @@ void mi::SurfaceInputDispatcher::surface_resized()
     }
 }
 
+void mi::SurfaceInputDispatcher::scene_changed()
+{
+    std::lock_guard<std::mutex> lock{dispatcher_mutex};
+    forget_hit_tests_locked();
+}
+
+void mi::SurfaceInputDispatcher::forget_hit_tests_locked()
+{
+    for (auto& kv : pointer_state_by_id)
+        kv.second.last_hit_test = std::experimental::nullopt;
+}
+
 void mi::SurfaceInputDispatcher::device_reset(MirInputDeviceId reset_device_id, std::chrono::nanoseconds /* when */)
 {
     std::lock_guard<std::mutex> lg(dispatcher_mutex);
@@ -450,6 +499,19 @@ std::shared_ptr<mi::Surface> mi::SurfaceInputDispatcher::find_target_surface(geo
     return top_target;
 }
 
+std::shared_ptr<mi::Surface> mi::SurfaceInputDispatcher::pointer_target(
+    PointerInputState& state,
+    geom::Point const& position)
+{
+    // A locked pointer (or one held at the edge of its confinement) reports the same position on every motion
+    if (state.last_hit_test && state.last_hit_test.value().position == position)
+        return state.last_hit_test.value().target;
+
+    auto const target = find_target_surface(position);
+    state.last_hit_test = PointerInputState::HitTest{position, target};
+    return target;
+}
+
 void mi::SurfaceInputDispatcher::send_enter_exit_event(std::shared_ptr<mi::Surface> const& surface,
                                                        MirPointerEvent const* pev,
                                                        MirPointerAction action)
@@ -511,7 +573,7 @@ bool mi::SurfaceInputDispatcher::dispatch_pointer(MirInputDeviceId id, std::shar
 
         if (gesture_terminated || !drag_and_drop_handle.empty())
         {
-            auto target = find_target_surface(event_x_y);
+            auto target = pointer_target(pointer_state, event_x_y);
 
             if (pointer_state.current_target != target)
             {
@@ -538,7 +600,7 @@ bool mi::SurfaceInputDispatcher::dispatch_pointer(MirInputDeviceId id, std::shar
     }
     else
     {
-        auto target = find_target_surface(event_x_y);
+        auto target = pointer_target(pointer_state, event_x_y);
         bool sent_ev = false;
         if (pointer_state.current_target != target)
         {
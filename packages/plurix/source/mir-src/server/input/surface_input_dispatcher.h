@@ -23,6 +23,7 @@
 #include "mir/shell/input_targeter.h"
 #include "mir/geometry/point.h"
 
+#include <experimental/optional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -75,15 +76,27 @@ private:
 
     void surface_moved(scene::Surface const* moved_surface);
     void surface_resized();
+    void scene_changed();
 
     // Look in to homognizing index on KeyInputState and PointerInputState (wrt to device id)
     struct PointerInputState
     {
         std::shared_ptr<input::Surface> current_target;
         std::shared_ptr<input::Surface> gesture_owner;
+
+        /// The last hit-test, reused while the pointer doesn't move (as when it is locked). Forgotten whenever
+        /// the scene or a surface's geometry, stacking or input shape changes
+        struct HitTest
+        {
+            geometry::Point position;
+            std::shared_ptr<input::Surface> target;
+        };
+        std::experimental::optional<HitTest> last_hit_test;
     };
     std::unordered_map<MirInputDeviceId, PointerInputState> pointer_state_by_id;
     PointerInputState& ensure_pointer_state(MirInputDeviceId id);
+    std::shared_ptr<input::Surface> pointer_target(PointerInputState& state, geometry::Point const& position);
+    void forget_hit_tests_locked();
 
     struct TouchInputState
     {
@@ -366,8 +366,17 @@ std::shared_ptr<mf::BufferStream> ms::BasicSurface::primary_buffer_stream() cons
 
 void ms::BasicSurface::set_input_region(std::vector<geom::Rectangle> const& input_rectangles)
 {
-    std::lock_guard<std::mutex> lock(guard);
-    custom_input_rectangles = input_rectangles;
+    mi::InputReceptionMode mode;
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        if (custom_input_rectangles == input_rectangles)
+            return;
+        custom_input_rectangles = input_rectangles;
+        mode = input_mode;
+    }
+    // There's no dedicated notification for the input shape: observers that track which surface
+    // receives input (the input dispatcher's hit-tests, the cursor) handle it as a reception change
+    observers->reception_mode_set_to(this, mode);
 }
 
 void ms::BasicSurface::resize(geom::Size const& desired_size)
@@ -996,8 +1005,16 @@ std::experimental::optional<geom::Rectangle> mir::scene::BasicSurface::clip_area
 
 void mir::scene::BasicSurface::set_clip_area(std::experimental::optional<geom::Rectangle> const& area)
 {
-    std::lock_guard<std::mutex> lock(guard);
-    clip_area_ = area;
+    mi::InputReceptionMode mode;
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        if (clip_area_ == area)
+            return;
+        clip_area_ = area;
+        mode = input_mode;
+    }
+    // The clip area also limits input_area_contains()
+    observers->reception_mode_set_to(this, mode);
 }
 
 auto mir::scene::BasicSurface::focus_state() const -> MirWindowFocusState
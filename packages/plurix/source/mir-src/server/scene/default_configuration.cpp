@@ -148,7 +148,8 @@ mir::DefaultServerConfiguration::the_mediating_display_changer()
                 the_session_event_handler_register(),
                 the_server_action_queue(),
                 the_display_configuration_observer(),
-                the_main_loop());
+                the_main_loop(),
+                the_options()->get<bool>(options::emulate_session_display_modes_opt));
         });
 
 }
@@ -172,7 +172,8 @@ ms::MediatingDisplayChanger::MediatingDisplayChanger(
     std::shared_ptr<SessionEventHandlerRegister> const& session_event_handler_register,
     std::shared_ptr<ServerActionQueue> const& server_action_queue,
     std::shared_ptr<mg::DisplayConfigurationObserver> const& observer,
-    std::shared_ptr<mt::AlarmFactory> const& alarm_factory)
+    std::shared_ptr<mt::AlarmFactory> const& alarm_factory,
+    bool emulate_session_modes)
     : display{display},
       compositor{compositor},
       display_configuration_policy{display_configuration_policy},
@@ -183,7 +184,8 @@ ms::MediatingDisplayChanger::MediatingDisplayChanger(
       base_configuration_{display->configuration()},
       base_configuration_applied{true},
       alarm_factory{alarm_factory},
-      session_observer{std::make_unique<SessionObserver>(this)}
+      session_observer{std::make_unique<SessionObserver>(this)},
+      emulate_session_modes{emulate_session_modes}
 {
     session_event_handler_register->add(session_observer.get());
     observer->initial_configuration(base_configuration_);
@@ -227,7 +229,7 @@ void ms::MediatingDisplayChanger::configure(
                 {
                     try
                     {
-                        apply_config(conf);
+                        apply_session_config(conf);
                     }
                     catch (std::exception const&)
                     {
@@ -515,6 +517,62 @@ void ms::MediatingDisplayChanger::apply_base_config()
     base_configuration_applied = true;
 }
 
+namespace
+{
+/*
+ * Replace mode changes on outputs that are lit in both configurations with a custom logical
+ * size: the compositor scales the requested resolution to the hardware's existing mode.
+ *
+ * Switching between such a configuration and the base configuration doesn't need the display
+ * buffers recreating, so the compositor keeps running and there's no modeset.
+ */
+auto with_emulated_modes(
+    mg::DisplayConfiguration const& conf,
+    mg::DisplayConfiguration const& hardware) -> std::shared_ptr<mg::DisplayConfiguration>
+{
+    std::map<mg::DisplayConfigurationOutputId, size_t> hardware_modes;
+    hardware.for_each_output(
+        [&hardware_modes](mg::DisplayConfigurationOutput const& output)
+        {
+            if (output.connected && output.used && output.power_mode == mir_power_mode_on)
+                hardware_modes[output.id] = output.current_mode_index;
+        });
+
+    std::shared_ptr<mg::DisplayConfiguration> const emulated{conf.clone()};
+    emulated->for_each_output(
+        [&hardware_modes](mg::UserDisplayConfigurationOutput& output)
+        {
+            auto const hardware_mode = hardware_modes.find(output.id);
+
+            if (hardware_mode == hardware_modes.end() ||
+                !output.used || output.power_mode != mir_power_mode_on ||
+                hardware_mode->second == output.current_mode_index ||
+                hardware_mode->second >= output.modes.size())
+            {
+                return;
+            }
+
+            auto const requested_size = output.extents().size;
+            output.current_mode_index = hardware_mode->second;
+            output.custom_logical_size = requested_size;
+        });
+
+    return emulated;
+}
+}
+
+void ms::MediatingDisplayChanger::apply_session_config(std::shared_ptr<mg::DisplayConfiguration> const& conf)
+{
+    if (emulate_session_modes)
+    {
+        apply_config(with_emulated_modes(*conf, *base_configuration_));
+    }
+    else
+    {
+        apply_config(conf);
+    }
+}
+
 void ms::MediatingDisplayChanger::send_config_to_all_sessions(
     std::shared_ptr<mg::DisplayConfiguration> const& conf)
 {
@@ -542,7 +600,7 @@ void ms::MediatingDisplayChanger::focus_change_handler(
     {
         try
         {
-            apply_config(it->second);
+            apply_session_config(it->second);
         }
         catch (std::exception const&)
         {
@@ -63,7 +63,8 @@ public:
         std::shared_ptr<SessionEventHandlerRegister> const& session_event_handler_register,
         std::shared_ptr<ServerActionQueue> const& server_action_queue,
         std::shared_ptr<graphics::DisplayConfigurationObserver> const& observer,
-        std::shared_ptr<time::AlarmFactory> const& alarm_factory);
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+        bool emulate_session_modes);
 
     ~MediatingDisplayChanger();
 
@@ -100,6 +101,8 @@ private:
 
     void apply_config(std::shared_ptr<graphics::DisplayConfiguration> const& conf);
     void apply_base_config();
+    /// Applies a session's configuration, emulating its modes if emulate_session_modes
+    void apply_session_config(std::shared_ptr<graphics::DisplayConfiguration> const& conf);
     void send_config_to_all_sessions(
         std::shared_ptr<graphics::DisplayConfiguration> const& conf);
 
@@ -122,6 +125,7 @@ private:
     std::weak_ptr<scene::Session> currently_previewing_session;
     struct SessionObserver;
     std::unique_ptr<SessionObserver> const session_observer;
+    bool const emulate_session_modes;
 };
 
 }
@@ -0,0 +1,312 @@
+/*
+ * AUTOGENERATED - DO NOT EDIT
+ *
+ * This file is generated from input-timestamps-unstable-v1.xml
+ * To regenerate, run the “refresh-wayland-wrapper” target.
+ */
+
+#include "input-timestamps-unstable-v1_wrapper.h"
+
+#include <boost/throw_exception.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <wayland-server-core.h>
+
+#include "mir/log.h"
+
+namespace mir
+{
+namespace wayland
+{
+extern struct wl_interface const wl_keyboard_interface_data;
+extern struct wl_interface const wl_pointer_interface_data;
+extern struct wl_interface const wl_touch_interface_data;
+extern struct wl_interface const zwp_input_timestamps_manager_v1_interface_data;
+extern struct wl_interface const zwp_input_timestamps_v1_interface_data;
+}
+}
+
+namespace mw = mir::wayland;
+
+namespace
+{
+struct wl_interface const* all_null_types [] {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr};
+}
+
+// InputTimestampsManagerV1
+
+mw::InputTimestampsManagerV1* mw::InputTimestampsManagerV1::from(struct wl_resource* resource)
+{
+    return static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::InputTimestampsManagerV1::Thunks
+{
+    static int const supported_version;
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsManagerV1::destroy()");
+        }
+    }
+
+    static void get_keyboard_timestamps_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* keyboard)
+    {
+        auto me = static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+        wl_resource* id_resolved{
+            wl_resource_create(client, &zwp_input_timestamps_v1_interface_data, wl_resource_get_version(resource), id)};
+        if (id_resolved == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->get_keyboard_timestamps(id_resolved, keyboard);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsManagerV1::get_keyboard_timestamps()");
+        }
+    }
+
+    static void get_pointer_timestamps_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* pointer)
+    {
+        auto me = static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+        wl_resource* id_resolved{
+            wl_resource_create(client, &zwp_input_timestamps_v1_interface_data, wl_resource_get_version(resource), id)};
+        if (id_resolved == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->get_pointer_timestamps(id_resolved, pointer);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsManagerV1::get_pointer_timestamps()");
+        }
+    }
+
+    static void get_touch_timestamps_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* touch)
+    {
+        auto me = static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+        wl_resource* id_resolved{
+            wl_resource_create(client, &zwp_input_timestamps_v1_interface_data, wl_resource_get_version(resource), id)};
+        if (id_resolved == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->get_touch_timestamps(id_resolved, touch);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsManagerV1::get_touch_timestamps()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<InputTimestampsManagerV1*>(wl_resource_get_user_data(resource));
+    }
+
+    static void bind_thunk(struct wl_client* client, void* data, uint32_t version, uint32_t id)
+    {
+        auto me = static_cast<InputTimestampsManagerV1::Global*>(data);
+        auto resource = wl_resource_create(
+            client,
+            &zwp_input_timestamps_manager_v1_interface_data,
+            std::min((int)version, Thunks::supported_version),
+            id);
+        if (resource == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->bind(resource);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsManagerV1 global bind");
+        }
+    }
+
+    static struct wl_interface const* get_keyboard_timestamps_types[];
+    static struct wl_interface const* get_pointer_timestamps_types[];
+    static struct wl_interface const* get_touch_timestamps_types[];
+    static struct wl_message const request_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::InputTimestampsManagerV1::Thunks::supported_version = 1;
+
+mw::InputTimestampsManagerV1::InputTimestampsManagerV1(struct wl_resource* resource, Version<1>)
+    : client{wl_resource_get_client(resource)},
+      resource{resource}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+bool mw::InputTimestampsManagerV1::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_input_timestamps_manager_v1_interface_data, Thunks::request_vtable);
+}
+
+void mw::InputTimestampsManagerV1::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+mw::InputTimestampsManagerV1::Global::Global(wl_display* display, Version<1>)
+    : wayland::Global{
+          wl_global_create(
+              display,
+              &zwp_input_timestamps_manager_v1_interface_data,
+              Thunks::supported_version,
+              this,
+              &Thunks::bind_thunk)}
+{}
+
+auto mw::InputTimestampsManagerV1::Global::interface_name() const -> char const*
+{
+    return InputTimestampsManagerV1::interface_name;
+}
+
+struct wl_interface const* mw::InputTimestampsManagerV1::Thunks::get_keyboard_timestamps_types[] {
+    &zwp_input_timestamps_v1_interface_data,
+    &wl_keyboard_interface_data};
+
+struct wl_interface const* mw::InputTimestampsManagerV1::Thunks::get_pointer_timestamps_types[] {
+    &zwp_input_timestamps_v1_interface_data,
+    &wl_pointer_interface_data};
+
+struct wl_interface const* mw::InputTimestampsManagerV1::Thunks::get_touch_timestamps_types[] {
+    &zwp_input_timestamps_v1_interface_data,
+    &wl_touch_interface_data};
+
+struct wl_message const mw::InputTimestampsManagerV1::Thunks::request_messages[] {
+    {"destroy", "", all_null_types},
+    {"get_keyboard_timestamps", "no", get_keyboard_timestamps_types},
+    {"get_pointer_timestamps", "no", get_pointer_timestamps_types},
+    {"get_touch_timestamps", "no", get_touch_timestamps_types}};
+
+void const* mw::InputTimestampsManagerV1::Thunks::request_vtable[] {
+    (void*)Thunks::destroy_thunk,
+    (void*)Thunks::get_keyboard_timestamps_thunk,
+    (void*)Thunks::get_pointer_timestamps_thunk,
+    (void*)Thunks::get_touch_timestamps_thunk};
+
+// InputTimestampsV1
+
+mw::InputTimestampsV1* mw::InputTimestampsV1::from(struct wl_resource* resource)
+{
+    return static_cast<InputTimestampsV1*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::InputTimestampsV1::Thunks
+{
+    static int const supported_version;
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<InputTimestampsV1*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "InputTimestampsV1::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<InputTimestampsV1*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::InputTimestampsV1::Thunks::supported_version = 1;
+
+mw::InputTimestampsV1::InputTimestampsV1(struct wl_resource* resource, Version<1>)
+    : client{wl_resource_get_client(resource)},
+      resource{resource}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::InputTimestampsV1::send_timestamp_event(uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec) const
+{
+    wl_resource_post_event(resource, Opcode::timestamp, tv_sec_hi, tv_sec_lo, tv_nsec);
+}
+
+bool mw::InputTimestampsV1::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_input_timestamps_v1_interface_data, Thunks::request_vtable);
+}
+
+void mw::InputTimestampsV1::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_message const mw::InputTimestampsV1::Thunks::request_messages[] {
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::InputTimestampsV1::Thunks::event_messages[] {
+    {"timestamp", "uuu", all_null_types}};
+
+void const* mw::InputTimestampsV1::Thunks::request_vtable[] {
+    (void*)Thunks::destroy_thunk};
+
+namespace mir
+{
+namespace wayland
+{
+
+struct wl_interface const zwp_input_timestamps_manager_v1_interface_data {
+    mw::InputTimestampsManagerV1::interface_name,
+    mw::InputTimestampsManagerV1::Thunks::supported_version,
+    4, mw::InputTimestampsManagerV1::Thunks::request_messages,
+    0, nullptr};
+
+struct wl_interface const zwp_input_timestamps_v1_interface_data {
+    mw::InputTimestampsV1::interface_name,
+    mw::InputTimestampsV1::Thunks::supported_version,
+    1, mw::InputTimestampsV1::Thunks::request_messages,
+    1, mw::InputTimestampsV1::Thunks::event_messages};
+
+}
+}
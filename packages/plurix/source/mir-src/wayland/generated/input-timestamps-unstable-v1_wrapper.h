@@ -0,0 +1,97 @@
+/*
+ * AUTOGENERATED - DO NOT EDIT
+ *
+ * This file is generated from input-timestamps-unstable-v1.xml
+ * To regenerate, run the “refresh-wayland-wrapper” target.
+ */
+
+#ifndef MIR_FRONTEND_WAYLAND_INPUT_TIMESTAMPS_UNSTABLE_V1_XML_WRAPPER
+#define MIR_FRONTEND_WAYLAND_INPUT_TIMESTAMPS_UNSTABLE_V1_XML_WRAPPER
+
+#include <experimental/optional>
+
+#include "mir/fd.h"
+#include <wayland-server-core.h>
+
+#include "mir/wayland/wayland_base.h"
+
+namespace mir
+{
+namespace wayland
+{
+
+class InputTimestampsManagerV1;
+class InputTimestampsV1;
+
+class InputTimestampsManagerV1 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_input_timestamps_manager_v1";
+
+    static InputTimestampsManagerV1* from(struct wl_resource*);
+
+    InputTimestampsManagerV1(struct wl_resource* resource, Version<1>);
+    virtual ~InputTimestampsManagerV1() = default;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+    class Global : public wayland::Global
+    {
+    public:
+        Global(wl_display* display, Version<1>);
+
+        auto interface_name() const -> char const* override;
+
+    private:
+        virtual void bind(wl_resource* new_zwp_input_timestamps_manager_v1) = 0;
+        friend InputTimestampsManagerV1::Thunks;
+    };
+
+private:
+    virtual void destroy() = 0;
+    virtual void get_keyboard_timestamps(struct wl_resource* id, struct wl_resource* keyboard) = 0;
+    virtual void get_pointer_timestamps(struct wl_resource* id, struct wl_resource* pointer) = 0;
+    virtual void get_touch_timestamps(struct wl_resource* id, struct wl_resource* touch) = 0;
+};
+
+class InputTimestampsV1 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_input_timestamps_v1";
+
+    static InputTimestampsV1* from(struct wl_resource*);
+
+    InputTimestampsV1(struct wl_resource* resource, Version<1>);
+    virtual ~InputTimestampsV1() = default;
+
+    void send_timestamp_event(uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Opcode
+    {
+        static uint32_t const timestamp = 0;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void destroy() = 0;
+};
+
+}
+}
+
+#endif // MIR_FRONTEND_WAYLAND_INPUT_TIMESTAMPS_UNSTABLE_V1_XML_WRAPPER
@@ -0,0 +1,1100 @@
+/*
+ * AUTOGENERATED - DO NOT EDIT
+ *
+ * This file is generated from tablet-unstable-v2.xml
+ * To regenerate, run the “refresh-wayland-wrapper” target.
+ */
+
+#include "tablet-unstable-v2_wrapper.h"
+
+#include <boost/throw_exception.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <wayland-server-core.h>
+
+#include "mir/log.h"
+
+namespace mir
+{
+namespace wayland
+{
+extern struct wl_interface const wl_seat_interface_data;
+extern struct wl_interface const wl_surface_interface_data;
+extern struct wl_interface const zwp_tablet_manager_v2_interface_data;
+extern struct wl_interface const zwp_tablet_pad_group_v2_interface_data;
+extern struct wl_interface const zwp_tablet_pad_ring_v2_interface_data;
+extern struct wl_interface const zwp_tablet_pad_strip_v2_interface_data;
+extern struct wl_interface const zwp_tablet_pad_v2_interface_data;
+extern struct wl_interface const zwp_tablet_seat_v2_interface_data;
+extern struct wl_interface const zwp_tablet_tool_v2_interface_data;
+extern struct wl_interface const zwp_tablet_v2_interface_data;
+}
+}
+
+namespace mw = mir::wayland;
+
+namespace
+{
+struct wl_interface const* all_null_types [] {
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr};
+}
+
+// TabletManagerV2
+
+mw::TabletManagerV2* mw::TabletManagerV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletManagerV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletManagerV2::Thunks
+{
+    static int const supported_version;
+
+    static void get_tablet_seat_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t tablet_seat, struct wl_resource* seat)
+    {
+        auto me = static_cast<TabletManagerV2*>(wl_resource_get_user_data(resource));
+        wl_resource* tablet_seat_resolved{
+            wl_resource_create(client, &zwp_tablet_seat_v2_interface_data, wl_resource_get_version(resource), tablet_seat)};
+        if (tablet_seat_resolved == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->get_tablet_seat(tablet_seat_resolved, seat);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletManagerV2::get_tablet_seat()");
+        }
+    }
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletManagerV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletManagerV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletManagerV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static void bind_thunk(struct wl_client* client, void* data, uint32_t version, uint32_t id)
+    {
+        auto me = static_cast<TabletManagerV2::Global*>(data);
+        auto resource = wl_resource_create(
+            client,
+            &zwp_tablet_manager_v2_interface_data,
+            std::min((int)version, Thunks::supported_version),
+            id);
+        if (resource == nullptr)
+        {
+            wl_client_post_no_memory(client);
+            BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+        }
+        try
+        {
+            me->bind(resource);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletManagerV2 global bind");
+        }
+    }
+
+    static struct wl_interface const* get_tablet_seat_types[];
+    static struct wl_message const request_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletManagerV2::Thunks::supported_version = 1;
+
+mw::TabletManagerV2::TabletManagerV2(struct wl_resource* resource, Version<1>)
+    : client{wl_resource_get_client(resource)},
+      resource{resource}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+bool mw::TabletManagerV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_manager_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletManagerV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+mw::TabletManagerV2::Global::Global(wl_display* display, Version<1>)
+    : wayland::Global{
+          wl_global_create(
+              display,
+              &zwp_tablet_manager_v2_interface_data,
+              Thunks::supported_version,
+              this,
+              &Thunks::bind_thunk)}
+{}
+
+auto mw::TabletManagerV2::Global::interface_name() const -> char const*
+{
+    return TabletManagerV2::interface_name;
+}
+
+struct wl_interface const* mw::TabletManagerV2::Thunks::get_tablet_seat_types[] {
+    &zwp_tablet_seat_v2_interface_data,
+    &wl_seat_interface_data};
+
+struct wl_message const mw::TabletManagerV2::Thunks::request_messages[] {
+    {"get_tablet_seat", "no", get_tablet_seat_types},
+    {"destroy", "", all_null_types}};
+
+void const* mw::TabletManagerV2::Thunks::request_vtable[] {
+    (void*)Thunks::get_tablet_seat_thunk,
+    (void*)Thunks::destroy_thunk};
+
+// TabletSeatV2
+
+mw::TabletSeatV2* mw::TabletSeatV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletSeatV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletSeatV2::Thunks
+{
+    static int const supported_version;
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletSeatV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletSeatV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletSeatV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_interface const* tablet_added_types[];
+    static struct wl_interface const* tool_added_types[];
+    static struct wl_interface const* pad_added_types[];
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletSeatV2::Thunks::supported_version = 1;
+
+mw::TabletSeatV2::TabletSeatV2(struct wl_resource* resource, Version<1>)
+    : client{wl_resource_get_client(resource)},
+      resource{resource}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletSeatV2::send_tablet_added_event(struct wl_resource* id) const
+{
+    wl_resource_post_event(resource, Opcode::tablet_added, id);
+}
+
+void mw::TabletSeatV2::send_tool_added_event(struct wl_resource* id) const
+{
+    wl_resource_post_event(resource, Opcode::tool_added, id);
+}
+
+void mw::TabletSeatV2::send_pad_added_event(struct wl_resource* id) const
+{
+    wl_resource_post_event(resource, Opcode::pad_added, id);
+}
+
+bool mw::TabletSeatV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_seat_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletSeatV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_interface const* mw::TabletSeatV2::Thunks::tablet_added_types[] {
+    &zwp_tablet_v2_interface_data};
+
+struct wl_interface const* mw::TabletSeatV2::Thunks::tool_added_types[] {
+    &zwp_tablet_tool_v2_interface_data};
+
+struct wl_interface const* mw::TabletSeatV2::Thunks::pad_added_types[] {
+    &zwp_tablet_pad_v2_interface_data};
+
+struct wl_message const mw::TabletSeatV2::Thunks::request_messages[] {
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletSeatV2::Thunks::event_messages[] {
+    {"tablet_added", "n", tablet_added_types},
+    {"tool_added", "n", tool_added_types},
+    {"pad_added", "n", pad_added_types}};
+
+void const* mw::TabletSeatV2::Thunks::request_vtable[] {
+    (void*)Thunks::destroy_thunk};
+
+// TabletToolV2
+
+mw::TabletToolV2* mw::TabletToolV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletToolV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletToolV2::Thunks
+{
+    static int const supported_version;
+
+    static void set_cursor_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial, struct wl_resource* surface, int32_t hotspot_x, int32_t hotspot_y)
+    {
+        auto me = static_cast<TabletToolV2*>(wl_resource_get_user_data(resource));
+        std::experimental::optional<struct wl_resource*> surface_resolved;
+        if (surface != nullptr)
+        {
+            surface_resolved = {surface};
+        }
+        try
+        {
+            me->set_cursor(serial, surface_resolved, hotspot_x, hotspot_y);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletToolV2::set_cursor()");
+        }
+    }
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletToolV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletToolV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletToolV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_interface const* set_cursor_types[];
+    static struct wl_interface const* proximity_in_types[];
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletToolV2::Thunks::supported_version = 1;
+
+mw::TabletToolV2::TabletToolV2(TabletSeatV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_tool_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletToolV2::send_type_event(uint32_t tool_type) const
+{
+    wl_resource_post_event(resource, Opcode::type, tool_type);
+}
+
+void mw::TabletToolV2::send_hardware_serial_event(uint32_t hardware_serial_hi, uint32_t hardware_serial_lo) const
+{
+    wl_resource_post_event(resource, Opcode::hardware_serial, hardware_serial_hi, hardware_serial_lo);
+}
+
+void mw::TabletToolV2::send_hardware_id_wacom_event(uint32_t hardware_id_hi, uint32_t hardware_id_lo) const
+{
+    wl_resource_post_event(resource, Opcode::hardware_id_wacom, hardware_id_hi, hardware_id_lo);
+}
+
+void mw::TabletToolV2::send_capability_event(uint32_t capability) const
+{
+    wl_resource_post_event(resource, Opcode::capability, capability);
+}
+
+void mw::TabletToolV2::send_done_event() const
+{
+    wl_resource_post_event(resource, Opcode::done);
+}
+
+void mw::TabletToolV2::send_removed_event() const
+{
+    wl_resource_post_event(resource, Opcode::removed);
+}
+
+void mw::TabletToolV2::send_proximity_in_event(uint32_t serial, struct wl_resource* tablet, struct wl_resource* surface) const
+{
+    wl_resource_post_event(resource, Opcode::proximity_in, serial, tablet, surface);
+}
+
+void mw::TabletToolV2::send_proximity_out_event() const
+{
+    wl_resource_post_event(resource, Opcode::proximity_out);
+}
+
+void mw::TabletToolV2::send_down_event(uint32_t serial) const
+{
+    wl_resource_post_event(resource, Opcode::down, serial);
+}
+
+void mw::TabletToolV2::send_up_event() const
+{
+    wl_resource_post_event(resource, Opcode::up);
+}
+
+void mw::TabletToolV2::send_motion_event(double x, double y) const
+{
+    wl_fixed_t x_resolved{wl_fixed_from_double(x)};
+    wl_fixed_t y_resolved{wl_fixed_from_double(y)};
+    wl_resource_post_event(resource, Opcode::motion, x_resolved, y_resolved);
+}
+
+void mw::TabletToolV2::send_pressure_event(uint32_t pressure) const
+{
+    wl_resource_post_event(resource, Opcode::pressure, pressure);
+}
+
+void mw::TabletToolV2::send_distance_event(uint32_t distance) const
+{
+    wl_resource_post_event(resource, Opcode::distance, distance);
+}
+
+void mw::TabletToolV2::send_tilt_event(double tilt_x, double tilt_y) const
+{
+    wl_fixed_t tilt_x_resolved{wl_fixed_from_double(tilt_x)};
+    wl_fixed_t tilt_y_resolved{wl_fixed_from_double(tilt_y)};
+    wl_resource_post_event(resource, Opcode::tilt, tilt_x_resolved, tilt_y_resolved);
+}
+
+void mw::TabletToolV2::send_rotation_event(double degrees) const
+{
+    wl_fixed_t degrees_resolved{wl_fixed_from_double(degrees)};
+    wl_resource_post_event(resource, Opcode::rotation, degrees_resolved);
+}
+
+void mw::TabletToolV2::send_slider_event(int32_t position) const
+{
+    wl_resource_post_event(resource, Opcode::slider, position);
+}
+
+void mw::TabletToolV2::send_wheel_event(double degrees, int32_t clicks) const
+{
+    wl_fixed_t degrees_resolved{wl_fixed_from_double(degrees)};
+    wl_resource_post_event(resource, Opcode::wheel, degrees_resolved, clicks);
+}
+
+void mw::TabletToolV2::send_button_event(uint32_t serial, uint32_t button, uint32_t state) const
+{
+    wl_resource_post_event(resource, Opcode::button, serial, button, state);
+}
+
+void mw::TabletToolV2::send_frame_event(uint32_t time) const
+{
+    wl_resource_post_event(resource, Opcode::frame, time);
+}
+
+bool mw::TabletToolV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_tool_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletToolV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_interface const* mw::TabletToolV2::Thunks::set_cursor_types[] {
+    nullptr,
+    &wl_surface_interface_data,
+    nullptr,
+    nullptr};
+
+struct wl_interface const* mw::TabletToolV2::Thunks::proximity_in_types[] {
+    nullptr,
+    &zwp_tablet_v2_interface_data,
+    &wl_surface_interface_data};
+
+struct wl_message const mw::TabletToolV2::Thunks::request_messages[] {
+    {"set_cursor", "u?oii", set_cursor_types},
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletToolV2::Thunks::event_messages[] {
+    {"type", "u", all_null_types},
+    {"hardware_serial", "uu", all_null_types},
+    {"hardware_id_wacom", "uu", all_null_types},
+    {"capability", "u", all_null_types},
+    {"done", "", all_null_types},
+    {"removed", "", all_null_types},
+    {"proximity_in", "uoo", proximity_in_types},
+    {"proximity_out", "", all_null_types},
+    {"down", "u", all_null_types},
+    {"up", "", all_null_types},
+    {"motion", "ff", all_null_types},
+    {"pressure", "u", all_null_types},
+    {"distance", "u", all_null_types},
+    {"tilt", "ff", all_null_types},
+    {"rotation", "f", all_null_types},
+    {"slider", "i", all_null_types},
+    {"wheel", "fi", all_null_types},
+    {"button", "uuu", all_null_types},
+    {"frame", "u", all_null_types}};
+
+void const* mw::TabletToolV2::Thunks::request_vtable[] {
+    (void*)Thunks::set_cursor_thunk,
+    (void*)Thunks::destroy_thunk};
+
+// TabletV2
+
+mw::TabletV2* mw::TabletV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletV2::Thunks
+{
+    static int const supported_version;
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletV2::Thunks::supported_version = 1;
+
+mw::TabletV2::TabletV2(TabletSeatV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletV2::send_name_event(std::string const& name) const
+{
+    const char* name_resolved = name.c_str();
+    wl_resource_post_event(resource, Opcode::name, name_resolved);
+}
+
+void mw::TabletV2::send_id_event(uint32_t vid, uint32_t pid) const
+{
+    wl_resource_post_event(resource, Opcode::id, vid, pid);
+}
+
+void mw::TabletV2::send_path_event(std::string const& path) const
+{
+    const char* path_resolved = path.c_str();
+    wl_resource_post_event(resource, Opcode::path, path_resolved);
+}
+
+void mw::TabletV2::send_done_event() const
+{
+    wl_resource_post_event(resource, Opcode::done);
+}
+
+void mw::TabletV2::send_removed_event() const
+{
+    wl_resource_post_event(resource, Opcode::removed);
+}
+
+bool mw::TabletV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_message const mw::TabletV2::Thunks::request_messages[] {
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletV2::Thunks::event_messages[] {
+    {"name", "s", all_null_types},
+    {"id", "uu", all_null_types},
+    {"path", "s", all_null_types},
+    {"done", "", all_null_types},
+    {"removed", "", all_null_types}};
+
+void const* mw::TabletV2::Thunks::request_vtable[] {
+    (void*)Thunks::destroy_thunk};
+
+// TabletPadRingV2
+
+mw::TabletPadRingV2* mw::TabletPadRingV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletPadRingV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletPadRingV2::Thunks
+{
+    static int const supported_version;
+
+    static void set_feedback_thunk(struct wl_client* client, struct wl_resource* resource, char const* description, uint32_t serial)
+    {
+        auto me = static_cast<TabletPadRingV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->set_feedback(description, serial);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadRingV2::set_feedback()");
+        }
+    }
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletPadRingV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadRingV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletPadRingV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletPadRingV2::Thunks::supported_version = 1;
+
+mw::TabletPadRingV2::TabletPadRingV2(TabletPadGroupV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_pad_ring_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletPadRingV2::send_source_event(uint32_t source) const
+{
+    wl_resource_post_event(resource, Opcode::source, source);
+}
+
+void mw::TabletPadRingV2::send_angle_event(double degrees) const
+{
+    wl_fixed_t degrees_resolved{wl_fixed_from_double(degrees)};
+    wl_resource_post_event(resource, Opcode::angle, degrees_resolved);
+}
+
+void mw::TabletPadRingV2::send_stop_event() const
+{
+    wl_resource_post_event(resource, Opcode::stop);
+}
+
+void mw::TabletPadRingV2::send_frame_event(uint32_t time) const
+{
+    wl_resource_post_event(resource, Opcode::frame, time);
+}
+
+bool mw::TabletPadRingV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_pad_ring_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletPadRingV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_message const mw::TabletPadRingV2::Thunks::request_messages[] {
+    {"set_feedback", "su", all_null_types},
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletPadRingV2::Thunks::event_messages[] {
+    {"source", "u", all_null_types},
+    {"angle", "f", all_null_types},
+    {"stop", "", all_null_types},
+    {"frame", "u", all_null_types}};
+
+void const* mw::TabletPadRingV2::Thunks::request_vtable[] {
+    (void*)Thunks::set_feedback_thunk,
+    (void*)Thunks::destroy_thunk};
+
+// TabletPadStripV2
+
+mw::TabletPadStripV2* mw::TabletPadStripV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletPadStripV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletPadStripV2::Thunks
+{
+    static int const supported_version;
+
+    static void set_feedback_thunk(struct wl_client* client, struct wl_resource* resource, char const* description, uint32_t serial)
+    {
+        auto me = static_cast<TabletPadStripV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->set_feedback(description, serial);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadStripV2::set_feedback()");
+        }
+    }
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletPadStripV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadStripV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletPadStripV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletPadStripV2::Thunks::supported_version = 1;
+
+mw::TabletPadStripV2::TabletPadStripV2(TabletPadGroupV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_pad_strip_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletPadStripV2::send_source_event(uint32_t source) const
+{
+    wl_resource_post_event(resource, Opcode::source, source);
+}
+
+void mw::TabletPadStripV2::send_position_event(uint32_t position) const
+{
+    wl_resource_post_event(resource, Opcode::position, position);
+}
+
+void mw::TabletPadStripV2::send_stop_event() const
+{
+    wl_resource_post_event(resource, Opcode::stop);
+}
+
+void mw::TabletPadStripV2::send_frame_event(uint32_t time) const
+{
+    wl_resource_post_event(resource, Opcode::frame, time);
+}
+
+bool mw::TabletPadStripV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_pad_strip_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletPadStripV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_message const mw::TabletPadStripV2::Thunks::request_messages[] {
+    {"set_feedback", "su", all_null_types},
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletPadStripV2::Thunks::event_messages[] {
+    {"source", "u", all_null_types},
+    {"position", "u", all_null_types},
+    {"stop", "", all_null_types},
+    {"frame", "u", all_null_types}};
+
+void const* mw::TabletPadStripV2::Thunks::request_vtable[] {
+    (void*)Thunks::set_feedback_thunk,
+    (void*)Thunks::destroy_thunk};
+
+// TabletPadGroupV2
+
+mw::TabletPadGroupV2* mw::TabletPadGroupV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletPadGroupV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletPadGroupV2::Thunks
+{
+    static int const supported_version;
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletPadGroupV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadGroupV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletPadGroupV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_interface const* ring_types[];
+    static struct wl_interface const* strip_types[];
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletPadGroupV2::Thunks::supported_version = 1;
+
+mw::TabletPadGroupV2::TabletPadGroupV2(TabletPadV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_pad_group_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletPadGroupV2::send_buttons_event(struct wl_array* buttons) const
+{
+    wl_resource_post_event(resource, Opcode::buttons, buttons);
+}
+
+void mw::TabletPadGroupV2::send_ring_event(struct wl_resource* ring) const
+{
+    wl_resource_post_event(resource, Opcode::ring, ring);
+}
+
+void mw::TabletPadGroupV2::send_strip_event(struct wl_resource* strip) const
+{
+    wl_resource_post_event(resource, Opcode::strip, strip);
+}
+
+void mw::TabletPadGroupV2::send_modes_event(uint32_t modes) const
+{
+    wl_resource_post_event(resource, Opcode::modes, modes);
+}
+
+void mw::TabletPadGroupV2::send_done_event() const
+{
+    wl_resource_post_event(resource, Opcode::done);
+}
+
+void mw::TabletPadGroupV2::send_mode_switch_event(uint32_t time, uint32_t serial, uint32_t mode) const
+{
+    wl_resource_post_event(resource, Opcode::mode_switch, time, serial, mode);
+}
+
+bool mw::TabletPadGroupV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_pad_group_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletPadGroupV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_interface const* mw::TabletPadGroupV2::Thunks::ring_types[] {
+    &zwp_tablet_pad_ring_v2_interface_data};
+
+struct wl_interface const* mw::TabletPadGroupV2::Thunks::strip_types[] {
+    &zwp_tablet_pad_strip_v2_interface_data};
+
+struct wl_message const mw::TabletPadGroupV2::Thunks::request_messages[] {
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletPadGroupV2::Thunks::event_messages[] {
+    {"buttons", "a", all_null_types},
+    {"ring", "n", ring_types},
+    {"strip", "n", strip_types},
+    {"modes", "u", all_null_types},
+    {"done", "", all_null_types},
+    {"mode_switch", "uuu", all_null_types}};
+
+void const* mw::TabletPadGroupV2::Thunks::request_vtable[] {
+    (void*)Thunks::destroy_thunk};
+
+// TabletPadV2
+
+mw::TabletPadV2* mw::TabletPadV2::from(struct wl_resource* resource)
+{
+    return static_cast<TabletPadV2*>(wl_resource_get_user_data(resource));
+}
+
+struct mw::TabletPadV2::Thunks
+{
+    static int const supported_version;
+
+    static void set_feedback_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t button, char const* description, uint32_t serial)
+    {
+        auto me = static_cast<TabletPadV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->set_feedback(button, description, serial);
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadV2::set_feedback()");
+        }
+    }
+
+    static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
+    {
+        auto me = static_cast<TabletPadV2*>(wl_resource_get_user_data(resource));
+        try
+        {
+            me->destroy();
+        }
+        catch(...)
+        {
+            internal_error_processing_request(client, "TabletPadV2::destroy()");
+        }
+    }
+
+    static void resource_destroyed_thunk(wl_resource* resource)
+    {
+        delete static_cast<TabletPadV2*>(wl_resource_get_user_data(resource));
+    }
+
+    static struct wl_interface const* group_types[];
+    static struct wl_interface const* enter_types[];
+    static struct wl_interface const* leave_types[];
+    static struct wl_message const request_messages[];
+    static struct wl_message const event_messages[];
+    static void const* request_vtable[];
+};
+
+int const mw::TabletPadV2::Thunks::supported_version = 1;
+
+mw::TabletPadV2::TabletPadV2(TabletSeatV2 const& parent)
+    : client{wl_resource_get_client(parent.resource)},
+      resource{wl_resource_create(client, &zwp_tablet_pad_v2_interface_data, wl_resource_get_version(parent.resource), 0)}
+{
+    if (resource == nullptr)
+    {
+        BOOST_THROW_EXCEPTION((std::bad_alloc{}));
+    }
+    wl_resource_set_implementation(resource, Thunks::request_vtable, this, &Thunks::resource_destroyed_thunk);
+}
+
+void mw::TabletPadV2::send_group_event(struct wl_resource* pad_group) const
+{
+    wl_resource_post_event(resource, Opcode::group, pad_group);
+}
+
+void mw::TabletPadV2::send_path_event(std::string const& path) const
+{
+    const char* path_resolved = path.c_str();
+    wl_resource_post_event(resource, Opcode::path, path_resolved);
+}
+
+void mw::TabletPadV2::send_buttons_event(uint32_t buttons) const
+{
+    wl_resource_post_event(resource, Opcode::buttons, buttons);
+}
+
+void mw::TabletPadV2::send_done_event() const
+{
+    wl_resource_post_event(resource, Opcode::done);
+}
+
+void mw::TabletPadV2::send_button_event(uint32_t time, uint32_t button, uint32_t state) const
+{
+    wl_resource_post_event(resource, Opcode::button, time, button, state);
+}
+
+void mw::TabletPadV2::send_enter_event(uint32_t serial, struct wl_resource* tablet, struct wl_resource* surface) const
+{
+    wl_resource_post_event(resource, Opcode::enter, serial, tablet, surface);
+}
+
+void mw::TabletPadV2::send_leave_event(uint32_t serial, struct wl_resource* surface) const
+{
+    wl_resource_post_event(resource, Opcode::leave, serial, surface);
+}
+
+void mw::TabletPadV2::send_removed_event() const
+{
+    wl_resource_post_event(resource, Opcode::removed);
+}
+
+bool mw::TabletPadV2::is_instance(wl_resource* resource)
+{
+    return wl_resource_instance_of(resource, &zwp_tablet_pad_v2_interface_data, Thunks::request_vtable);
+}
+
+void mw::TabletPadV2::destroy_wayland_object() const
+{
+    wl_resource_destroy(resource);
+}
+
+struct wl_interface const* mw::TabletPadV2::Thunks::group_types[] {
+    &zwp_tablet_pad_group_v2_interface_data};
+
+struct wl_interface const* mw::TabletPadV2::Thunks::enter_types[] {
+    nullptr,
+    &zwp_tablet_v2_interface_data,
+    &wl_surface_interface_data};
+
+struct wl_interface const* mw::TabletPadV2::Thunks::leave_types[] {
+    nullptr,
+    &wl_surface_interface_data};
+
+struct wl_message const mw::TabletPadV2::Thunks::request_messages[] {
+    {"set_feedback", "usu", all_null_types},
+    {"destroy", "", all_null_types}};
+
+struct wl_message const mw::TabletPadV2::Thunks::event_messages[] {
+    {"group", "n", group_types},
+    {"path", "s", all_null_types},
+    {"buttons", "u", all_null_types},
+    {"done", "", all_null_types},
+    {"button", "uuu", all_null_types},
+    {"enter", "uoo", enter_types},
+    {"leave", "uo", leave_types},
+    {"removed", "", all_null_types}};
+
+void const* mw::TabletPadV2::Thunks::request_vtable[] {
+    (void*)Thunks::set_feedback_thunk,
+    (void*)Thunks::destroy_thunk};
+
+namespace mir
+{
+namespace wayland
+{
+
+struct wl_interface const zwp_tablet_manager_v2_interface_data {
+    mw::TabletManagerV2::interface_name,
+    mw::TabletManagerV2::Thunks::supported_version,
+    2, mw::TabletManagerV2::Thunks::request_messages,
+    0, nullptr};
+
+struct wl_interface const zwp_tablet_seat_v2_interface_data {
+    mw::TabletSeatV2::interface_name,
+    mw::TabletSeatV2::Thunks::supported_version,
+    1, mw::TabletSeatV2::Thunks::request_messages,
+    3, mw::TabletSeatV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_tool_v2_interface_data {
+    mw::TabletToolV2::interface_name,
+    mw::TabletToolV2::Thunks::supported_version,
+    2, mw::TabletToolV2::Thunks::request_messages,
+    19, mw::TabletToolV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_v2_interface_data {
+    mw::TabletV2::interface_name,
+    mw::TabletV2::Thunks::supported_version,
+    1, mw::TabletV2::Thunks::request_messages,
+    5, mw::TabletV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_pad_ring_v2_interface_data {
+    mw::TabletPadRingV2::interface_name,
+    mw::TabletPadRingV2::Thunks::supported_version,
+    2, mw::TabletPadRingV2::Thunks::request_messages,
+    4, mw::TabletPadRingV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_pad_strip_v2_interface_data {
+    mw::TabletPadStripV2::interface_name,
+    mw::TabletPadStripV2::Thunks::supported_version,
+    2, mw::TabletPadStripV2::Thunks::request_messages,
+    4, mw::TabletPadStripV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_pad_group_v2_interface_data {
+    mw::TabletPadGroupV2::interface_name,
+    mw::TabletPadGroupV2::Thunks::supported_version,
+    1, mw::TabletPadGroupV2::Thunks::request_messages,
+    6, mw::TabletPadGroupV2::Thunks::event_messages};
+
+struct wl_interface const zwp_tablet_pad_v2_interface_data {
+    mw::TabletPadV2::interface_name,
+    mw::TabletPadV2::Thunks::supported_version,
+    2, mw::TabletPadV2::Thunks::request_messages,
+    8, mw::TabletPadV2::Thunks::event_messages};
+
+}
+}
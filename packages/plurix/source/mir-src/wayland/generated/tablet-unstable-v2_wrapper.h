@@ -0,0 +1,418 @@
+/*
+ * AUTOGENERATED - DO NOT EDIT
+ *
+ * This file is generated from tablet-unstable-v2.xml
+ * To regenerate, run the “refresh-wayland-wrapper” target.
+ */
+
+#ifndef MIR_FRONTEND_WAYLAND_TABLET_UNSTABLE_V2_XML_WRAPPER
+#define MIR_FRONTEND_WAYLAND_TABLET_UNSTABLE_V2_XML_WRAPPER
+
+#include <experimental/optional>
+
+#include "mir/fd.h"
+#include <wayland-server-core.h>
+
+#include "mir/wayland/wayland_base.h"
+
+namespace mir
+{
+namespace wayland
+{
+
+class TabletManagerV2;
+class TabletSeatV2;
+class TabletToolV2;
+class TabletV2;
+class TabletPadRingV2;
+class TabletPadStripV2;
+class TabletPadGroupV2;
+class TabletPadV2;
+
+class TabletManagerV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_manager_v2";
+
+    static TabletManagerV2* from(struct wl_resource*);
+
+    TabletManagerV2(struct wl_resource* resource, Version<1>);
+    virtual ~TabletManagerV2() = default;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+    class Global : public wayland::Global
+    {
+    public:
+        Global(wl_display* display, Version<1>);
+
+        auto interface_name() const -> char const* override;
+
+    private:
+        virtual void bind(wl_resource* new_zwp_tablet_manager_v2) = 0;
+        friend TabletManagerV2::Thunks;
+    };
+
+private:
+    virtual void get_tablet_seat(struct wl_resource* tablet_seat, struct wl_resource* seat) = 0;
+    virtual void destroy() = 0;
+};
+
+class TabletSeatV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_seat_v2";
+
+    static TabletSeatV2* from(struct wl_resource*);
+
+    TabletSeatV2(struct wl_resource* resource, Version<1>);
+    virtual ~TabletSeatV2() = default;
+
+    void send_tablet_added_event(struct wl_resource* id) const;
+    void send_tool_added_event(struct wl_resource* id) const;
+    void send_pad_added_event(struct wl_resource* id) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Opcode
+    {
+        static uint32_t const tablet_added = 0;
+        static uint32_t const tool_added = 1;
+        static uint32_t const pad_added = 2;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void destroy() = 0;
+};
+
+class TabletToolV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_tool_v2";
+
+    static TabletToolV2* from(struct wl_resource*);
+
+    TabletToolV2(TabletSeatV2 const& parent);
+    virtual ~TabletToolV2() = default;
+
+    void send_type_event(uint32_t tool_type) const;
+    void send_hardware_serial_event(uint32_t hardware_serial_hi, uint32_t hardware_serial_lo) const;
+    void send_hardware_id_wacom_event(uint32_t hardware_id_hi, uint32_t hardware_id_lo) const;
+    void send_capability_event(uint32_t capability) const;
+    void send_done_event() const;
+    void send_removed_event() const;
+    void send_proximity_in_event(uint32_t serial, struct wl_resource* tablet, struct wl_resource* surface) const;
+    void send_proximity_out_event() const;
+    void send_down_event(uint32_t serial) const;
+    void send_up_event() const;
+    void send_motion_event(double x, double y) const;
+    void send_pressure_event(uint32_t pressure) const;
+    void send_distance_event(uint32_t distance) const;
+    void send_tilt_event(double tilt_x, double tilt_y) const;
+    void send_rotation_event(double degrees) const;
+    void send_slider_event(int32_t position) const;
+    void send_wheel_event(double degrees, int32_t clicks) const;
+    void send_button_event(uint32_t serial, uint32_t button, uint32_t state) const;
+    void send_frame_event(uint32_t time) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Type
+    {
+        static uint32_t const pen = 0x140;
+        static uint32_t const eraser = 0x141;
+        static uint32_t const brush = 0x142;
+        static uint32_t const pencil = 0x143;
+        static uint32_t const airbrush = 0x144;
+        static uint32_t const finger = 0x145;
+        static uint32_t const mouse = 0x146;
+        static uint32_t const lens = 0x147;
+    };
+
+    struct Capability
+    {
+        static uint32_t const tilt = 1;
+        static uint32_t const pressure = 2;
+        static uint32_t const distance = 3;
+        static uint32_t const rotation = 4;
+        static uint32_t const slider = 5;
+        static uint32_t const wheel = 6;
+    };
+
+    struct ButtonState
+    {
+        static uint32_t const released = 0;
+        static uint32_t const pressed = 1;
+    };
+
+    struct Error
+    {
+        static uint32_t const role = 0;
+    };
+
+    struct Opcode
+    {
+        static uint32_t const type = 0;
+        static uint32_t const hardware_serial = 1;
+        static uint32_t const hardware_id_wacom = 2;
+        static uint32_t const capability = 3;
+        static uint32_t const done = 4;
+        static uint32_t const removed = 5;
+        static uint32_t const proximity_in = 6;
+        static uint32_t const proximity_out = 7;
+        static uint32_t const down = 8;
+        static uint32_t const up = 9;
+        static uint32_t const motion = 10;
+        static uint32_t const pressure = 11;
+        static uint32_t const distance = 12;
+        static uint32_t const tilt = 13;
+        static uint32_t const rotation = 14;
+        static uint32_t const slider = 15;
+        static uint32_t const wheel = 16;
+        static uint32_t const button = 17;
+        static uint32_t const frame = 18;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void set_cursor(uint32_t serial, std::experimental::optional<struct wl_resource*> const& surface, int32_t hotspot_x, int32_t hotspot_y) = 0;
+    virtual void destroy() = 0;
+};
+
+class TabletV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_v2";
+
+    static TabletV2* from(struct wl_resource*);
+
+    TabletV2(TabletSeatV2 const& parent);
+    virtual ~TabletV2() = default;
+
+    void send_name_event(std::string const& name) const;
+    void send_id_event(uint32_t vid, uint32_t pid) const;
+    void send_path_event(std::string const& path) const;
+    void send_done_event() const;
+    void send_removed_event() const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Opcode
+    {
+        static uint32_t const name = 0;
+        static uint32_t const id = 1;
+        static uint32_t const path = 2;
+        static uint32_t const done = 3;
+        static uint32_t const removed = 4;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void destroy() = 0;
+};
+
+class TabletPadRingV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_pad_ring_v2";
+
+    static TabletPadRingV2* from(struct wl_resource*);
+
+    TabletPadRingV2(TabletPadGroupV2 const& parent);
+    virtual ~TabletPadRingV2() = default;
+
+    void send_source_event(uint32_t source) const;
+    void send_angle_event(double degrees) const;
+    void send_stop_event() const;
+    void send_frame_event(uint32_t time) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Source
+    {
+        static uint32_t const finger = 1;
+    };
+
+    struct Opcode
+    {
+        static uint32_t const source = 0;
+        static uint32_t const angle = 1;
+        static uint32_t const stop = 2;
+        static uint32_t const frame = 3;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void set_feedback(std::string const& description, uint32_t serial) = 0;
+    virtual void destroy() = 0;
+};
+
+class TabletPadStripV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_pad_strip_v2";
+
+    static TabletPadStripV2* from(struct wl_resource*);
+
+    TabletPadStripV2(TabletPadGroupV2 const& parent);
+    virtual ~TabletPadStripV2() = default;
+
+    void send_source_event(uint32_t source) const;
+    void send_position_event(uint32_t position) const;
+    void send_stop_event() const;
+    void send_frame_event(uint32_t time) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Source
+    {
+        static uint32_t const finger = 1;
+    };
+
+    struct Opcode
+    {
+        static uint32_t const source = 0;
+        static uint32_t const position = 1;
+        static uint32_t const stop = 2;
+        static uint32_t const frame = 3;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void set_feedback(std::string const& description, uint32_t serial) = 0;
+    virtual void destroy() = 0;
+};
+
+class TabletPadGroupV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_pad_group_v2";
+
+    static TabletPadGroupV2* from(struct wl_resource*);
+
+    TabletPadGroupV2(TabletPadV2 const& parent);
+    virtual ~TabletPadGroupV2() = default;
+
+    void send_buttons_event(struct wl_array* buttons) const;
+    void send_ring_event(struct wl_resource* ring) const;
+    void send_strip_event(struct wl_resource* strip) const;
+    void send_modes_event(uint32_t modes) const;
+    void send_done_event() const;
+    void send_mode_switch_event(uint32_t time, uint32_t serial, uint32_t mode) const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct Opcode
+    {
+        static uint32_t const buttons = 0;
+        static uint32_t const ring = 1;
+        static uint32_t const strip = 2;
+        static uint32_t const modes = 3;
+        static uint32_t const done = 4;
+        static uint32_t const mode_switch = 5;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void destroy() = 0;
+};
+
+class TabletPadV2 : public Resource
+{
+public:
+    static char const constexpr* interface_name = "zwp_tablet_pad_v2";
+
+    static TabletPadV2* from(struct wl_resource*);
+
+    TabletPadV2(TabletSeatV2 const& parent);
+    virtual ~TabletPadV2() = default;
+
+    void send_group_event(struct wl_resource* pad_group) const;
+    void send_path_event(std::string const& path) const;
+    void send_buttons_event(uint32_t buttons) const;
+    void send_done_event() const;
+    void send_button_event(uint32_t time, uint32_t button, uint32_t state) const;
+    void send_enter_event(uint32_t serial, struct wl_resource* tablet, struct wl_resource* surface) const;
+    void send_leave_event(uint32_t serial, struct wl_resource* surface) const;
+    void send_removed_event() const;
+
+    void destroy_wayland_object() const;
+
+    struct wl_client* const client;
+    struct wl_resource* const resource;
+
+    struct ButtonState
+    {
+        static uint32_t const released = 0;
+        static uint32_t const pressed = 1;
+    };
+
+    struct Opcode
+    {
+        static uint32_t const group = 0;
+        static uint32_t const path = 1;
+        static uint32_t const buttons = 2;
+        static uint32_t const done = 3;
+        static uint32_t const button = 4;
+        static uint32_t const enter = 5;
+        static uint32_t const leave = 6;
+        static uint32_t const removed = 7;
+    };
+
+    struct Thunks;
+
+    static bool is_instance(wl_resource* resource);
+
+private:
+    virtual void set_feedback(uint32_t button, std::string const& description, uint32_t serial) = 0;
+    virtual void destroy() = 0;
+};
+
+}
+}
+
+#endif // MIR_FRONTEND_WAYLAND_TABLET_UNSTABLE_V2_XML_WRAPPER